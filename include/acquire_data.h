@@ -23,6 +23,7 @@
 
 #include <Preferences.h>
 #include <adc_calib.h>
+#include <calibration_store.h>
 #include <datapoint.h>
 #include <process_n2k.h>
 #include <lookUpTable.h>
@@ -69,8 +70,6 @@
 extern OneWire oneWire;
 /** Object for our oneWire Dallas Temperature sensors */
 extern DallasTemperature oneWireSensors;
-/// Mutex for protecting data integrity of \ref VolvoDataForN2k
-extern SemaphoreHandle_t xMutexVolvoN2kData;
 
 /// Buffer for Crystal  LCD Display 4x20 (4 lines a 20 char)
 extern char lcdDisplay[4][20];
@@ -263,7 +262,7 @@ public:
    * This method converts all data measured with several sensors into data
    * which fits to the N2k standard and units.
    *
-   * \param data {type}
+   * \param data   back buffer of \ref N2kDataExchange (writer mutex taken)
    */
   void convertDataToN2k(tVolvoPentaData *data);
 
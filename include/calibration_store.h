@@ -0,0 +1,249 @@
+// Doxygen Documentation
+/*! \file 	calibration_store.h
+ *  \brief  Runtime calibration data stored in the NVS
+ *
+ * This File contains all the necessary methods to keep the calibration
+ * data (ADC factors and sensor maps) in the NVS of the ESP32. So a
+ * changed sender can be calibrated via the terminal without reflashing.
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         ESP32-WROOM
+ * - Hardware:          az-delivery-devkit-v4
+ */
+
+#ifndef CALIBRATION_STORE_H
+#define CALIBRATION_STORE_H
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include <hardwareDef.h>
+#include <lookUpTable.h>
+
+/// Magic number to identify the calibration blob in the NVS ("VPCA")
+#define CALIB_MAGIC 0x41435056UL
+
+/// Version of the layout of \ref tCalibrationData. Increase it whenever
+/// the layout changes, older blobs are ignored then.
+#define CALIB_VERSION 1
+
+/// Number of channels of the MCP3204
+#define CALIB_MCP3204_CHANNELS 4
+
+/// NVS namespace for the calibration data
+#define CALIB_NVS_NAMESPACE "calibration"
+/// NVS key of the calibration blob
+#define CALIB_NVS_KEY "blob"
+
+/*! ************************************************************************
+ * \enum   tCalibrationSource
+ * \brief  Specifies where the active calibration data comes from
+ */
+typedef enum
+{
+  /** compiled defaults from hardwareDef.h and adc_calib.h */
+  calibSource_default,
+
+  /** valid calibration blob from the NVS */
+  calibSource_nvs
+} tCalibrationSource;
+
+/*! ************************************************************************
+ * \struct  tCalibrationData
+ * \brief   Calibration data as it is stored in the NVS
+ *
+ * The structure is stored as one binary blob. It is read in one piece
+ * into RAM and used directly by the LookUpTables and the voltage
+ * measurement, so there is no parsing or allocation during startup.
+ */
+typedef struct tCalibrationData
+{
+  /// magic number \ref CALIB_MAGIC
+  uint32_t magic;
+  /// layout version \ref CALIB_VERSION
+  uint16_t version;
+  /// size of the structure in bytes
+  uint16_t size;
+
+  /// reference voltage for MCP3204
+  double mcp3204Vref;
+  /// voltage scaler for each MCP3204 channel
+  double mcp3204Factor[CALIB_MCP3204_CHANNELS];
+  /// scale factor for AD channel 36
+  double adcCh36Factor;
+  /// offset for AD channel 36
+  double adcCh36Offset;
+
+  /// number of points of the coolant temperature map
+  uint8_t tcoLength;
+  /// number of decimals of the coolant temperature map
+  uint8_t tcoPrecision;
+  /// number of points of the oil pressure map
+  uint8_t poilLength;
+  /// number of decimals of the oil pressure map
+  uint8_t poilPrecision;
+
+  /// axis of the coolant temperature map in volt (fixed point)
+  uint32_t tcoAxis[LUT_MAX_AXIS_LEN];
+  /// coolant temperature map in gradC (fixed point)
+  uint32_t tcoMap[LUT_MAX_AXIS_LEN];
+  /// axis of the oil pressure map in volt (fixed point)
+  uint32_t poilAxis[LUT_MAX_AXIS_LEN];
+  /// oil pressure map in bar (fixed point)
+  uint32_t poilMap[LUT_MAX_AXIS_LEN];
+
+  /// CRC32 over all bytes in front of this member
+  uint32_t crc;
+} tCalibrationData;
+
+/*! ************************************************************************
+ * \class CalibrationStore
+ * \brief Keeps the calibration data for all sensors
+ *
+ * The active calibration is loaded once at boot from the NVS. When there
+ * is no blob, or it has the wrong version or CRC, the compiled defaults
+ * are used. The active data is never changed afterwards, so all pointers
+ * into it stay valid. New values are uploaded into a staging copy via the
+ * terminal command "cal" and become active after the next reboot.
+ */
+class CalibrationStore
+{
+public:
+  /*! ************************************************************************
+   * \brief Construct a new CalibrationStore object with compiled defaults
+   */
+  CalibrationStore();
+
+  /*! ************************************************************************
+   * \brief Load the calibration data from the NVS
+   *
+   * This method reads the calibration blob from the NVS and checks
+   * magic, version, size, CRC and the maps. If one check fails the
+   * compiled defaults are kept.
+   *
+   * \note The NVS has to be initialized before.
+   *
+   * \return true   calibration data from the NVS is active
+   * \return false  compiled defaults are active
+   */
+  bool load();
+
+  /*! ************************************************************************
+   * \brief Get the active calibration data
+   *
+   * \return reference to the active calibration data (read only)
+   */
+  const tCalibrationData &get() const { return activeData; }
+
+  /*! ************************************************************************
+   * \brief Get the source of the active calibration data
+   *
+   * \return source of the active calibration \ref tCalibrationSource
+   */
+  tCalibrationSource getSource() const { return activeSource; }
+
+  /*! ************************************************************************
+   * \brief Apply the active maps to the LookUpTables
+   *
+   * \param mapTCO    LookUpTable for the coolant temperature
+   * \param mapPOIL   LookUpTable for the oil pressure
+   */
+  void applyMaps(LookUpTable1D &mapTCO, LookUpTable1D &mapPOIL) const;
+
+  /*! ************************************************************************
+   * \brief Process the terminal command "cal"
+   *
+   * Syntax (arguments after "cal"):
+   * - show                                       show active and staged data
+   * - adc <vref> <f1> <f2> <f3> <f4> <f36> <o36> set ADC factors
+   * - tco <prec> <x1,x2,..> <y1,y2,..>           set coolant temperature map
+   * - poil <prec> <x1,x2,..> <y1,y2,..>          set oil pressure map
+   * - save                                       store staged data to NVS
+   * - default                                    delete blob from NVS
+   *
+   * \param args    arguments of the command (modified while parsing)
+   */
+  void processCommand(char *args);
+
+private:
+  /// active calibration data, never modified after \ref load
+  tCalibrationData activeData;
+  /// staged calibration data edited by the terminal command
+  tCalibrationData stagedData;
+  /// source of the active calibration
+  tCalibrationSource activeSource = calibSource_default;
+
+  /// Object of the NVMe storage class of the ESP32
+  Preferences nvsStorage;
+
+  /*! ************************************************************************
+   * \brief Fill calibration data with the compiled defaults
+   * \param cal   calibration data to fill
+   */
+  static void setDefaults(tCalibrationData &cal);
+
+  /*! ************************************************************************
+   * \brief Calculate the CRC32 of the calibration data
+   * \param cal   calibration data
+   * \return CRC32 over all bytes in front of the member crc
+   */
+  static uint32_t calcCrc(const tCalibrationData &cal);
+
+  /*! ************************************************************************
+   * \brief Check header, CRC and maps of calibration data
+   * \param cal   calibration data
+   * \return true if the data can be used
+   */
+  static bool isValid(const tCalibrationData &cal);
+
+  /*! ************************************************************************
+   * \brief Check a map for length and strictly rising axis
+   * \param axis    axis of the map
+   * \param length  number of points
+   * \param prec    number of decimals
+   * \return true if the map can be used
+   */
+  static bool isMapValid(const uint32_t *axis, uint8_t length, uint8_t prec);
+
+  /*! ************************************************************************
+   * \brief Parse an unsigned decimal number from the terminal
+   *
+   * \param text    number, all characters have to be digits
+   * \param max     largest allowed value
+   * \param value   parsed number
+   * \return true if the number is complete and in range
+   */
+  static bool parseUInt32(const char *text, uint32_t max, uint32_t &value);
+
+  /*! ************************************************************************
+   * \brief Parse a floating point number from the terminal
+   *
+   * \param text    number, all characters have to be part of it
+   * \param value   parsed number
+   * \return true if the number is complete and finite
+   */
+  static bool parseDouble(const char *text, double &value);
+
+  /*! ************************************************************************
+   * \brief Parse a map from the terminal into calibration data
+   *
+   * \param args    arguments "<prec> <x1,x2,..> <y1,y2,..>"
+   * \param axis    axis to fill
+   * \param map     map to fill
+   * \param length  number of points found
+   * \param prec    number of decimals found
+   * \return true if the map has been parsed and is valid
+   */
+  static bool parseMap(char *args, uint32_t *axis, uint32_t *map,
+                       uint8_t &length, uint8_t &prec);
+
+  /*! ************************************************************************
+   * \brief Print calibration data to the terminal
+   * \param title   headline
+   * \param cal     calibration data
+   */
+  static void printData(const char *title, const tCalibrationData &cal);
+};
+
+#endif // CALIBRATION_STORE_H
@@ -17,6 +17,7 @@
 #define _datapoint_h_
 
 #include <Arduino.h>
+#include <fixed_format.h>
 
 #define MAX_HISTORY_BUFFER_SIZE 10
 
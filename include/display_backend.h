@@ -0,0 +1,162 @@
+// Doxygen Documentation
+/*! \file 	display_backend.h
+ *  \brief  Interface of the panels which show the character grid
+ *
+ * This File contains the interface between DisplayData and the panel
+ * which shows its character grid. Panels with pixels also draw bitmaps
+ * and rectangles. The HD44780 LCD behind a PCF8574 and the 128x64 OLED
+ * are the implementations.
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         ESP32-WROOM
+ * - Hardware:          az-delivery-devkit-v4
+ */
+
+#ifndef DISPLAY_BACKEND_H
+#define DISPLAY_BACKEND_H
+
+#include <Arduino.h>
+#include <Wire.h>
+
+/*! ************************************************************************
+ * \class DisplayBackend
+ * \brief Panel which shows a grid of characters with 8 user glyphs
+ *
+ * The interface follows the HD44780: characters are written at a cursor
+ * position, the cursor moves on with each character (end of row 1
+ * continues in row 3, end of row 3 in row 2, end of row 2 in row 4), the
+ * characters 0..7 and 8..15 are the user glyphs and a change of a glyph
+ * changes all characters which show it.
+ *
+ * A panel with pixels (\ref getPixelWidth not 0) also draws bitmaps and
+ * rectangles anywhere on the panel, e.g. graphs or bigger fonts. On the
+ * OLED the character grid is drawn with \ref drawBitmap as well. A
+ * character panel ignores the pixel calls.
+ *
+ * A panel may send the changes at once (LCD) or only with
+ * \ref endUpdate (OLED with a frame buffer). DisplayData calls
+ * \ref endUpdate at the end of each update of the panel.
+ */
+class DisplayBackend
+{
+public:
+  virtual ~DisplayBackend() {}
+
+  /*! ************************************************************************
+   * \brief Initialise the panel and clear it
+   *
+   * \param cols    number of columns
+   * \param rows    number of rows
+   * \param wire    I2C bus (already started)
+   */
+  virtual void begin(uint8_t cols, uint8_t rows, TwoWire &wire) = 0;
+
+  /*! ************************************************************************
+   * \brief Set the backlight or the contrast of the panel
+   * \param brightness   0 = off, 255 = full
+   */
+  virtual void setBacklight(uint8_t brightness) = 0;
+
+  /*! ************************************************************************
+   * \brief Write characters at the cursor position
+   *
+   * \param buf   characters
+   * \param len   number of characters
+   */
+  virtual void write(const uint8_t *buf, size_t len) = 0;
+
+  /*! ************************************************************************
+   * \brief Move the cursor and write characters
+   *
+   * \param col   column
+   * \param row   row
+   * \param buf   characters
+   * \param len   number of characters
+   */
+  virtual void writeAt(uint8_t col, uint8_t row, const uint8_t *buf, size_t len) = 0;
+
+  /*! ************************************************************************
+   * \brief Define a user glyph
+   *
+   * The cursor position is lost, it has to be set afterwards.
+   *
+   * \param location   number of the glyph (0..7)
+   * \param charmap    8 rows of the glyph (5 bits each, bit 4 = left)
+   */
+  virtual void createChar(uint8_t location, const uint8_t charmap[8]) = 0;
+
+  /*! ************************************************************************
+   * \brief Get the width of the panel in pixels
+   * \return width in pixels, 0 = the panel shows characters only
+   */
+  virtual uint8_t getPixelWidth() const { return 0; }
+
+  /*! ************************************************************************
+   * \brief Get the height of the panel in pixels
+   * \return height in pixels, 0 = the panel shows characters only
+   */
+  virtual uint8_t getPixelHeight() const { return 0; }
+
+  /*! ************************************************************************
+   * \brief Draw a bitmap
+   *
+   * The bitmap has one byte per column for each band of 8 pixel rows
+   * (LSB = top), the bands follow each other. Pixels outside of the panel
+   * are not drawn.
+   *
+   * \param x        left pixel column
+   * \param y        top pixel row (any row, not only a multiple of 8)
+   * \param width    width in pixels
+   * \param height   height in pixels
+   * \param bitmap   (height + 7) / 8 bands of width bytes
+   */
+  virtual void drawBitmap(uint8_t x, uint8_t y, uint8_t width, uint8_t height, const uint8_t *bitmap) {}
+
+  /*! ************************************************************************
+   * \brief Set or clear the pixels of a rectangle
+   *
+   * \param x        left pixel column
+   * \param y        top pixel row
+   * \param width    width in pixels
+   * \param height   height in pixels
+   * \param on       true = pixels on, false = pixels off
+   */
+  virtual void fillRect(uint8_t x, uint8_t y, uint8_t width, uint8_t height, bool on) {}
+
+  /*! ************************************************************************
+   * \brief Send the changes which are not sent yet
+   */
+  virtual void endUpdate() {}
+
+  /*! ************************************************************************
+   * \brief Get the max I2C clock of the panel
+   * \return I2C clock in Hz
+   */
+  virtual uint32_t getI2cClock() const = 0;
+
+  /*! ************************************************************************
+   * \brief Get the number of I2C bytes sent (incl. address bytes)
+   * \return number of I2C bytes
+   */
+  virtual uint32_t getI2cByteCount() const = 0;
+
+  /*! ************************************************************************
+   * \brief Get the number of I2C transactions
+   * \return number of I2C transactions
+   */
+  virtual uint32_t getI2cTransactionCount() const = 0;
+
+  /*! ************************************************************************
+   * \brief Get the number of failed I2C transactions
+   *
+   * After a new error DisplayData does not trust its shadow of the panel
+   * and writes the whole panel again.
+   *
+   * \return number of I2C transactions which have not been acknowledged
+   */
+  virtual uint32_t getI2cErrorCount() const = 0;
+};
+
+#endif // DISPLAY_BACKEND_H
@@ -15,14 +15,28 @@
 #define DISPLAY_DATA_H
 
 #include <Arduino.h>
+#include <atomic>
 #include <hardwareDef.h>
-#include <LiquidCrystal_PCF8574.h>
+#include <display_backend.h>
+#ifdef DISPLAY_OLED
+#include <oled_ssd1306.h>
+// a plain -D DISPLAY_OLED is 1, which is no controller
+#if DISPLAY_OLED != OLED_SSD1306 && DISPLAY_OLED != OLED_SH1106
+#error "DISPLAY_OLED has to be OLED_SSD1306 or OLED_SH1106"
+#endif
+#else
+#include <lcd_pcf8574.h>
+#endif // DISPLAY_OLED
+#include <fixed_format.h>
+#include <trend_history.h>
 #include <acquire_data.h>
 #include <Wire.h>
 #include <versionInfo.h>
+#include <n2k_bus_monitor.h>
+#include <n2k_alert.h>
 
 /// Define max Number of Main Pages
-#define MAX_MAIN_PAGES 6
+#define MAX_MAIN_PAGES 7
 
 /// Define the Number for the Welcome Page
 #define WELCOME_PAGE 0
@@ -38,15 +52,246 @@
 #define PAGE_VOLTAGE 5
 /// Define the Number for the Alarm Page
 #define PAGE_ALARM 6
+/// Define the Number for the Big Digit Page
+#define PAGE_BIG_DIGITS 7
 
 /// Define the Number for the 1Wire List Page
 #define PAGE_1WIRE_LIST 10
+/// Define the Number for the N2K Bus Diagnostic Page
+#define PAGE_N2K_BUS 11
+/// Define the Number for the Trend Page
+#define PAGE_TREND 12
 
 
 
+/// Period of the LCD task in milliseconds, if no page change wakes it up earlier
+#define LCD_REFRESH_PERIOD_MS 100
+
 /// Define max number LCD Update cycles until fullscreen renew
 #define LCD_MAX_CYCLE_COUNT_TILL_FULL_UPDATE 20
 
+/// Number of LCD Update cycles until the whole LCD is written again (EMI)
+#define LCD_SHADOW_RESYNC_CYCLES 600
+/// Number of rows of the LCD Panel
+#define LCD_ROWS 4
+/// Number of characters per row of the LCD Panel
+#define LCD_COLS 20
+/// Unchanged characters which are rewritten instead of a cursor move (same I2C bytes)
+#define LCD_RUN_MAX_GAP 1
+
+#ifdef DISPLAY_OLED
+/// Max I2C bytes of a run of len characters of one row (OLED tiles)
+#define DISPLAY_RUN_BYTES(len) OLED_RUN_BYTES(len)
+#else
+/// Max I2C bytes of a run of len characters of one row (LCD cursor move and characters)
+#define DISPLAY_RUN_BYTES(len) LCD_RUN_BYTES(len)
+#endif // DISPLAY_OLED
+
+/// Number of user glyphs in the CGRAM of the LCD Panel
+#define LCD_GLYPH_COUNT 8
+/// Number of pixel rows of a glyph
+#define LCD_GLYPH_ROWS 8
+/// Character code of glyph 0 (codes 8..15 show the glyphs 0..7, no zero in the buffer)
+#define LCD_GLYPH_CODE 8
+
+/// Number of values with a trend
+#define TREND_CHANNEL_COUNT 3
+/// Rows of the bar graph of the trend page
+#define TREND_GRAPH_ROWS 3
+
+/// Alarms shown at once on the alarm page
+#define LCD_ALARM_ROWS 3
+
+/// Rows of a big digit
+#define LCD_BIG_DIGIT_ROWS 2
+/// Columns of a big digit
+#define LCD_BIG_DIGIT_COLS 3
+/// Max number of big numbers on a page
+#define LCD_BIG_NUMBER_MAX 2
+/// Width of a segment of a big digit on a panel with pixels
+#define LCD_SEGMENT_WIDTH 3
+
+/*! ************************************************************************
+ * \struct  tLcdStatistic
+ * \brief   I2C traffic of the LCD Panel updates
+ */
+typedef struct tLcdStatistic
+{
+  /// number of LCD Panel updates
+  uint32_t refreshCount = 0;
+  /// updates without any change
+  uint32_t idleCount = 0;
+  /// I2C bytes of the last update
+  uint32_t bytesLast = 0;
+  /// max I2C bytes of one update
+  uint32_t bytesMax = 0;
+  /// I2C bytes of all updates
+  uint32_t bytesTotal = 0;
+  /// characters written to the LCD
+  uint32_t charCount = 0;
+  /// cursor moves
+  uint32_t cursorCount = 0;
+  /// I2C transactions of all updates
+  uint32_t transactionCount = 0;
+  /// time the last update held \ref xMutexLCDUpdate in microseconds
+  uint32_t busyUsLast = 0;
+  /// max time an update held \ref xMutexLCDUpdate in microseconds
+  uint32_t busyUsMax = 0;
+  /// max time a page request blocked the calling task in microseconds
+  uint32_t pageRequestUsMax = 0;
+  /// time to format the fields of the last update in microseconds
+  uint32_t formatUsLast = 0;
+  /// max time to format the fields of one update in microseconds
+  uint32_t formatUsMax = 0;
+  /// glyphs written to the CGRAM
+  uint32_t glyphUploads = 0;
+  /// texts which have been cut at the end of a row
+  uint32_t rowOverflows = 0;
+  /// values which did not fit into their field
+  uint32_t fieldOverflows = 0;
+  /// updates which wrote the whole LCD again after an I2C error
+  uint32_t errorResyncs = 0;
+} tLcdStatistic;
+
+/// Number of pages in the page table \ref lcdPages (checked against the table)
+#define LCD_PAGE_COUNT 11
+/// Max width of a field of a page in characters
+#define LCD_FIELD_MAX_WIDTH 10
+
+/*! ************************************************************************
+ * \struct  tLcdField
+ * \brief   One measured value on an LCD page
+ *
+ * The value is multiplied by the factor and written right aligned with
+ * the given width and decimals, followed by the unit. A value which does
+ * not fit into the width is shown as '*'. Slow fields are renewed only
+ * every \ref LCD_MAX_CYCLE_COUNT_TILL_FULL_UPDATE cycles.
+ */
+typedef struct tLcdField
+{
+  /// measured value in \ref AcquireData
+  DataPoint AcquireData::*source;
+  /// factor for the unit of the page
+  float factor;
+  /// row of the field
+  uint8_t row;
+  /// first column of the field
+  uint8_t col;
+  /// width of the number in characters
+  uint8_t width;
+  /// number of decimals
+  uint8_t decimals;
+  /// unit written behind the number
+  const char *unit;
+  /// the field is renewed only every few cycles
+  bool slow;
+} tLcdField;
+
+/*! ************************************************************************
+ * \enum   tLcdPageRender
+ * \brief  Pages with content which is not a list of fields
+ */
+typedef enum
+{
+  /// static rows and fields only
+  lcdRender_None,
+  /// list of the 1-Wire sensors
+  lcdRender_OneWire,
+  /// diagnostic of the NMEA2000 bus
+  lcdRender_N2kBus,
+  /// list of the active alarms
+  lcdRender_Alarm,
+  /// bar graph of a trend
+  lcdRender_Trend,
+  /// engine speed and coolant temperature with big digits
+  lcdRender_BigDigits
+} tLcdPageRender;
+
+/*! ************************************************************************
+ * \struct  tLcdPage
+ * \brief   Description of one LCD page
+ *
+ * The static rows and the glyphs are written only when the page is
+ * shown, with each refresh only the fields are formatted. A row which
+ * is NULL is left to the fields and the render method.
+ */
+typedef struct tLcdPage
+{
+  /// number of the page
+  uint8_t page;
+  /// static text of the rows, NULL = no static text
+  const char *rows[LCD_ROWS];
+  /// fields with the measured values
+  const tLcdField *fields;
+  /// number of fields
+  uint8_t fieldCount;
+  /// render method for the dynamic rows
+  tLcdPageRender render;
+  /// glyphs of the page (\ref LCD_GLYPH_COUNT), NULL = no glyphs
+  const uint8_t (*glyphs)[LCD_GLYPH_ROWS];
+  /// max I2C bytes of a refresh of the data, checked by the native tests
+  uint16_t refreshBytesBudget;
+} tLcdPage;
+
+/// Page table of the LCD Panel, \ref LCD_PAGE_COUNT rows
+extern const tLcdPage lcdPages[];
+/// Page shown for an unknown page number
+extern const tLcdPage lcdErrorPage;
+
+/*! ************************************************************************
+ * \struct  tTrendChannel
+ * \brief   A measured value with a trend on the trend page
+ */
+typedef struct tTrendChannel
+{
+  /// title of the trend page (max 10 characters)
+  const char *title;
+  /// measured value in \ref AcquireData
+  DataPoint AcquireData::*source;
+  /// min range of the bar graph, smaller changes are not magnified
+  float minSpan;
+} tTrendChannel;
+
+/// Values with a trend on the trend page
+extern const tTrendChannel trendChannels[TREND_CHANNEL_COUNT];
+
+/// Characters of the big digits 0..9
+extern const char lcdBigDigitFont[10][LCD_BIG_DIGIT_ROWS][LCD_BIG_DIGIT_COLS];
+/// Segments of the big digits 0..9 on a panel with pixels (bit 0 = a .. bit 6 = g)
+extern const uint8_t lcdSegmentFont[10];
+
+/*! ************************************************************************
+ * \struct  tLcdBigNumber
+ * \brief   A number with big digits drawn with pixels
+ */
+typedef struct tLcdBigNumber
+{
+  /// first row of the digits
+  uint8_t row;
+  /// first column of the digits
+  uint8_t col;
+  /// number of digits
+  uint8_t digits;
+  /// number, already limited to the digits
+  int32_t value;
+} tLcdBigNumber;
+
+/*! ************************************************************************
+ * \struct  tLcdCheckResult
+ * \brief   Result of the self check of one page
+ */
+typedef struct tLcdCheckResult
+{
+  /// number of the page
+  uint8_t page = 0;
+  /// texts cut at the end of a row
+  uint8_t rowOverflows = 0;
+  /// values which did not fit into their field
+  uint8_t fieldOverflows = 0;
+  /// rendered characters
+  char grid[LCD_ROWS][LCD_COLS];
+} tLcdCheckResult;
+
 /// Object for I2C Bus
 extern TwoWire WireI2C;
 
@@ -61,8 +306,10 @@ public:
   /*! ************************************************************************
    * \brief Constructor for DisplayData.
    * \param data Reference to an AcquireData object.
+   * \param busMonitor Reference to the monitor of the NMEA2000 bus.
+   * \param lcd Reference to the panel (HD44780 LCD or OLED).
    */
-  DisplayData(AcquireData &data);
+  DisplayData(AcquireData &data, N2kBusMonitor &busMonitor, DisplayBackend &lcd);
 
   /*! ************************************************************************
    * \brief Setup the LCD Panel
@@ -73,22 +320,29 @@ public:
   void setupLCDPanel();
 
   /*! ************************************************************************
-   * \brief Update the Content of all LCD Pages
-   *
-   * This method updates all LCD pages with actual data. For saving time
-   * and reducing glitches at the display, it has an option to update the
-   * "changing" data characters and not the "static" text.
+   * \brief Set the task which renders the LCD Panel
    *
-   * \param blnUpdateDataOnly   update data fields only (default = false)
+   * Page requests wake up this task. During the setup the page has to be
+   * rendered with \ref render.
+   * \param task handle of the LCD task
+   */
+  void setRenderTask(TaskHandle_t task) { renderTask = task; }
+
+  /*! ************************************************************************
+   * \brief Render the current page and flush it to the LCD Panel (LCD task only)
    *
+   * The page is rendered into the back buffer lcdDisplay, the changed
+   * characters are written to the LCD Panel. A page change renders the
+   * static text as well. Also the backlight is updated.
    */
-  void updateLcdContent(boolean blnUpdateDataOnly = false);
+  void render();
 
   /*! ************************************************************************
    * \brief Set the current page for the LCD Panel
    *
    * This method sets number of the current page of the LCD Panel and
-   * validates the given number.
+   * wakes up the LCD task. It never waits for the I2C bus, so it can be
+   * called from any task.
    * \param page number of the current page
    */
   void setLcdCurrentPage(uint8_t page);
@@ -111,33 +365,114 @@ public:
    */
   void increaseLcdCurrentPage();
 
+  /*! ************************************************************************
+   * \brief Show the trend of the next value on the trend page
+   */
+  void nextTrendChannel();
+
+  /*! ************************************************************************
+   * \brief Scroll the alarm page by one alarm, from the last back to the first
+   */
+  void scrollAlarmList();
+
   /*! ************************************************************************
    * \brief Update the backlight of the LCD Panel
-   * This method sets the backlight of the LCD Panel
+   * This method sets the backlight of the LCD Panel (LCD task only)
    */
   void updateLcdBacklight();
 
   /*! ************************************************************************
    * \brief Reset the backlight Counter of the LCD Panel
    *
-   * This method sets the backlight counter of the LCD Panel.
+   * This method sets the backlight counter of the LCD Panel and wakes up
+   * the LCD task, which switches the backlight on.
    */
-  void resetLcdBacklightCounter() { lcdBacklightDimCounter = 0; }
+  void resetLcdBacklightCounter()
+  {
+    lcdBacklightDimCounter = 0;
+    requestRender();
+  }
+
+  /*! ************************************************************************
+   * \brief Get the I2C statistic of the LCD Panel updates
+   * \return copy of the statistic
+   */
+  tLcdStatistic getLcdStatistic() { return lcdStat; }
+
+  /*! ************************************************************************
+   * \brief Print the I2C statistic of the LCD Panel updates to the terminal
+   */
+  void printLcdStatistic();
+
+  /*! ************************************************************************
+   * \brief Request the self check of all pages
+   *
+   * With its next cycle the LCD task renders all pages of \ref lcdPages
+   * into the back buffer with the current values, the LCD Panel is not
+   * written. Then the current page is rendered again.
+   */
+  void requestSelfCheck();
+
+  /*! ************************************************************************
+   * \brief Check if the requested self check is finished
+   * \return true if the result can be printed
+   */
+  bool isSelfCheckDone() { return lcdCheckDone; }
+
+  /*! ************************************************************************
+   * \brief Print the result of the self check to the terminal
+   *
+   * For each page the rendered characters are printed. A page fails if a
+   * text has been cut at the end of a row. The I2C budgets of the pages
+   * are checked by the native tests (test/test_display), which refresh
+   * the data of every page.
+   *
+   * \return true if all pages passed
+   */
+  bool printSelfCheck();
 
 private:
   /// Reference to an AcquireData object with all the sensor data.
   AcquireData &data;
 
-  /// LCD 4x20 object on I2C Bus
-  LiquidCrystal_PCF8574 lcd;
+  /// Reference to the monitor of the NMEA2000 bus
+  N2kBusMonitor &busMonitor;
+
+  /// Reference to the panel on I2C Bus which shows the 4x20 characters
+  DisplayBackend &lcd;
   /// ID for the active page on the LCD-Panel
-  uint8_t lcdCurrentPage = 0;
+  volatile uint8_t lcdCurrentPage = 0;
+
+  /// the page has changed, the static text has to be rendered (set by
+  /// the requesting tasks, taken by the LCD task with one exchange)
+  std::atomic<bool> lcdPageChanged{true};
+
+  /// task which renders the LCD Panel, NULL = render at once
+  TaskHandle_t renderTask = NULL;
 
   /// Buffer for Crystal  LCD Display 4x20 (4 lines a 20 char)
-  char lcdDisplay[4][20];
+  char lcdDisplay[LCD_ROWS][LCD_COLS];
+
+  /// Characters currently shown by the LCD Panel
+  char lcdShadow[LCD_ROWS][LCD_COLS];
+
+  /// The shadow buffer matches the LCD Panel
+  bool lcdShadowValid = false;
 
-  /// LCD Panel switched to a complete new screen
-  bool lcdScreenRenew = true;
+  /// DDRAM address of the cursor of the LCD Panel, 0xFF = unknown
+  uint8_t lcdCursorAddress = 0xFF;
+
+  /// Last backlight value written to the LCD Panel, -1 = unknown
+  int16_t lcdBacklightValue = -1;
+
+  /// LCD Panel updates until the whole LCD is written again
+  uint16_t lcdResyncCounter = 0;
+
+  /// I2C errors of the LCD Panel already handled by a resync
+  uint32_t lcdI2cErrorCount = 0;
+
+  /// I2C traffic of the LCD Panel updates
+  tLcdStatistic lcdStat;
 
   /// LCD Panel Update counter is incremented every cycle of \ref taskUpdateLCD
   uint16_t lcdUpdateCounter = 0;
@@ -145,6 +480,60 @@ private:
   /// LCD Panel dimmer counter is used to decrease backlight during no activity
   uint32_t lcdBacklightDimCounter = 0;
 
+  /// Trends of the values of \ref trendChannels
+  TrendHistory trendHistory[TREND_CHANNEL_COUNT];
+
+  /// Value shown on the trend page
+  volatile uint8_t lcdTrendChannel = 0;
+
+  /// Version of the trend shown on the trend page
+  uint32_t lcdTrendVersion = 0;
+
+  /// Content drawn with pixels after the characters, lcdRender_None = characters only
+  tLcdPageRender lcdPixelRender = lcdRender_None;
+
+  /// Height of the bars of the trend page in pixels (one per column)
+  uint8_t lcdTrendBar[LCD_COLS];
+
+  /// Numbers of the big digit page drawn with pixels
+  tLcdBigNumber lcdBigNumber[LCD_BIG_NUMBER_MAX];
+
+  /// Number of entries in \ref lcdBigNumber
+  uint8_t lcdBigNumberCount = 0;
+
+  /// Glyphs of the CGRAM
+  uint8_t lcdGlyph[LCD_GLYPH_COUNT][LCD_GLYPH_ROWS];
+
+  /// Glyphs which have to be written to the CGRAM (one bit per glyph)
+  uint8_t lcdGlyphDirty = 0;
+
+  /// Glyphs which have been defined (one bit per glyph)
+  uint8_t lcdGlyphUsed = 0;
+
+  /// The self check has been requested
+  volatile bool lcdCheckRequested = false;
+
+  /// The self check is finished
+  volatile bool lcdCheckDone = false;
+
+  /// Result of the self check per page
+  tLcdCheckResult lcdCheck[LCD_PAGE_COUNT];
+
+  /// Active alarms sorted by severity and onset, index of \ref n2kAlerts
+  uint8_t lcdAlarmList[N2K_ALERT_COUNT];
+
+  /// Number of active alarms in the list
+  uint8_t lcdAlarmCount = 0;
+
+  /// Change counter of the error flags when the list was built
+  uint32_t lcdAlarmChangeCount = 0;
+
+  /// The alarm list has been built
+  bool lcdAlarmListValid = false;
+
+  /// First alarm shown on the alarm page
+  volatile uint8_t lcdAlarmScroll = 0;
+
   /*! ************************************************************************
    * \brief Set the backlight of the LCD Panel to full brightness
    *
@@ -163,14 +552,197 @@ private:
    */
   void setBacklightOff();
   
+  /*! ************************************************************************
+   * \brief Update the Content of all LCD Pages
+   *
+   * This method renders the current page of \ref lcdPages into the back
+   * buffer lcdDisplay and flushes it to the LCD Panel. For saving time it
+   * has an option to update the fields only and not the static rows.
+   *
+   * \param blnUpdateDataOnly   update data fields only (default = false)
+   *
+   */
+  void updateLcdContent(boolean blnUpdateDataOnly = false);
+
+  /*! ************************************************************************
+   * \brief Render a page into the back buffer
+   *
+   * \param page                description of the page
+   * \param blnUpdateDataOnly   update data fields only
+   */
+  void renderLcdPage(const tLcdPage &page, boolean blnUpdateDataOnly);
+
+  /*! ************************************************************************
+   * \brief Render all pages into the back buffer and check them (LCD task only)
+   */
+  void runSelfCheck();
+
+  /*! ************************************************************************
+   * \brief Write a text into one row of the back buffer, filled with blanks
+   *
+   * \param row    row of the LCD Panel
+   * \param text   text, longer texts are cut
+   */
+  void setLcdRow(uint8_t row, const char *text);
+
+  /*! ************************************************************************
+   * \brief Format a text into one row of the back buffer, filled with blanks
+   *
+   * \param row      row of the LCD Panel
+   * \param format   printf format, longer texts are cut and counted
+   */
+  void printLcdRow(uint8_t row, const char *format, ...);
+
+  /*! ************************************************************************
+   * \brief Format one field into the back buffer
+   * \param field   description of the field
+   */
+  void renderField(const tLcdField &field);
+
+  /*! ************************************************************************
+   * \brief Render the list of the 1-Wire sensors
+   */
+  void renderOneWirePage();
+
+  /*! ************************************************************************
+   * \brief Render the diagnostic of the NMEA2000 bus
+   */
+  void renderN2kBusPage();
+
+  /*! ************************************************************************
+   * \brief Render the list of the active alarms
+   *
+   * Each row shows the type (A = alarm, W = warning), a '!' while the
+   * alarm is not acknowledged, the text and the time since the onset.
+   */
+  void renderAlarmPage();
+
+  /*! ************************************************************************
+   * \brief Build the list of the active alarms if an error flag has changed
+   *
+   * The alarms are sorted by their type (alarms before warnings), then the
+   * newest first.
+   */
+  void updateAlarmList();
+
+  /*! ************************************************************************
+   * \brief Render the bar graph of the trend
+   *
+   * The graph is rendered only when a bucket has been closed or the page
+   * is shown. On a panel with pixels the bars are drawn by
+   * \ref drawTrendBars with one level per pixel row, the cells stay blank.
+   *
+   * \param blnUpdateDataOnly   the page has been shown before
+   */
+  void renderTrendPage(boolean blnUpdateDataOnly);
+
+  /*! ************************************************************************
+   * \brief Render the engine speed and the coolant temperature with big digits
+   */
+  void renderBigDigitPage();
+
+  /*! ************************************************************************
+   * \brief Write a number with big digits into the back buffer
+   *
+   * The number is right aligned, leading zeros are blank. A number which
+   * does not fit is limited to the max value. On a panel with pixels the
+   * number is kept for \ref drawBigNumbers, the cells stay blank.
+   *
+   * \param row      first row of the digits
+   * \param col      first column of the digits
+   * \param value    number
+   * \param digits   number of digits
+   */
+  void writeBigNumber(uint8_t row, uint8_t col, int32_t value, uint8_t digits);
+
+  /*! ************************************************************************
+   * \brief Check if the panel draws pixels
+   * \return true for the OLED, false for the LCD
+   */
+  bool isPixelPanel() const { return this->lcd.getPixelWidth() > 0; }
+
+  /*! ************************************************************************
+   * \brief Draw the content of the page which is drawn with pixels
+   *
+   * Called after the characters have been written, so a blank cell which
+   * has been written again is drawn over. Each pixel is written once, an
+   * unchanged graph or number sends nothing.
+   */
+  void drawPixelPage();
+
+  /*! ************************************************************************
+   * \brief Draw the bars of the trend page below the title row
+   */
+  void drawTrendBars();
+
+  /*! ************************************************************************
+   * \brief Draw the numbers of the big digit page with segments
+   */
+  void drawBigNumbers();
+
+  /*! ************************************************************************
+   * \brief Draw the segments of one big digit
+   *
+   * \param x          left pixel column of the digit
+   * \param y          top pixel row of the digit
+   * \param segments   segments which are on (bit 0 = a .. bit 6 = g)
+   */
+  void drawBigDigit(uint8_t x, uint8_t y, uint8_t segments);
+
+  /*! ************************************************************************
+   * \brief Add the current values to the trends
+   */
+  void sampleTrends();
+
+  /*! ************************************************************************
+   * \brief Define a glyph of the CGRAM
+   *
+   * The glyph is written to the LCD Panel with the next update, only if
+   * the bitmap has changed. Characters already shown with this glyph
+   * change as well.
+   *
+   * \param slot     number of the glyph (0..7)
+   * \param bitmap   8 rows of the glyph (5 bits each)
+   */
+  void setLcdGlyph(uint8_t slot, const uint8_t bitmap[LCD_GLYPH_ROWS]);
+
+  /*! ************************************************************************
+   * \brief Write the changed glyphs to the CGRAM
+   */
+  void uploadLcdGlyphs();
+
+  /*! ************************************************************************
+   * \brief Wake up the LCD task
+   */
+  void requestRender();
+
+  /*! ************************************************************************
+   * \brief Set the backlight of the LCD Panel if it has changed
+   * \param value backlight value
+   */
+  void writeBacklight(uint8_t value);
+
   /*! ************************************************************************
    * \brief Update the LCD Panel
    *
-   * This method copys the buffer lcdDisplay to the LCD Panel. It is used
-   * This method copies the buffer lcdDisplay to the LCD Panel. It is used
+   * This method copies the changed characters of the buffer lcdDisplay to
+   * the LCD Panel. The buffer is compared with the shadow buffer of the
+   * LCD, only runs of changed characters are written. The cursor is only
+   * moved if a run does not start at the current cursor position.
    *
    */
   void updateLCDPanel();
+
+  /*! ************************************************************************
+   * \brief Write a run of characters to the LCD Panel
+   *
+   * The cursor move and the characters are sent with one I2C transaction.
+   *
+   * \param row    row of the run
+   * \param col    first column of the run
+   * \param len    number of characters
+   */
+  void writeLcdRun(uint8_t row, uint8_t col, uint8_t len);
 };
 
 #endif  // DISPLAY_DATA_H
\ No newline at end of file
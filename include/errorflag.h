@@ -15,11 +15,23 @@
 #define ERRORFLAG_H
 
 #include <Arduino.h>
+#include <atomic>
+
+/// State bit of ErrorFlag: the flag is set
+#define ERROR_FLAG_SET 0x01
+/// State bit of ErrorFlag: the set flag is acknowledged
+#define ERROR_FLAG_ACKNOWLEDGED 0x02
 
 /*! \class ErrorFlag
  * \brief A class to handle error flags.
  *
  *   This class contains methods to set, reset and check the status of an error flag.
+ *
+ *   The flag is set and reset by the measure task only, but it is
+ *   acknowledged by the button and by the N2K receive task. So the state is
+ *   one atomic value and an acknowledge is a compare and exchange from
+ *   "set" to "set and acknowledged", which fails when the flag has been
+ *   reset in the meantime.
  */
 class ErrorFlag
 {
@@ -31,8 +43,9 @@ public:
 
   /*!
    * \brief Method to set the error flag.
-   * This Method sets the error flag and stores the timestamp
-   * when the flag was set.
+   * This Method sets the error flag. The timestamp is stored and the
+   * acknowledgement is cleared only when the flag changes from reset to
+   * set, so a flag set cyclically keeps its first timestamp.
    */
   void setFlag();
 
@@ -61,18 +74,27 @@ public:
 
   /*!
    * \brief Method to set the flag as served.
+   * Only a set flag can be acknowledged.
    */
   void acknowledgeFlag();
 
+  /*!
+   * \brief Method to get the number of changes of all error flags.
+   * The counter is incremented whenever any flag is set, reset or
+   * acknowledged, so a change can be detected without comparing all flags.
+   * \return Number of changes since the start.
+   */
+  static uint32_t getChangeCount();
+
 private:
-  /// Status of the flag
-  bool flagStatus;
+  /// State of the flag (\ref ERROR_FLAG_SET, \ref ERROR_FLAG_ACKNOWLEDGED)
+  std::atomic<uint8_t> flagState;
 
   /// Timestamp when the flag was set
-  unsigned long flagSetTimeStamp;
+  std::atomic<unsigned long> flagSetTimeStamp;
 
-  /// Info if the flag is acknowledged
-  bool flagIsAcknowledged;
+  /// Number of changes of all flags
+  static std::atomic<uint32_t> changeCount;
 };
 
 #endif // ERRORFLAG_H
\ No newline at end of file
@@ -0,0 +1,79 @@
+// Doxygen Documentation
+/*! \file 	fixed_format.h
+ *  \brief  Formatting of integer and fixed point numbers
+ *
+ * This File contains small formatter functions for numbers with a fixed
+ * width. They need no heap, no String and no floating point formatting
+ * of newlib, so they can be used in tasks with a small stack.
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         ESP32-WROOM
+ * - Hardware:          az-delivery-devkit-v4
+ */
+
+#ifndef FIXED_FORMAT_H
+#define FIXED_FORMAT_H
+
+#include <Arduino.h>
+
+/// Max number of decimals of a fixed point number
+#define FIXED_FORMAT_MAX_DECIMALS 6
+/// Buffer size for any number of \ref formatFixed without width (sign, 10 digits, point, zero)
+#define FIXED_FORMAT_BUFFER_SIZE 16
+
+/*! ************************************************************************
+ * \brief Format a fixed point integer
+ *
+ * The value is the number multiplied by 10^decimals, e.g. 1375 with 2
+ * decimals is "13.75". With a width the number is right aligned and
+ * filled with blanks, a number which does not fit is written as '*'.
+ * The buffer is always terminated.
+ *
+ * \code
+ * char text[6];
+ * formatFixed(text, 5, -123, 1);   // "-12.3"
+ * formatFixed(text, 5, 42, 0);     // "   42"
+ * formatFixed(text, 3, 12345, 0);  // "***"
+ * \endcode
+ *
+ * \param buffer     buffer with at least width + 1 or
+ *                   \ref FIXED_FORMAT_BUFFER_SIZE bytes (width 0)
+ * \param width      number of characters, 0 = as many as needed
+ * \param value      value as fixed point integer
+ * \param decimals   number of decimals (max \ref FIXED_FORMAT_MAX_DECIMALS)
+ * \return number of characters written
+ */
+uint8_t formatFixed(char *buffer, uint8_t width, int32_t value, uint8_t decimals);
+
+/*! ************************************************************************
+ * \brief Format a floating point value with a fixed number of decimals
+ *
+ * The value is rounded to a fixed point integer and written with
+ * \ref formatFixed. A value outside of the 32 bit range is written as '*'.
+ *
+ * \param buffer     buffer, see \ref formatFixed
+ * \param width      number of characters, 0 = as many as needed
+ * \param value      value
+ * \param decimals   number of decimals (max \ref FIXED_FORMAT_MAX_DECIMALS)
+ * \return number of characters written
+ */
+uint8_t formatFixedFloat(char *buffer, uint8_t width, double value, uint8_t decimals);
+
+#ifdef FIXED_FORMAT_BENCHMARK
+/// Number of values formatted by \ref printFixedFormatBenchmark
+#define FIXED_FORMAT_BENCH_LOOPS 1000
+
+/*! ************************************************************************
+ * \brief Compare the formatting time with snprintf
+ *
+ * Formats \ref FIXED_FORMAT_BENCH_LOOPS values with snprintf("%5.1f") and
+ * with \ref formatFixedFloat and prints both times to the terminal. Only
+ * built with -D FIXED_FORMAT_BENCHMARK, it links the float formatting of
+ * newlib.
+ */
+void printFixedFormatBenchmark();
+#endif // FIXED_FORMAT_BENCHMARK
+
+#endif // FIXED_FORMAT_H
@@ -0,0 +1,210 @@
+// Doxygen Documentation
+/*! \file 	lcd_pcf8574.h
+ *  \brief  HD44780 LCD behind a PCF8574 I2C expander
+ *
+ * This File contains all the necessary methods to drive an HD44780
+ * compatible LCD Panel in the 4 bit mode through a PCF8574 I2C port
+ * expander. All expander writes of a run of characters are packed into
+ * one I2C transaction.
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         ESP32-WROOM
+ * - Hardware:          az-delivery-devkit-v4
+ */
+
+#ifndef LCD_PCF8574_H
+#define LCD_PCF8574_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <display_backend.h>
+
+/// I2C clock of the LCD in Hz (PCF8574 datasheet: max 100 kHz)
+#ifndef LCD_I2C_CLOCK
+#define LCD_I2C_CLOCK 100000
+#endif // LCD_I2C_CLOCK
+
+/// Max payload of one I2C transaction (Wire buffer, 4 bytes per LCD byte)
+#define LCD_I2C_BATCH_SIZE 124
+/// Expander bytes for one LCD byte (2 nibbles with enable high and low)
+#define LCD_EXPANDER_BYTES_PER_LCD_BYTE 4
+/// I2C bytes of a cursor move and a run of len characters (one transaction)
+#define LCD_RUN_BYTES(len) (1 + (1 + (len)) * LCD_EXPANDER_BYTES_PER_LCD_BYTE)
+
+/// PCF8574 pin of the register select
+#define LCD_PCF_RS 0x01
+/// PCF8574 pin of the enable strobe
+#define LCD_PCF_EN 0x04
+/// PCF8574 pin of the backlight
+#define LCD_PCF_BACKLIGHT 0x08
+
+/// HD44780 command: clear display
+#define LCD_CMD_CLEAR 0x01
+/// HD44780 command: entry mode, increment without shift
+#define LCD_CMD_ENTRY_MODE 0x06
+/// HD44780 command: display on, cursor and blink off
+#define LCD_CMD_DISPLAY_ON 0x0C
+/// HD44780 command: function set, 4 bit, 2 lines, 5x8 dots
+#define LCD_CMD_FUNCTION_SET 0x28
+/// HD44780 command: set CGRAM address
+#define LCD_CMD_SET_CGRAM 0x40
+/// HD44780 command: set DDRAM address
+#define LCD_CMD_SET_DDRAM 0x80
+
+/*! ************************************************************************
+ * \class LcdPcf8574
+ * \brief HD44780 LCD in the 4 bit mode behind a PCF8574
+ *
+ * Each LCD byte is sent as two nibbles, each nibble needs two expander
+ * writes (enable high, enable low). Instead of one I2C transaction per
+ * expander write, the writes are collected in a batch buffer and sent
+ * with one transaction. A cursor move and a run of up to 30 characters
+ * fit into one transaction.
+ *
+ * The HD44780 needs 37 us per character. At 100 kHz one character takes
+ * 360 us on the bus, so no extra delay is needed in between. Only clear
+ * needs its own delay.
+ *
+ * The characters are sent at once, \ref DisplayBackend::endUpdate has
+ * nothing to do.
+ *
+ * Usage:
+ * \code
+ * lcd.begin(20, 4, WireI2C);
+ * lcd.writeAt(0, 3, (const uint8_t *)"Hello", 5);
+ * \endcode
+ */
+class LcdPcf8574 : public DisplayBackend
+{
+public:
+  /*! ************************************************************************
+   * \brief Constructor for LcdPcf8574
+   * \param address   I2C address of the PCF8574
+   */
+  LcdPcf8574(uint8_t address);
+
+  /*! ************************************************************************
+   * \brief Initialise the LCD in the 4 bit mode
+   *
+   * \param cols    number of columns
+   * \param rows    number of rows
+   * \param wire    I2C bus (already started)
+   */
+  void begin(uint8_t cols, uint8_t rows, TwoWire &wire) override;
+
+  /*! ************************************************************************
+   * \brief Switch the backlight
+   * \param brightness   0 = off, on otherwise (no dimming with the PCF8574)
+   */
+  void setBacklight(uint8_t brightness) override;
+
+  /*! ************************************************************************
+   * \brief Clear the LCD and move the cursor home
+   */
+  void clear();
+
+  /*! ************************************************************************
+   * \brief Move the cursor
+   *
+   * \param col   column
+   * \param row   row
+   */
+  void setCursor(uint8_t col, uint8_t row);
+
+  /*! ************************************************************************
+   * \brief Write characters at the cursor position
+   *
+   * \param buf   characters
+   * \param len   number of characters
+   */
+  void write(const uint8_t *buf, size_t len) override;
+
+  /*! ************************************************************************
+   * \brief Move the cursor and write characters with one I2C transaction
+   *
+   * \param col   column
+   * \param row   row
+   * \param buf   characters
+   * \param len   number of characters
+   */
+  void writeAt(uint8_t col, uint8_t row, const uint8_t *buf, size_t len) override;
+
+  /*! ************************************************************************
+   * \brief Define a custom character in the CGRAM
+   *
+   * The DDRAM address is lost, the cursor has to be set afterwards.
+   *
+   * \param location   number of the character (0..7)
+   * \param charmap    8 rows of the character (5 bits each)
+   */
+  void createChar(uint8_t location, const uint8_t charmap[8]) override;
+
+  /*! ************************************************************************
+   * \brief Get the max I2C clock of the PCF8574
+   * \return \ref LCD_I2C_CLOCK
+   */
+  uint32_t getI2cClock() const override { return LCD_I2C_CLOCK; }
+
+  /*! ************************************************************************
+   * \brief Get the number of I2C bytes sent (incl. address bytes)
+   * \return number of I2C bytes
+   */
+  uint32_t getI2cByteCount() const override { return i2cByteCount; }
+
+  /*! ************************************************************************
+   * \brief Get the number of I2C transactions
+   * \return number of I2C transactions
+   */
+  uint32_t getI2cTransactionCount() const override { return i2cTransactionCount; }
+
+  /*! ************************************************************************
+   * \brief Get the number of failed I2C transactions
+   * \return number of I2C transactions which have not been acknowledged
+   */
+  uint32_t getI2cErrorCount() const override { return i2cErrorCount; }
+
+private:
+  /// I2C bus of the LCD
+  TwoWire *wire = NULL;
+  /// I2C address of the PCF8574
+  uint8_t address;
+  /// number of rows
+  uint8_t rows = 4;
+  /// state of the backlight pin
+  uint8_t backlight = LCD_PCF_BACKLIGHT;
+  /// expander writes of the current transaction
+  uint8_t batch[LCD_I2C_BATCH_SIZE];
+  /// number of expander writes in the batch
+  uint8_t batchLen = 0;
+  /// I2C bytes sent
+  uint32_t i2cByteCount = 0;
+  /// I2C transactions
+  uint32_t i2cTransactionCount = 0;
+  /// I2C transactions which have not been acknowledged
+  uint32_t i2cErrorCount = 0;
+
+  /*! ************************************************************************
+   * \brief Add one nibble with the enable strobe to the batch
+   *
+   * \param nibble   upper 4 bits are the data D4..D7
+   * \param mode     register select (\ref LCD_PCF_RS or 0)
+   */
+  void addNibble(uint8_t nibble, uint8_t mode);
+
+  /*! ************************************************************************
+   * \brief Add one LCD byte to the batch
+   *
+   * \param value   command or character
+   * \param mode    register select (\ref LCD_PCF_RS or 0)
+   */
+  void addByte(uint8_t value, uint8_t mode);
+
+  /*! ************************************************************************
+   * \brief Send the batch with one I2C transaction
+   */
+  void flush();
+};
+
+#endif // LCD_PCF8574_H
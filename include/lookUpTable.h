@@ -17,6 +17,23 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+/** max number of points on the axis that can be used with
+ * \ref lutInterp_pchip (the coefficients are stored inside the object) */
+#define LUT_MAX_AXIS_LEN 16
+
+/*! ************************************************************************
+ * \enum   tLutInterpolation
+ * \brief  Specifies the interpolation in between two points of the axis
+ */
+typedef enum
+{
+  /** linear interpolation in between two points */
+  lutInterp_linear,
+
+  /** monotone cubic interpolation (PCHIP, Fritsch-Carlson). The curve
+   * is smooth and does not overshoot the values of the table. */
+  lutInterp_pchip
+} tLutInterpolation;
 
 /*! ************************************************************************
  * \class LookUpTable1D
@@ -25,6 +42,11 @@
  * The LookUp Table consist of an axis and a table with a given size. All
  * data is stored in fixed point notation with a given precision. 
  * 
+ * Optionally the values can be interpolated with a monotone cubic
+ * spline (\ref lutInterp_pchip). The coefficients of each segment are
+ * calculated once in the constructor, so a lookup just needs a few
+ * multiplications more than the linear interpolation.
+ * 
  */
 class LookUpTable1D
 {
@@ -36,9 +58,32 @@ public:
   * \param table    Pointer to the table (stored const in memory)
   * \param length   number of point in the axis
   * \param fixed_point_decimals   number of decimals for fixed point notation
+  * \param interpolation  interpolation in between two points of the axis
+  *
+  * \note \ref lutInterp_pchip needs at least 2 and at most
+  *       \ref LUT_MAX_AXIS_LEN points, otherwise linear interpolation is used
   */
   LookUpTable1D(const uint32_t *axis, const uint32_t *table, uint8_t length, 
-                uint8_t fixed_point_decimals = 2);
+                uint8_t fixed_point_decimals = 2,
+                tLutInterpolation interpolation = lutInterp_linear);
+
+  /*! ************************************************************************
+  * \brief Assign a new axis and table to the 1D-LookUpTable
+  *
+  * The LookUpTable just keeps the pointers, so axis and table have to stay
+  * valid as long as the LookUpTable is used. The interpolation mode of the
+  * constructor is kept and the coefficients are recalculated.
+  *
+  * \note This method is not thread safe and is meant to be called during
+  *       the setup before the measuring tasks are started.
+  *
+  * \param axis     Pointer to the axis
+  * \param table    Pointer to the table
+  * \param length   number of point in the axis
+  * \param fixed_point_decimals   number of decimals for fixed point notation
+  */
+  void setTable(const uint32_t *axis, const uint32_t *table, uint8_t length,
+                uint8_t fixed_point_decimals);
 
   /*! ************************************************************************
    * \brief Look Up the value in the LookUpTable (fixed point)
@@ -71,6 +116,10 @@ public:
 private:
 
   uint8_t m_fixed_point_decimals;
+  /** interpolation used in between two points of the axis */
+  tLutInterpolation m_interpolation = lutInterp_linear;
+  /** interpolation requested with the constructor */
+  tLutInterpolation m_requested_interpolation = lutInterp_linear;
   /** size of the axis*/
   uint8_t m_length_x_axis;
   /** Position of the look up value on the x axis. If the value is in between 
@@ -90,6 +139,21 @@ private:
   /** pointer to the map in static memory*/
   const uint32_t *m_table;
 
+  /** coefficients of the cubic polynom for each segment of the axis
+   * y = y1 + c1*dx + c2*dx^2 + c3*dx^3 (dx in fixed point notation)*/
+  float m_coef[LUT_MAX_AXIS_LEN - 1][3];
+
+  /*! ************************************************************************
+   * \brief Calculate the coefficients for the monotone cubic interpolation
+   * 
+   * This method calculates the slopes at all points of the axis with the
+   * Fritsch-Carlson method (weighted harmonic mean) and derives the
+   * coefficients of the cubic polynom for each segment. The slopes are
+   * limited, so the curve is monotone in between two points and never
+   * overshoots the values of the table.
+   */
+  void CalcPchipCoefficients();
+
   /*! ************************************************************************
    * \brief Find the corresponding position on the Axis
    * 
@@ -109,8 +173,8 @@ private:
    * \brief Look Up the value in the LookUp Table
    * 
    * This method is looking for the matching result for a given value for the 
-   * axis of the table. The result is linear interpolated in between two
-   * positions of the axis. 
+   * axis of the table. The result is interpolated in between two
+   * positions of the axis (linear or monotone cubic). 
    *
    * \param x_value Value to look up for
    * \return true   value found in between the min/max values of this axis
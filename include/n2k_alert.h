@@ -0,0 +1,228 @@
+// Doxygen Documentation
+/*! \file 	n2k_alert.h
+ *  \brief  NMEA2000 alerts of the engine alarms
+ *
+ * This File contains all the necessary methods to send the engine alarms
+ * as N2K alerts (PGN 126983, 126985) and to receive the acknowledgement
+ * of an MFD (PGN 126984).
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         ESP32-WROOM
+ * - Hardware:          az-delivery-devkit-v4
+ */
+
+#ifndef N2K_ALERT_H
+#define N2K_ALERT_H
+
+#include <Arduino.h>
+#include <NMEA2000.h>
+#include <N2kMessages.h>
+#include <acquire_data.h>
+
+/// Number of alerts in the alert table
+#define N2K_ALERT_COUNT 6
+
+/// Alert system of all engine alerts
+#define N2K_ALERT_SYSTEM 1
+/// Alert sub-system of all engine alerts
+#define N2K_ALERT_SUBSYSTEM 0
+/// Language of the alert texts (English US)
+#define N2K_ALERT_LANGUAGE 0
+/// CAN priority of the alert messages
+#define N2K_ALERT_PRIORITY 2
+/// Period to send an alert again while it is not normal in milliseconds
+#define N2K_ALERT_RESEND_PERIOD_MS 5000
+
+/// Alert type: alarm
+#define N2K_ALERT_TYPE_ALARM 2
+/// Alert type: warning
+#define N2K_ALERT_TYPE_WARNING 5
+/// Alert type: caution
+#define N2K_ALERT_TYPE_CAUTION 8
+/// Alert category: technical
+#define N2K_ALERT_CATEGORY_TECHNICAL 1
+
+/// Alert state: normal (not active)
+#define N2K_ALERT_STATE_NORMAL 1
+/// Alert state: active and not acknowledged
+#define N2K_ALERT_STATE_ACTIVE 2
+/// Alert state: active and acknowledged
+#define N2K_ALERT_STATE_ACKNOWLEDGED 4
+
+/// Trigger condition: automatic
+#define N2K_ALERT_TRIGGER_AUTO 1
+/// Threshold status: normal
+#define N2K_ALERT_THRESHOLD_NORMAL 0
+/// Threshold status: upper threshold exceeded
+#define N2K_ALERT_THRESHOLD_EXCEEDED 1
+/// Threshold status: lower threshold exceeded
+#define N2K_ALERT_THRESHOLD_LOW 3
+
+/// Response command of PGN 126984: acknowledge
+#define N2K_ALERT_RESPONSE_ACK 0
+
+/// Max length of the text of an alert on the LCD Panel
+#define N2K_ALERT_LCD_TEXT_LEN 12
+
+/*! ************************************************************************
+ * \struct  tN2kAlertDefinition
+ * \brief   Static definition of one alert
+ */
+typedef struct tN2kAlertDefinition
+{
+  /// alert ID (unique within the alert system)
+  uint16_t alertId;
+  /// error flag of the engine status which raises the alert
+  ErrorFlag tEngineStatus::*flag;
+  /// alert type (\ref N2K_ALERT_TYPE_ALARM, ...)
+  uint8_t type;
+  /// threshold status while the alert is active
+  uint8_t threshold;
+  /// alert priority (0 = highest)
+  uint8_t priority;
+  /// text of the alert (PGN 126985)
+  const char *text;
+  /// text of the alert on the LCD Panel (max \ref N2K_ALERT_LCD_TEXT_LEN characters)
+  const char *lcdText;
+} tN2kAlertDefinition;
+
+/// Table of all alerts
+extern const tN2kAlertDefinition n2kAlerts[N2K_ALERT_COUNT];
+
+/*! ************************************************************************
+ * \struct  tN2kAlertState
+ * \brief   Current state of one alert on the bus
+ */
+typedef struct tN2kAlertState
+{
+  /// last sent alert state
+  uint8_t state = N2K_ALERT_STATE_NORMAL;
+  /// occurrence number, incremented with each activation
+  uint8_t occurrence = 0;
+  /// NAME of the device which acknowledged the alert, 0 = not acknowledged
+  uint64_t ackName = 0;
+  /// number of sent alert messages
+  uint32_t sentCount = 0;
+  /// time of the last alert message in milliseconds
+  uint32_t lastSentMs = 0;
+} tN2kAlertState;
+
+/*! ************************************************************************
+ * \class N2kAlertManager
+ * \brief Sends the engine alarms as N2K alerts
+ *
+ * The error flags of \ref tEngineStatus are the only alarm state. The
+ * button acknowledges the flags locally, an MFD acknowledges them with
+ * PGN 126984, both are shown on the LCD and on the bus the same way.
+ *
+ * The N2K task compares the change counter of the error flags with each
+ * tick. Only when a flag has been set, reset or acknowledged, the state of
+ * the alerts is evaluated and the alerts which have changed are sent:
+ *
+ * - normal -> active: new occurrence, PGN 126985 (text) and 126983
+ * - active -> acknowledged: PGN 126983 with the NAME of the acknowledging device
+ * - active/acknowledged -> normal: PGN 126983
+ *
+ * While an alert is not normal, its PGN 126983 is sent again every
+ * \ref N2K_ALERT_RESEND_PERIOD_MS, so a display which has been switched on
+ * later or has lost the frame shows it. An ISO request for PGN 126983 or
+ * 126985 sends all alerts which are not normal again at once.
+ */
+class N2kAlertManager
+{
+public:
+  /*! ************************************************************************
+   * \brief Constructor for the N2kAlertManager
+   * \param data   measured data with the error flags of the engine status
+   */
+  N2kAlertManager(AcquireData &data);
+
+  /*! ************************************************************************
+   * \brief Register the fast packet PGNs of the alerts
+   *
+   * Has to be called in the setup before \ref setupN2K opens the bus.
+   */
+  void begin();
+
+  /*! ************************************************************************
+   * \brief Send the alerts which have changed or are due again (N2K task only)
+   */
+  void processTick();
+
+  /*! ************************************************************************
+   * \brief Handle an alert response of an MFD (PGN 126984, RX task)
+   * \param msg   received alert response
+   */
+  void processResponse(const tN2kMsg &msg);
+
+  /*! ************************************************************************
+   * \brief Request to send all active alerts again
+   *
+   * \param pgn   requested PGN
+   * \return true if the PGN is an alert PGN
+   */
+  bool requestSend(unsigned long pgn);
+
+  /*! ************************************************************************
+   * \brief Print the state of all alerts to the terminal
+   */
+  void printLog();
+
+private:
+  /// measured data with the error flags
+  AcquireData &data;
+  /// state of the alerts on the bus
+  tN2kAlertState alertState[N2K_ALERT_COUNT];
+  /// change counter of the error flags at the last evaluation
+  uint32_t lastChangeCount = 0;
+  /// all active alerts have to be sent again
+  volatile bool resendRequested = false;
+  /// protects the acknowledging NAME between the RX and the N2K task
+  portMUX_TYPE alertMux = portMUX_INITIALIZER_UNLOCKED;
+
+  /// received alert responses
+  uint32_t responseCount = 0;
+  /// alert responses which did not match an active alert
+  uint32_t rejectCount = 0;
+
+  /*! ************************************************************************
+   * \brief Check if an alert which is not normal has to be sent again
+   * \param now   current time in milliseconds
+   * \return true if the period of at least one alert has elapsed
+   */
+  bool isResendDue(uint32_t now) const;
+
+  /*! ************************************************************************
+   * \brief Get the error flag of an alert
+   * \param index   index in the alert table
+   * \return error flag of the engine status
+   */
+  ErrorFlag &getFlag(uint8_t index);
+
+  /*! ************************************************************************
+   * \brief Add the common header of the alert PGNs to a message
+   *
+   * \param msg     message to fill
+   * \param index   index in the alert table
+   */
+  void addAlertHeader(tN2kMsg &msg, uint8_t index);
+
+  /*! ************************************************************************
+   * \brief Send the alert (PGN 126983)
+   * \param index   index in the alert table
+   */
+  void sendAlert(uint8_t index);
+
+  /*! ************************************************************************
+   * \brief Send the alert text (PGN 126985)
+   * \param index   index in the alert table
+   */
+  void sendAlertText(uint8_t index);
+};
+
+/// Alert manager of the engine alarms (receives the alert responses)
+extern N2kAlertManager n2kAlertManager;
+
+#endif // N2K_ALERT_H
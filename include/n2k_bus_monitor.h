@@ -0,0 +1,177 @@
+// Doxygen Documentation
+/*! \file 	n2k_bus_monitor.h
+ *  \brief  Monitoring of the NMEA2000 bus (load and errors)
+ *
+ * This File contains all the necessary methods to monitor the NMEA2000
+ * bus. It samples the error counters of the CAN controller and counts the
+ * received and sent frames to calculate the bus load.
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         ESP32-WROOM
+ * - Hardware:          az-delivery-devkit-v4
+ */
+
+#ifndef N2K_BUS_MONITOR_H
+#define N2K_BUS_MONITOR_H
+
+#include <Arduino.h>
+#include <n2k_can_driver.h>
+
+/// Bitrate of the NMEA2000 bus in bit per second
+#define N2K_BUS_BITRATE 250000UL
+
+/// Number of one second buckets for the sliding windows
+#define N2K_BUS_HISTORY_SIZE 60
+
+/// Status register: controller is bus off
+#define TWAI_SR_BUS_OFF 0x80
+/// Status register: an error counter reached the warning limit
+#define TWAI_SR_ERROR_WARNING 0x40
+
+/*! ************************************************************************
+ * \struct  tN2kBusBucket
+ * \brief   Frames and bits on the bus within one second
+ */
+typedef struct tN2kBusBucket
+{
+  /// received frames
+  uint16_t rxFrames = 0;
+  /// sent frames
+  uint16_t txFrames = 0;
+  /// bits of all received and sent frames
+  uint32_t bits = 0;
+} tN2kBusBucket;
+
+/*! ************************************************************************
+ * \struct  tN2kBusStatistic
+ * \brief   State of the NMEA2000 bus
+ */
+typedef struct tN2kBusStatistic
+{
+  /// current TX error counter of the CAN controller
+  uint8_t txErrorCounter = 0;
+  /// current RX error counter of the CAN controller
+  uint8_t rxErrorCounter = 0;
+  /// max TX error counter since start
+  uint8_t maxTxErrorCounter = 0;
+  /// max RX error counter since start
+  uint8_t maxRxErrorCounter = 0;
+  /// controller is bus off
+  bool busOff = false;
+  /// an error counter reached the warning limit
+  bool errorWarning = false;
+  /// number of bus off events
+  uint32_t busOffEvents = 0;
+  /// number of error warning events
+  uint32_t errorWarningEvents = 0;
+  /// received frames in the last second
+  uint16_t rxFramesPerSecond = 0;
+  /// sent frames in the last second
+  uint16_t txFramesPerSecond = 0;
+  /// bus load in the last second in 0.1%
+  uint16_t busLoad1s = 0;
+  /// bus load in the last 10 seconds in 0.1%
+  uint16_t busLoad10s = 0;
+  /// bus load in the last 60 seconds in 0.1%
+  uint16_t busLoad60s = 0;
+  /// max bus load of one second since start in 0.1%
+  uint16_t maxBusLoad1s = 0;
+  /// the CAN controller filtered in the last second, the load holds the
+  /// admitted and the sent frames only
+  bool admittedOnly = false;
+} tN2kBusStatistic;
+
+/*! ************************************************************************
+ * \class N2kBusMonitor
+ * \brief Monitors load and errors of the NMEA2000 bus
+ *
+ * The error counters and the status of the CAN controller are sampled
+ * with every tick of the N2K task. The frames counted by the CAN driver
+ * are collected in buckets of one second, the bus load is calculated
+ * over sliding windows of 1, 10 and 60 seconds.
+ *
+ * The bits of a frame are calculated with the nominal length of an
+ * extended CAN frame (without stuff bits), so the real load is up to
+ * 20% higher.
+ *
+ * \note The CAN controller rejects the frames of other PGNs, so by
+ * default only the admitted and the sent frames are counted
+ * (\ref tN2kBusStatistic::admittedOnly). In the monitor mode of the CAN
+ * driver (terminal "stats monitor on") and while the gateway streams the
+ * frames all frames on the bus are counted.
+ *
+ * \note Arbitration losses are not counted. The CAN controller only
+ * captures the last one and the interrupt of the library does not
+ * report it.
+ */
+class N2kBusMonitor
+{
+public:
+  /*! ************************************************************************
+   * \brief Constructor for the N2kBusMonitor
+   *
+   * \param driver   CAN driver which counts the frames
+   */
+  N2kBusMonitor(N2kCanDriver &driver);
+
+  /*! ************************************************************************
+   * \brief Sample the CAN controller and update the statistic
+   *
+   * This method has to be called cyclically by the N2K task.
+   */
+  void processTick();
+
+  /*! ************************************************************************
+   * \brief Get a copy of the bus statistic
+   * \return bus statistic
+   */
+  tN2kBusStatistic getStatistic();
+
+  /*! ************************************************************************
+   * \brief Print the bus statistic to the terminal
+   */
+  void printStatistic();
+
+private:
+  /// CAN driver which counts the frames
+  N2kCanDriver &driver;
+
+  /// statistic of the bus
+  tN2kBusStatistic statistic;
+  /// spinlock to protect the statistic
+  portMUX_TYPE muxStatistic = portMUX_INITIALIZER_UNLOCKED;
+
+  /// buckets of the last seconds
+  tN2kBusBucket history[N2K_BUS_HISTORY_SIZE];
+  /// index of the next bucket
+  uint8_t historyIndex = 0;
+  /// number of valid buckets
+  uint8_t historyCount = 0;
+
+  /// monitor has been started
+  bool started = false;
+  /// start of the current bucket in milliseconds
+  uint32_t bucketStartMs = 0;
+  /// frame counters of the driver at the start of the bucket
+  tN2kFrameCounter lastCounter;
+  /// the CAN controller filtered within the current bucket
+  bool bucketFiltered = false;
+
+  /*! ************************************************************************
+   * \brief Calculate the bus load over the last seconds
+   * \param seconds   length of the window
+   * \return bus load in 0.1%
+   */
+  uint16_t calcBusLoad(uint8_t seconds) const;
+
+  /*! ************************************************************************
+   * \brief Read a register of the CAN controller
+   * \param address   address of the register
+   * \return value of the register
+   */
+  static uint8_t readRegister(uint32_t address);
+};
+
+#endif // N2K_BUS_MONITOR_H
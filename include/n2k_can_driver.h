@@ -0,0 +1,477 @@
+// Doxygen Documentation
+/*! \file 	n2k_can_driver.h
+ *  \brief  Event driven CAN driver for the NMEA2000 library
+ *
+ * This File contains the CAN driver for the ESP32. It extends the driver
+ * of the NMEA2000 library, so the N2K task can sleep until a frame has
+ * been received by the CAN interrupt.
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         ESP32-WROOM
+ * - Hardware:          az-delivery-devkit-v4
+ */
+
+#ifndef N2K_CAN_DRIVER_H
+#define N2K_CAN_DRIVER_H
+
+#include <Arduino.h>
+#include <hardwareDef.h>
+#include <NMEA2000_esp32.h>
+#include <n2k_gateway.h>
+#include <atomic>
+
+/// Window for the calculation of the idle time in milliseconds
+#define N2K_RX_STAT_WINDOW_MS 1000
+
+/// Number of N2K priorities (0 = highest .. 7 = lowest)
+#define N2K_TX_PRIO_LEVELS 8
+/// Number of frames in the TX queue of each priority
+#define N2K_TX_QUEUE_DEPTH 24
+/// Number of PGNs with their own TX counters (the last one counts all others)
+#define N2K_TX_COUNTER_SIZE 8
+
+/// Nominal bits of an extended CAN frame without data (incl. intermission)
+#define N2K_CAN_FRAME_OVERHEAD_BITS 67
+
+/// Max number of PGNs for the acceptance filter
+#define N2K_FILTER_MAX_PGNS 16
+/// Bits of the acceptance filter (ID28..ID13) with the priority
+#define N2K_FILTER_PRIO_MASK 0xE000
+/// Bits of the acceptance filter (ID28..ID13) with the upper 3 bits of PS
+#define N2K_FILTER_PS_MASK 0x0007
+
+/// Base address of the CAN controller (TWAI) of the ESP32
+#define TWAI_REG_BASE 0x3FF6B000UL
+/// Status register of the CAN controller
+#define TWAI_REG_SR (TWAI_REG_BASE + 0x08)
+/// Interrupt register of the CAN controller (cleared by the read)
+#define TWAI_REG_IR (TWAI_REG_BASE + 0x0C)
+/// RX error counter of the CAN controller
+#define TWAI_REG_RXERR (TWAI_REG_BASE + 0x38)
+/// TX error counter of the CAN controller
+#define TWAI_REG_TXERR (TWAI_REG_BASE + 0x3C)
+/// Mode register of the CAN controller
+#define TWAI_REG_MOD (TWAI_REG_BASE + 0x00)
+/// First acceptance code register (ACR0..ACR3 follow every 4 bytes)
+#define TWAI_REG_ACR0 (TWAI_REG_BASE + 0x40)
+/// First acceptance mask register (AMR0..AMR3 follow every 4 bytes)
+#define TWAI_REG_AMR0 (TWAI_REG_BASE + 0x50)
+/// Mode register: reset mode
+#define TWAI_MOD_RESET 0x01
+/// Mode register: single acceptance filter
+#define TWAI_MOD_AFM 0x08
+/// Status register: transmit buffer free
+#define TWAI_SR_TBS 0x04
+/// Interrupt register: frame received
+#define TWAI_IR_RX 0x01
+/// Interrupt register: transmit buffer free again
+#define TWAI_IR_TX 0x02
+
+/*! ************************************************************************
+ * \struct  tN2kFrameCounter
+ * \brief   Frames and bits on the bus since start (wrap around)
+ */
+typedef struct tN2kFrameCounter
+{
+  /// received frames
+  uint32_t rxFrames = 0;
+  /// frames written to the CAN controller
+  uint32_t txFrames = 0;
+  /// nominal bits of all received frames
+  uint32_t rxBits = 0;
+  /// nominal bits of all sent frames
+  uint32_t txBits = 0;
+} tN2kFrameCounter;
+
+/*! ************************************************************************
+ * \struct  tN2kTxCounter
+ * \brief   TX queue counters of one PGN (frames)
+ */
+typedef struct tN2kTxCounter
+{
+  /// PGN of the counters, 0 for all other PGNs
+  unsigned long pgn = 0;
+  /// frames put into the priority queue
+  uint32_t queued = 0;
+  /// frames written to the CAN controller
+  uint32_t sent = 0;
+  /// frames dropped because the queue of the priority was full
+  uint32_t dropped = 0;
+  /// max number of frames in all priority queues when a frame was queued
+  uint16_t maxDepth = 0;
+} tN2kTxCounter;
+
+/*! ************************************************************************
+ * \struct  tN2kTxFifo
+ * \brief   TX queue of one N2K priority
+ */
+typedef struct tN2kTxFifo
+{
+  /// CAN id of the frames
+  uint32_t id[N2K_TX_QUEUE_DEPTH];
+  /// length of the frames
+  uint8_t len[N2K_TX_QUEUE_DEPTH];
+  /// data of the frames
+  uint8_t buf[N2K_TX_QUEUE_DEPTH][8];
+  /// index of the TX counters of the frames
+  uint8_t counter[N2K_TX_QUEUE_DEPTH];
+  /// index of the oldest frame
+  uint8_t head = 0;
+  /// number of frames
+  uint8_t count = 0;
+} tN2kTxFifo;
+
+/*! ************************************************************************
+ * \struct  tN2kRxStatistic
+ * \brief   Receive statistic of the N2K task
+ */
+typedef struct tN2kRxStatistic
+{
+  /// number of wake ups by a received frame
+  uint32_t wakeUps = 0;
+  /// number of wake ups by timeout (no frame)
+  uint32_t timeouts = 0;
+  /// last latency from wake up until all frames are handled in microseconds
+  uint32_t lastLatencyUs = 0;
+  /// max latency from wake up until all frames are handled in microseconds
+  uint32_t maxLatencyUs = 0;
+  /// sum of all latencies in microseconds (for the mean value)
+  uint64_t sumLatencyUs = 0;
+  /// idle time of the N2K task in the last window in percent
+  uint8_t idlePercent = 0;
+  /// frames counted for the load but not admitted by the acceptance filter
+  uint32_t rejectedFrames = 0;
+  /// max time the N2K task was busy without handling the frames in microseconds
+  uint32_t maxBusyGapUs = 0;
+  /// size of the RX queue of the CAN interrupt
+  uint16_t queueSize = 0;
+  /// max number of frames in the RX queue of the CAN interrupt
+  uint16_t maxQueueDepth = 0;
+  /// handlings which found the RX queue full (the interrupt drops new frames)
+  uint32_t queueFull = 0;
+} tN2kRxStatistic;
+
+/*! ************************************************************************
+ * \class N2kCanDriver
+ * \brief CAN driver which wakes up the N2K task on received frames
+ *
+ * The CAN interrupt of the library writes every received frame into
+ * its RX queue. Instead of polling \ref tNMEA2000::ParseMessages, the N2K
+ * task blocks on this queue with \ref waitForFrame and only runs when a
+ * frame is available or the timeout of the next own job has elapsed.
+ *
+ * The time the task is blocked and the time to handle the frames after
+ * the wake up are measured and can be shown on the terminal ("n2k").
+ * A frame which arrives while the task is busy with its own jobs waits
+ * for the next handling, so the max busy time between two handlings is
+ * the max RX latency. The interrupt drops a frame when the RX queue is
+ * full, the fill level of the queue is recorded for each handling.
+ *
+ * All frames to send are put into a bounded queue per N2K priority. The
+ * driver installs its own CAN interrupt in place of the one of the
+ * library: when the transmit buffer is free again, the interrupt writes
+ * the next frame of the highest priority to the CAN controller. So a
+ * rapid engine PGN goes ahead of the slow temperatures and system
+ * messages, and the N2K task does not have to poll the queues. When the
+ * queue of a priority is full the frame is dropped, counted and reported
+ * to the library.
+ *
+ * The acceptance filter compares the bits ID28..ID13 of an extended
+ * frame (priority, data page, PF and the upper 3 bits of PS) with two
+ * codes and masks, like the dual filter mode of the CAN controller. The
+ * PGNs of \ref setAcceptanceFilter are split into two groups, so the
+ * filters admit as few other PGNs as possible.
+ *
+ * The filter is written to the CAN controller when the bus is opened, so
+ * the other frames cause no interrupt and no work of the N2K task. The
+ * rejected frames are missing in the bus load then. In the monitor mode
+ * (\ref setMonitorMode) and while the gateway streams the frames the
+ * filter of the CAN controller is opened by \ref processMessages: every
+ * frame is counted for the bus load and streamed to the gateway, the
+ * filter is applied in \ref CANGetFrame and only the admitted frames are
+ * parsed by the library.
+ */
+class N2kCanDriver : public tNMEA2000_esp32
+{
+public:
+  /*! ************************************************************************
+   * \brief Constructor for the N2kCanDriver
+   *
+   * \param txPin     GPIO of the CAN TX
+   * \param rxPin     GPIO of the CAN RX
+   * \param gateway   stream of all received and sent frames
+   */
+  N2kCanDriver(gpio_num_t txPin, gpio_num_t rxPin, N2kGateway &gateway);
+
+  /*! ************************************************************************
+   * \brief Wait until a frame has been received
+   *
+   * The task is blocked until the CAN interrupt has written a frame into
+   * the RX queue or the timeout elapsed. The frame stays in the queue.
+   *
+   * \param timeout   max time to wait in ticks
+   * \return true   a frame is available
+   * \return false  timeout, no frame received
+   */
+  bool waitForFrame(TickType_t timeout);
+
+  /*! ************************************************************************
+   * \brief Handle all received frames
+   *
+   * Calls \ref tNMEA2000::ParseMessages and measures the latency since
+   * the wake up of \ref waitForFrame. The filter of the CAN controller is
+   * opened in the monitor mode and while the gateway streams the frames.
+   * The transmission is restarted, if a TX interrupt has been lost while
+   * the CAN controller was in the reset mode.
+   */
+  void processMessages();
+
+  /*! ************************************************************************
+   * \brief Get the number of frames waiting in the priority queues
+   * \return number of frames (backlog)
+   */
+  uint16_t getTxQueueCount() const { return txQueueCount; }
+
+  /*! ************************************************************************
+   * \brief Calculate the acceptance filter for a list of PGNs
+   *
+   * The filter is used when the bus is opened, so this method has to be
+   * called before. Other PGNs with the same bits in ID28..ID13 are
+   * admitted, too, the admitted PF ranges are shown by \ref printRxLog.
+   *
+   * \param pgns    PGNs to receive
+   * \param count   number of PGNs (max \ref N2K_FILTER_MAX_PGNS)
+   */
+  void setAcceptanceFilter(const unsigned long *pgns, uint8_t count);
+
+  /*! ************************************************************************
+   * \brief Start or stop the monitor mode
+   *
+   * The monitor mode opens the filter of the CAN controller with the next
+   * handling of the N2K task, so all frames of the bus are counted for the
+   * bus load. Every frame causes an interrupt and is checked by the N2K
+   * task then.
+   *
+   * \param enabled   true to count all frames of the bus
+   */
+  void setMonitorMode(bool enabled) { monitorMode.store(enabled, std::memory_order_relaxed); }
+
+  /*! ************************************************************************
+   * \brief Check if the monitor mode is running
+   * \return true if all frames of the bus are counted
+   */
+  bool isMonitorMode() const { return monitorMode.load(std::memory_order_relaxed); }
+
+  /*! ************************************************************************
+   * \brief Check if the CAN controller rejects the frames of other PGNs
+   * \return true if the frame counters hold the admitted frames only
+   */
+  bool isHardwareFilterClosed() const { return hardwareFilterClosed; }
+
+  /*! ************************************************************************
+   * \brief Get the frame counters for the bus load
+   *
+   * The TX counters are written by the CAN interrupt, so a copy is taken.
+   *
+   * \return frame counters since start
+   */
+  tN2kFrameCounter getFrameCounter() const;
+
+  /*! ************************************************************************
+   * \brief Get the receive statistic
+   * \return reference to the receive statistic
+   */
+  const tN2kRxStatistic &getRxStatistic() const { return rxStatistic; }
+
+  /*! ************************************************************************
+   * \brief Print the receive statistic to the terminal
+   */
+  void printRxLog() const;
+
+  /*! ************************************************************************
+   * \brief Print the TX queue counters to the terminal
+   */
+  void printTxLog() const;
+
+protected:
+  /*! ************************************************************************
+   * \brief Put a frame into the queue of its priority
+   *
+   * Overrides the method of tNMEA2000_esp32, which is called by the
+   * library for every frame to send.
+   *
+   * \param id         CAN id of the frame
+   * \param len        length of the frame
+   * \param buf        data of the frame
+   * \param wait_sent  not used
+   * \return true   the frame is queued or sent
+   * \return false  the queue of the priority is full, the frame is dropped
+   */
+  bool CANSendFrame(unsigned long id, unsigned char len, const unsigned char *buf, bool wait_sent = true) override;
+
+  /*! ************************************************************************
+   * \brief Get a received frame and count it
+   *
+   * Overrides the method of tNMEA2000_esp32, which is called by the
+   * library in \ref tNMEA2000::ParseMessages. Every frame is counted and
+   * streamed to the gateway, frames not admitted by the acceptance filter
+   * are skipped (only while the filter of the CAN controller is open).
+   *
+   * \param id    CAN id of the frame
+   * \param len   length of the frame
+   * \param buf   data of the frame
+   * \return true if a frame has been received
+   */
+  bool CANGetFrame(unsigned long &id, unsigned char &len, unsigned char *buf) override;
+
+  /*! ************************************************************************
+   * \brief Open the CAN controller and set the acceptance filter
+   *
+   * Overrides the method of tNMEA2000_esp32, which is called by the
+   * library in \ref tNMEA2000::Open.
+   *
+   * \return true if the CAN controller has been opened
+   */
+  bool CANOpen() override;
+
+private:
+  /// stream of all received and sent frames
+  N2kGateway &gateway;
+
+  /// receive statistic
+  tN2kRxStatistic rxStatistic;
+  /// timestamp of the last wake up in microseconds
+  uint32_t wakeUpUs = 0;
+  /// time blocked in the last wait in microseconds
+  uint32_t blockedUs = 0;
+  /// end of the last handling of the frames in microseconds
+  uint32_t handledUs = 0;
+  /// last wake up has been caused by a frame
+  bool frameReceived = false;
+  /// start of the current statistic window in microseconds
+  uint32_t windowStartUs = 0;
+  /// blocked time in the current statistic window in microseconds
+  uint32_t windowIdleUs = 0;
+
+  /// TX queue of each priority (shared with the CAN interrupt)
+  tN2kTxFifo txFifo[N2K_TX_PRIO_LEVELS];
+  /// number of frames in all TX queues
+  volatile uint16_t txQueueCount = 0;
+  /// the own CAN interrupt is installed
+  bool interruptInstalled = false;
+  /// lock of the TX queues and the TX counters against the CAN interrupt
+  mutable portMUX_TYPE muxTx = portMUX_INITIALIZER_UNLOCKED;
+  /// TX counters of the PGNs
+  tN2kTxCounter txCounter[N2K_TX_COUNTER_SIZE];
+  /// frame counters for the bus load
+  tN2kFrameCounter frameCounter;
+
+  /// acceptance filter has been calculated
+  bool filterActive = false;
+  /// code of both acceptance filters (ID28..ID13)
+  uint16_t filterCode[2] = {0, 0};
+  /// mask of both acceptance filters (ID28..ID13), 1 = don't care
+  uint16_t filterMask[2] = {0xFFFF, 0xFFFF};
+  /// the acceptance filter is written to the CAN controller
+  bool hardwareFilterClosed = false;
+  /// all frames of the bus are counted (filter of the CAN controller open)
+  std::atomic<bool> monitorMode{false};
+
+  /*! ************************************************************************
+   * \brief CAN interrupt, calls \ref handleInterrupt of the driver
+   * \param arg   the driver
+   */
+  static void interruptHandler(void *arg);
+
+  /*! ************************************************************************
+   * \brief Handle the CAN interrupt
+   *
+   * A received frame is read into the RX queue of the library, a free
+   * transmit buffer gets the next frame of the priority queues.
+   */
+  void handleInterrupt();
+
+  /*! ************************************************************************
+   * \brief Write the next frame of the highest priority to the CAN controller
+   *
+   * Nothing is done while the transmit buffer is busy, the TX interrupt
+   * calls again when it is free. Has to be called with \ref muxTx locked.
+   */
+  void sendNextFrame();
+
+  /*! ************************************************************************
+   * \brief Write the acceptance filter to the CAN controller
+   *
+   * The controller is set to the reset mode for the write, a frame on the
+   * bus in this moment is lost.
+   *
+   * \param closed   true for the calculated filter, false to admit all frames
+   */
+  void writeHardwareFilter(bool closed);
+
+  /*! ************************************************************************
+   * \brief Check if a frame is admitted by the acceptance filter
+   * \param id   CAN id of the frame
+   * \return true if one of both filters admits the frame
+   */
+  bool isAdmitted(unsigned long id) const;
+
+  /*! ************************************************************************
+   * \brief Print the PGNs admitted by one acceptance filter
+   *
+   * The data pages, the ranges of PF and the range of PS are printed, all
+   * PGNs within these ranges are admitted.
+   *
+   * \param index   filter 0 or 1
+   */
+  void printFilter(uint8_t index) const;
+
+  /*! ************************************************************************
+   * \brief Get the TX counters of the PGN of a frame
+   *
+   * A PGN without counters gets the next free entry. When all are used
+   * the last entry counts all other PGNs.
+   *
+   * \param id   CAN id of the frame
+   * \return reference to the TX counters
+   */
+  tN2kTxCounter &getTxCounter(unsigned long id);
+
+  /*! ************************************************************************
+   * \brief Get the PGN from a CAN id
+   * \param id   CAN id of the frame
+   * \return PGN
+   */
+  static unsigned long pgnFromCanId(unsigned long id);
+
+  /*! ************************************************************************
+   * \brief Merge PGNs into the code and mask of one acceptance filter
+   *
+   * \param pgns    PGNs to receive
+   * \param count   number of PGNs
+   * \param group   bit i set = PGN i is merged
+   * \param code    code of the filter (ID28..ID13)
+   * \param mask    mask of the filter (ID28..ID13), 1 = don't care
+   * \return false if no PGN is in the group
+   */
+  static bool mergeFilter(const unsigned long *pgns, uint8_t count, uint32_t group,
+                          uint16_t &code, uint16_t &mask);
+
+  /*! ************************************************************************
+   * \brief Write a register of the CAN controller
+   * \param address   address of the register
+   * \param value     value of the register
+   */
+  static void writeRegister(uint32_t address, uint8_t value);
+
+  /*! ************************************************************************
+   * \brief Read a register of the CAN controller
+   * \param address   address of the register
+   * \return value of the register
+   */
+  static uint8_t readRegister(uint32_t address);
+};
+
+#endif // N2K_CAN_DRIVER_H
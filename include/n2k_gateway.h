@@ -0,0 +1,138 @@
+// Doxygen Documentation
+/*! \file 	n2k_gateway.h
+ *  \brief  Stream of all N2K frames to the USB terminal
+ *
+ * This File contains all the necessary methods to stream all received
+ * and sent CAN frames in the Yacht Devices RAW format to the USB
+ * terminal, so the traffic of the bus can be logged and replayed on a
+ * laptop (tools/n2k_raw_decode.py).
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         ESP32-WROOM
+ * - Hardware:          az-delivery-devkit-v4
+ */
+
+#ifndef N2K_GATEWAY_H
+#define N2K_GATEWAY_H
+
+#include <Arduino.h>
+#include <atomic>
+
+/// Number of frames in the ring buffer (power of 2)
+#define N2K_GATEWAY_RING_SIZE 128
+/// Size of one batch written to the terminal in bytes
+#define N2K_GATEWAY_BATCH_SIZE 256
+/// Length of a line without data: time (12), direction (3), id (8), CR LF
+#define N2K_GATEWAY_LINE_OVERHEAD 25
+/// Max length of one line in the RAW format
+#define N2K_GATEWAY_LINE_MAX (N2K_GATEWAY_LINE_OVERHEAD + 8 * 3)
+
+/*! ************************************************************************
+ * \struct  tN2kGatewayFrame
+ * \brief   CAN frame in the ring buffer of the gateway
+ */
+typedef struct tN2kGatewayFrame
+{
+  /// time of the frame in milliseconds
+  uint32_t timeMs;
+  /// CAN id of the frame
+  uint32_t id;
+  /// length of the frame
+  uint8_t len;
+  /// frame has been sent (true) or received (false)
+  bool tx;
+  /// data of the frame
+  uint8_t buf[8];
+} tN2kGatewayFrame;
+
+/*! ************************************************************************
+ * \class N2kGateway
+ * \brief Streams all CAN frames in the Yacht Devices RAW format
+ *
+ * The CAN driver puts every received and sent frame into a lock free
+ * ring buffer (single producer: N2K task, single consumer: loop). The
+ * consumer formats the frames into batches and writes each batch with
+ * one call to the terminal:
+ *
+ * \code
+ * 17:33:21.107 R 19F51323 01 2F 30 70 00 2F 30 70
+ * \endcode
+ *
+ * The time is the time since the start of the device. Frames are dropped
+ * and counted when the ring buffer is full, so a slow terminal never
+ * blocks the N2K task. A line with 8 data bytes takes 49 bytes, so the
+ * terminal at 115200 baud carries about 235 frames/s. The gateway build
+ * runs the terminal at 921600 baud for about 1880 frames/s, the load of a
+ * fully loaded bus.
+ */
+class N2kGateway
+{
+public:
+  /*! ************************************************************************
+   * \brief Start or stop the stream
+   * \param enabled   true to stream all frames
+   */
+  void setEnabled(bool enabled);
+
+  /*! ************************************************************************
+   * \brief Check if the stream is running
+   * \return true if all frames are streamed
+   */
+  bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+  /*! ************************************************************************
+   * \brief Put a frame into the ring buffer (N2K task only)
+   *
+   * \param id    CAN id of the frame
+   * \param len   length of the frame
+   * \param buf   data of the frame
+   * \param tx    frame has been sent (true) or received (false)
+   */
+  void pushFrame(uint32_t id, uint8_t len, const uint8_t *buf, bool tx);
+
+  /*! ************************************************************************
+   * \brief Write the frames of the ring buffer to the terminal
+   *
+   * All frames in the ring buffer at the call are written. This method is
+   * non blocking for the producer and has to be called cyclically by the
+   * owner of the terminal.
+   */
+  void processStream();
+
+  /*! ************************************************************************
+   * \brief Print the counters of the stream to the terminal
+   */
+  void printLog() const;
+
+private:
+  /// ring buffer of the frames
+  tN2kGatewayFrame ring[N2K_GATEWAY_RING_SIZE];
+  /// index of the next frame to write (producer)
+  std::atomic<uint16_t> head{0};
+  /// index of the next frame to read (consumer)
+  std::atomic<uint16_t> tail{0};
+  /// stream is running
+  std::atomic<bool> enabled{false};
+
+  /// frames put into the ring buffer
+  uint32_t frameCount = 0;
+  /// frames dropped because the ring buffer was full
+  uint32_t dropCount = 0;
+  /// bytes written to the terminal
+  uint32_t byteCount = 0;
+  /// batches written to the terminal
+  uint32_t batchCount = 0;
+
+  /*! ************************************************************************
+   * \brief Format a frame as one line of the RAW format
+   *
+   * \param frame   frame to format
+   * \param line    buffer with at least \ref N2K_GATEWAY_LINE_MAX bytes
+   * \return length of the line
+   */
+  static uint8_t formatFrame(const tN2kGatewayFrame &frame, char *line);
+};
+
+#endif // N2K_GATEWAY_H
@@ -0,0 +1,122 @@
+// Doxygen Documentation
+/*! \file 	n2k_msg_cache.h
+ *  \brief  Cache of encoded N2K messages
+ *
+ * This File contains all the necessary methods to keep an encoded N2K
+ * message per PGN and instance. The message is only encoded again when
+ * one of its source values (in N2K resolution) has changed.
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         ESP32-WROOM
+ * - Hardware:          az-delivery-devkit-v4
+ */
+
+#ifndef N2K_MSG_CACHE_H
+#define N2K_MSG_CACHE_H
+
+#include <Arduino.h>
+#include <NMEA2000.h>
+#include <N2kMessages.h>
+
+/// max number of source values of one cached message
+#define N2K_CACHE_MAX_VALUES 8
+
+/*! ************************************************************************
+ * \class N2kMsgCache
+ * \brief Encoded N2K message of one PGN and instance
+ *
+ * The source values of a message are already scaled integers in the N2K
+ * resolution (\ref tVolvoPentaData). As long as they are equal, the
+ * encoded message would be the same, so the cached message is sent again
+ * without encoding.
+ *
+ * Usage:
+ * \code
+ * if (!cache.isUpToDate(values, count))
+ * {
+ *   SetN2k...(cache.getMsg(), ...);
+ * }
+ * cache.send();
+ * \endcode
+ */
+class N2kMsgCache
+{
+public:
+  /*! ************************************************************************
+   * \brief Constructor for N2kMsgCache
+   *
+   * \param pgn       PGN of the cached message (for the log only)
+   * \param instance  instance of the cached message (for the log only)
+   */
+  N2kMsgCache(unsigned long pgn, uint8_t instance);
+
+  /*! ************************************************************************
+   * \brief Constructor for N2kMsgCache without PGN and instance
+   *
+   * Used for arrays of caches, the PGN and instance are set by \ref setId.
+   */
+  N2kMsgCache() : N2kMsgCache(0, 0) {}
+
+  /*! ************************************************************************
+   * \brief Set PGN and instance of the cached message (for the log only)
+   *
+   * \param pgn       PGN of the cached message
+   * \param instance  instance of the cached message
+   */
+  void setId(unsigned long pgn, uint8_t instance)
+  {
+    this->pgn = pgn;
+    this->instance = instance;
+  }
+
+  /*! ************************************************************************
+   * \brief Check if the cached message matches the source values
+   *
+   * The values are compared with the values of the cached message. If
+   * they differ, the new values are stored and the message has to be
+   * encoded again by the caller.
+   *
+   * \param values       source values of the message in N2K resolution
+   * \param count        number of values (max \ref N2K_CACHE_MAX_VALUES)
+   * \return true   cached message is up to date
+   * \return false  message has to be encoded into \ref getMsg
+   */
+  bool isUpToDate(const int32_t *values, uint8_t count);
+
+  /*! ************************************************************************
+   * \brief Get the cached message
+   * \return reference to the cached message
+   */
+  tN2kMsg &getMsg() { return msg; }
+
+  /*! ************************************************************************
+   * \brief Send the cached message to the NMEA2000 bus
+   * \return true if the message has been sent
+   */
+  bool send();
+
+  /*! ************************************************************************
+   * \brief Print the cache statistic to the terminal
+   */
+  void printLog() const;
+
+private:
+  /// PGN of the cached message
+  unsigned long pgn;
+  /// instance of the cached message
+  uint8_t instance;
+  /// encoded message
+  tN2kMsg msg;
+  /// source values of the encoded message
+  int32_t keys[N2K_CACHE_MAX_VALUES];
+  /// message has been encoded at least once
+  bool valid = false;
+  /// number of encodings
+  uint32_t encodeCount = 0;
+  /// number of transmissions of the cached message without encoding
+  uint32_t hitCount = 0;
+};
+
+#endif // N2K_MSG_CACHE_H
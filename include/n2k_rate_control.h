@@ -0,0 +1,119 @@
+// Doxygen Documentation
+/*! \file 	n2k_rate_control.h
+ *  \brief  Adaptive transmit rate of the N2K messages
+ *
+ * This File contains all the necessary methods to adapt the transmit
+ * rate of the low priority PGNs to the load of the NMEA2000 bus and to
+ * the backlog of the own TX queue.
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         ESP32-WROOM
+ * - Hardware:          az-delivery-devkit-v4
+ */
+
+#ifndef N2K_RATE_CONTROL_H
+#define N2K_RATE_CONTROL_H
+
+#include <Arduino.h>
+#include <n2k_can_driver.h>
+#include <n2k_bus_monitor.h>
+
+/// Max stretch of the periods (periods are at their max)
+#define N2K_RATE_STRETCH_MAX 1000
+
+/// Bus load (10s) in 0.1% up to which the nominal periods are used
+#define N2K_RATE_LOAD_LOW 300
+/// Bus load (10s) in 0.1% from which the max periods are used
+#define N2K_RATE_LOAD_HIGH 600
+/// TX backlog in frames from which the max periods are used at once
+#define N2K_RATE_BACKLOG_HIGH 12
+/// Decrease of the stretch per second when the load has dropped
+#define N2K_RATE_STRETCH_DECAY 100
+
+/// Number of logged seconds
+#define N2K_RATE_LOG_SIZE 60
+
+/*! ************************************************************************
+ * \struct  tN2kRateLogEntry
+ * \brief   Logged state of the rate control for one second
+ */
+typedef struct tN2kRateLogEntry
+{
+  /// bus load of the second in 0.1%
+  uint16_t busLoad = 0;
+  /// max backlog of the own TX queue within the second in frames
+  uint16_t maxBacklog = 0;
+  /// stretch of the periods at the end of the second
+  uint16_t stretch = 0;
+} tN2kRateLogEntry;
+
+/*! ************************************************************************
+ * \class N2kRateController
+ * \brief Stretches the periods of the low priority PGNs on a busy bus
+ *
+ * Once per second the bus load of the last 10 seconds and the max
+ * backlog of the own TX queue are taken to calculate a stretch in between
+ * 0 (nominal periods) and \ref N2K_RATE_STRETCH_MAX (max periods). A
+ * rising load is followed at once, a falling load slowly with
+ * \ref N2K_RATE_STRETCH_DECAY per second, so the rates do not oscillate.
+ *
+ * The scheduler uses the stretch for all PGNs with a max period in the
+ * table \ref n2kSchedule. PGNs without max period keep their rate.
+ */
+class N2kRateController
+{
+public:
+  /*! ************************************************************************
+   * \brief Constructor for the N2kRateController
+   *
+   * \param driver       CAN driver with the own TX queue
+   * \param busMonitor   monitor with the load of the bus
+   */
+  N2kRateController(N2kCanDriver &driver, N2kBusMonitor &busMonitor);
+
+  /*! ************************************************************************
+   * \brief Sample the backlog and update the stretch once per second
+   *
+   * This method has to be called cyclically by the N2K task.
+   */
+  void processTick();
+
+  /*! ************************************************************************
+   * \brief Get the current stretch of the periods
+   * \return stretch in between 0 and \ref N2K_RATE_STRETCH_MAX
+   */
+  uint16_t getStretch() const { return stretch; }
+
+  /*! ************************************************************************
+   * \brief Print the log of bus load, backlog and stretch to the terminal
+   */
+  void printLog();
+
+private:
+  /// CAN driver with the own TX queue
+  N2kCanDriver &driver;
+  /// monitor with the load of the bus
+  N2kBusMonitor &busMonitor;
+
+  /// current stretch of the periods
+  uint16_t stretch = 0;
+  /// max backlog in the current second
+  uint16_t maxBacklog = 0;
+  /// start of the current second in milliseconds
+  uint32_t secondStartMs = 0;
+  /// controller has been started
+  bool started = false;
+
+  /// log of the last seconds
+  tN2kRateLogEntry log[N2K_RATE_LOG_SIZE];
+  /// index of the next log entry
+  uint8_t logIndex = 0;
+  /// number of valid log entries
+  uint8_t logCount = 0;
+  /// spinlock to protect the log
+  portMUX_TYPE muxLog = portMUX_INITIALIZER_UNLOCKED;
+};
+
+#endif // N2K_RATE_CONTROL_H
@@ -0,0 +1,176 @@
+// Doxygen Documentation
+/*! \file 	n2k_receive.h
+ *  \brief  Receiving of N2K messages from other devices
+ *
+ * This File contains all the necessary methods to receive the PGNs of
+ * other devices (system time, other engines, alert responses). Only the
+ * PGNs of the dispatch table are admitted by the acceptance filter of the
+ * CAN controller, they are handled in their own RX task.
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         ESP32-WROOM
+ * - Hardware:          az-delivery-devkit-v4
+ */
+
+#ifndef N2K_RECEIVE_H
+#define N2K_RECEIVE_H
+
+#include <Arduino.h>
+#include <NMEA2000.h>
+#include <N2kMessages.h>
+#include <n2k_can_driver.h>
+#include <process_n2k.h>
+
+/// Number of messages waiting for the RX task
+#define N2K_RX_QUEUE_SIZE 8
+/// Number of engine instances of other devices which are stored
+#define N2K_RX_ENGINE_INSTANCES 4
+/// Number of entries in the dispatch table
+#define N2K_RX_DISPATCH_SIZE 4
+
+/*! ************************************************************************
+ * \struct  tN2kRemoteEngine
+ * \brief   Engine data received from an other device
+ */
+typedef struct tN2kRemoteEngine
+{
+  /// source address of the sender, 0xFF = never received
+  uint8_t source = 0xFF;
+  /// engine speed in rpm
+  double speed = N2kDoubleNA;
+  /// coolant temperature in K
+  double coolantTemp = N2kDoubleNA;
+  /// oil pressure in Pa
+  double oilPressure = N2kDoubleNA;
+  /// time of the last message in milliseconds
+  uint32_t lastMs = 0;
+} tN2kRemoteEngine;
+
+/*! ************************************************************************
+ * \struct  tN2kReceivedData
+ * \brief   All data received from other devices
+ */
+typedef struct tN2kReceivedData
+{
+  /// system date in days since 1970-01-01
+  uint16_t systemDate = 0;
+  /// system time in seconds since midnight (UTC)
+  double systemTime = N2kDoubleNA;
+  /// time of the last system time message in milliseconds
+  uint32_t systemTimeMs = 0;
+  /// engines of other devices by instance
+  tN2kRemoteEngine engine[N2K_RX_ENGINE_INSTANCES];
+} tN2kReceivedData;
+
+/// Pointer to a method which decodes one received PGN
+typedef void (*tN2kReceiveFunction)(const tN2kMsg &msg, tN2kReceivedData &data);
+
+/*! ************************************************************************
+ * \struct  tN2kDispatchEntry
+ * \brief   Received PGN and the method which handles it
+ */
+typedef struct tN2kDispatchEntry
+{
+  /// received PGN
+  unsigned long pgn;
+  /// method which decodes the PGN
+  tN2kReceiveFunction receive;
+} tN2kDispatchEntry;
+
+/// Dispatch table of all received PGNs
+extern const tN2kDispatchEntry n2kDispatch[N2K_RX_DISPATCH_SIZE];
+
+/*! ************************************************************************
+ * \class N2kReceiver
+ * \brief Receives the PGNs of the dispatch table in its own task
+ *
+ * The acceptance filter of the CAN controller is set to the PGNs of
+ * \ref n2kDispatch and the network management PGNs the library needs
+ * (ISO request, address claim, transport protocol, group function). All
+ * other frames are rejected by the hardware and do not cost any CPU time.
+ *
+ * The message handler of the library runs in the N2K task. It only
+ * copies the messages of the dispatch table into a queue, they are
+ * decoded in the RX task by \ref processQueue. ISO requests for the own
+ * PGNs are answered by the scheduler with the next tick.
+ */
+class N2kReceiver
+{
+public:
+  /*! ************************************************************************
+   * \brief Constructor for the N2kReceiver
+   *
+   * \param driver      CAN driver with the acceptance filter
+   * \param scheduler   scheduler which answers the ISO requests
+   */
+  N2kReceiver(N2kCanDriver &driver, N2kScheduler &scheduler);
+
+  /*! ************************************************************************
+   * \brief Set the acceptance filter and register the handlers
+   *
+   * Has to be called in the setup before \ref setupN2K opens the bus.
+   */
+  void begin();
+
+  /*! ************************************************************************
+   * \brief Wait for a received message and decode it (RX task only)
+   *
+   * \param timeout   max time to wait in ticks
+   */
+  void processQueue(TickType_t timeout);
+
+  /*! ************************************************************************
+   * \brief Get a copy of the received data
+   * \return received data
+   */
+  tN2kReceivedData getData();
+
+  /*! ************************************************************************
+   * \brief Print the received data and the dispatch counters to the terminal
+   */
+  void printLog();
+
+private:
+  /// CAN driver with the acceptance filter
+  N2kCanDriver &driver;
+  /// scheduler which answers the ISO requests
+  N2kScheduler &scheduler;
+
+  /// messages waiting for the RX task
+  QueueHandle_t msgQueue = NULL;
+  /// mutex to protect the received data
+  SemaphoreHandle_t xMutexData = NULL;
+  /// data received from other devices
+  tN2kReceivedData data;
+
+  /// messages handed over to the RX task per dispatch entry
+  uint32_t dispatchCount[N2K_RX_DISPATCH_SIZE] = {0};
+  /// messages dropped because the queue was full
+  uint32_t dropCount = 0;
+  /// ISO requests answered by the scheduler
+  uint32_t requestCount = 0;
+
+  /// receiver the library callbacks are forwarded to
+  static N2kReceiver *receiver;
+
+  /*! ************************************************************************
+   * \brief Message handler of the library (N2K task)
+   * \param msg   received message
+   */
+  static void handleMsg(const tN2kMsg &msg);
+
+  /*! ************************************************************************
+   * \brief ISO request handler of the library (N2K task)
+   *
+   * The signature is given by the library. The requester and the device
+   * index are not needed, the PGN is sent as broadcast.
+   *
+   * \param pgn   requested PGN
+   * \return true if the PGN is sent by the scheduler or the alert manager
+   */
+  static bool handleIsoRequest(unsigned long pgn, unsigned char, int);
+};
+
+#endif // N2K_RECEIVE_H
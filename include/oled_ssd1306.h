@@ -0,0 +1,322 @@
+// Doxygen Documentation
+/*! \file 	oled_ssd1306.h
+ *  \brief  128x64 OLED with SSD1306 or SH1106 controller on I2C
+ *
+ * This File contains all the necessary methods to draw bitmaps and the
+ * character grid of the LCD Panel on a 128x64 OLED. Everything is drawn
+ * into a frame buffer, only the changed tiles of 8x8 pixels are sent.
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         ESP32-WROOM
+ * - Hardware:          az-delivery-devkit-v4
+ */
+
+#ifndef OLED_SSD1306_H
+#define OLED_SSD1306_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <display_backend.h>
+
+/// Controller SSD1306 (128 columns of RAM)
+#define OLED_SSD1306 1306
+/// Controller SH1106 (132 columns of RAM, the panel starts at column 2)
+#define OLED_SH1106 1106
+
+/// I2C address of the OLED
+#ifndef OLED_I2C_ADDRESS
+#define OLED_I2C_ADDRESS 0x3C
+#endif // OLED_I2C_ADDRESS
+
+/// I2C clock of the OLED in Hz (SSD1306 and SH1106: max 400 kHz)
+#define OLED_I2C_CLOCK 400000
+
+/// Width of the OLED in pixels
+#define OLED_WIDTH 128
+/// Number of pages of 8 pixel rows
+#define OLED_PAGES 8
+/// Width of a tile in pixels (height is one page)
+#define OLED_TILE_WIDTH 8
+/// Number of tiles of a page
+#define OLED_TILES (OLED_WIDTH / OLED_TILE_WIDTH)
+
+/// Number of character rows
+#define OLED_ROWS 4
+/// Number of character columns
+#define OLED_COLS 20
+/// Width of a character cell (5 columns and a gap)
+#define OLED_CHAR_WIDTH 6
+/// Columns of a character
+#define OLED_FONT_WIDTH 5
+/// Pages of a character cell (8 rows drawn twice as high)
+#define OLED_PAGES_PER_ROW 2
+/// First pixel column of the grid (20 cells = 120 pixels, centered)
+#define OLED_GRID_X ((OLED_WIDTH - OLED_COLS * OLED_CHAR_WIDTH) / 2)
+
+/// Column offset of the RAM of the SH1106
+#define OLED_SH1106_COLUMN_OFFSET 2
+/// Max data bytes of one I2C transaction (Wire buffer, 15 tiles)
+#define OLED_I2C_DATA_CHUNK 120
+/// I2C bytes to set the position (address, control, page, column low and high)
+#define OLED_POSITION_BYTES 5
+
+/// I2C control byte: commands follow
+#define OLED_CONTROL_COMMAND 0x00
+/// I2C control byte: data follows
+#define OLED_CONTROL_DATA 0x40
+/// Command: display off
+#define OLED_CMD_DISPLAY_OFF 0xAE
+/// Command: display on
+#define OLED_CMD_DISPLAY_ON 0xAF
+/// Command: set the contrast (one parameter)
+#define OLED_CMD_CONTRAST 0x81
+/// Command: set the page address (page mode)
+#define OLED_CMD_PAGE 0xB0
+/// Command: lower nibble of the column address
+#define OLED_CMD_COLUMN_LOW 0x00
+/// Command: upper nibble of the column address
+#define OLED_CMD_COLUMN_HIGH 0x10
+
+/// Max pixel offset of a cell in its tile (the cells start at even columns)
+#define OLED_CELL_MAX_OFFSET (OLED_TILE_WIDTH - 2)
+/// Tiles of a run of len characters of one row at the worst start column
+#define OLED_RUN_TILES_UNCAPPED(len) \
+  ((OLED_CELL_MAX_OFFSET + OLED_CHAR_WIDTH * (len) + OLED_TILE_WIDTH - 1) / OLED_TILE_WIDTH)
+/// Max number of tiles written for a run of len characters of one row (max one page)
+#define OLED_RUN_TILES(len) \
+  ((OLED_RUN_TILES_UNCAPPED(len) > OLED_TILES) ? OLED_TILES : OLED_RUN_TILES_UNCAPPED(len))
+/// Max I2C bytes of a run of len characters (2 pages with position and data)
+#define OLED_RUN_BYTES(len) \
+  (OLED_PAGES_PER_ROW * (OLED_POSITION_BYTES + OLED_RUN_TILES(len) * OLED_TILE_WIDTH + \
+                         2 * ((OLED_RUN_TILES(len) * OLED_TILE_WIDTH + OLED_I2C_DATA_CHUNK - 1) / OLED_I2C_DATA_CHUNK)))
+
+/*! ************************************************************************
+ * \class OledSsd1306
+ * \brief Character grid of 20x4 on a 128x64 OLED
+ *
+ * The OLED shows the same grid as the LCD, so all pages of DisplayData
+ * are shown without a change: each character cell is 6x16 pixels, the
+ * 5x7 font and the 5x8 user glyphs are drawn twice as high. The bars of
+ * the trend page and the segments of the big digits are drawn by
+ * DisplayData with \ref fillRect over blank cells.
+ *
+ * The cells are one user of \ref drawBitmap, graphs and bigger fonts
+ * are drawn with \ref drawBitmap and \ref fillRect into the same frame
+ * buffer of 8 pages with 128 columns. A byte which changes marks its
+ * tile (8 columns of one page) as dirty. \ref endUpdate sends each run of dirty tiles of a page with
+ * one position command and one data transaction, the rest of the OLED
+ * is not sent again. A change of one digit sends 2 or 4 tiles.
+ *
+ * The controller is written in the page addressing mode, which both the
+ * SSD1306 and the SH1106 support. The SH1106 has 132 columns of RAM, the
+ * panel starts at column 2.
+ *
+ * Usage:
+ * \code
+ * OledSsd1306 oled(OLED_I2C_ADDRESS, OLED_SH1106);
+ * oled.begin(20, 4, WireI2C);
+ * oled.writeAt(0, 3, (const uint8_t *)"Hello", 5);
+ * oled.fillRect(0, 60, 128, 4, true);
+ * oled.endUpdate();
+ * \endcode
+ */
+class OledSsd1306 : public DisplayBackend
+{
+public:
+  /*! ************************************************************************
+   * \brief Constructor for OledSsd1306
+   * \param address      I2C address of the OLED
+   * \param controller   \ref OLED_SSD1306 or \ref OLED_SH1106
+   */
+  OledSsd1306(uint8_t address, uint16_t controller);
+
+  /*! ************************************************************************
+   * \brief Initialise the controller and clear the OLED
+   *
+   * \param cols    number of columns (max \ref OLED_COLS)
+   * \param rows    number of rows (max \ref OLED_ROWS)
+   * \param wire    I2C bus (already started)
+   */
+  void begin(uint8_t cols, uint8_t rows, TwoWire &wire) override;
+
+  /*! ************************************************************************
+   * \brief Set the contrast
+   * \param brightness   0 = OLED off, contrast otherwise
+   */
+  void setBacklight(uint8_t brightness) override;
+
+  /*! ************************************************************************
+   * \brief Draw characters at the cursor position
+   *
+   * \param buf   characters
+   * \param len   number of characters
+   */
+  void write(const uint8_t *buf, size_t len) override;
+
+  /*! ************************************************************************
+   * \brief Move the cursor and draw characters
+   *
+   * \param col   column
+   * \param row   row
+   * \param buf   characters
+   * \param len   number of characters
+   */
+  void writeAt(uint8_t col, uint8_t row, const uint8_t *buf, size_t len) override;
+
+  /*! ************************************************************************
+   * \brief Define a user glyph and draw the characters which show it again
+   *
+   * \param location   number of the glyph (0..7)
+   * \param charmap    8 rows of the glyph (5 bits each)
+   */
+  void createChar(uint8_t location, const uint8_t charmap[8]) override;
+
+  /*! ************************************************************************
+   * \brief Get the width of the OLED in pixels
+   * \return \ref OLED_WIDTH
+   */
+  uint8_t getPixelWidth() const override { return OLED_WIDTH; }
+
+  /*! ************************************************************************
+   * \brief Get the height of the OLED in pixels
+   * \return 8 pixels per page
+   */
+  uint8_t getPixelHeight() const override { return OLED_PAGES * 8; }
+
+  /*! ************************************************************************
+   * \brief Draw a bitmap into the frame buffer
+   *
+   * \param x        left pixel column
+   * \param y        top pixel row
+   * \param width    width in pixels
+   * \param height   height in pixels
+   * \param bitmap   (height + 7) / 8 bands of width bytes, LSB = top
+   */
+  void drawBitmap(uint8_t x, uint8_t y, uint8_t width, uint8_t height, const uint8_t *bitmap) override;
+
+  /*! ************************************************************************
+   * \brief Set or clear the pixels of a rectangle in the frame buffer
+   *
+   * \param x        left pixel column
+   * \param y        top pixel row
+   * \param width    width in pixels
+   * \param height   height in pixels
+   * \param on       true = pixels on, false = pixels off
+   */
+  void fillRect(uint8_t x, uint8_t y, uint8_t width, uint8_t height, bool on) override;
+
+  /*! ************************************************************************
+   * \brief Send the dirty tiles of the frame buffer
+   */
+  void endUpdate() override;
+
+  /*! ************************************************************************
+   * \brief Get the max I2C clock of the OLED
+   * \return \ref OLED_I2C_CLOCK
+   */
+  uint32_t getI2cClock() const override { return OLED_I2C_CLOCK; }
+
+  /*! ************************************************************************
+   * \brief Get the number of I2C bytes sent (incl. address bytes)
+   * \return number of I2C bytes
+   */
+  uint32_t getI2cByteCount() const override { return i2cByteCount; }
+
+  /*! ************************************************************************
+   * \brief Get the number of I2C transactions
+   * \return number of I2C transactions
+   */
+  uint32_t getI2cTransactionCount() const override { return i2cTransactionCount; }
+
+  /*! ************************************************************************
+   * \brief Get the number of failed I2C transactions
+   * \return number of I2C transactions which have not been acknowledged
+   */
+  uint32_t getI2cErrorCount() const override { return i2cErrorCount; }
+
+private:
+  /// I2C bus of the OLED
+  TwoWire *wire = NULL;
+  /// I2C address of the OLED
+  uint8_t address;
+  /// controller (\ref OLED_SSD1306 or \ref OLED_SH1106)
+  uint16_t controller;
+  /// number of character rows
+  uint8_t rows = OLED_ROWS;
+  /// number of character columns
+  uint8_t cols = OLED_COLS;
+  /// column of the cursor
+  uint8_t cursorCol = 0;
+  /// row of the cursor
+  uint8_t cursorRow = 0;
+  /// characters shown
+  uint8_t cells[OLED_ROWS][OLED_COLS];
+  /// user glyphs (8 rows of 5 bits)
+  uint8_t glyphs[8][8];
+  /// frame buffer, one byte are 8 pixels of a column (LSB = top)
+  uint8_t frame[OLED_PAGES][OLED_WIDTH];
+  /// changed tiles of each page (bit n = tile n)
+  uint16_t dirtyTiles[OLED_PAGES];
+  /// I2C bytes sent
+  uint32_t i2cByteCount = 0;
+  /// I2C transactions
+  uint32_t i2cTransactionCount = 0;
+  /// I2C transactions which have not been acknowledged
+  uint32_t i2cErrorCount = 0;
+
+  /*! ************************************************************************
+   * \brief Draw a character cell into the frame buffer
+   *
+   * \param col   column
+   * \param row   row
+   */
+  void drawCell(uint8_t col, uint8_t row);
+
+  /*! ************************************************************************
+   * \brief Get the pixel columns of a character
+   *
+   * \param c         character (user glyph, ASCII or full block)
+   * \param columns   \ref OLED_FONT_WIDTH columns, LSB = top
+   */
+  void getCharColumns(uint8_t c, uint8_t columns[OLED_FONT_WIDTH]) const;
+
+  /*! ************************************************************************
+   * \brief Set a byte of the frame buffer and mark its tile if it has changed
+   *
+   * \param page    page
+   * \param x       pixel column
+   * \param value   8 pixels, LSB = top
+   */
+  void setFrameByte(uint8_t page, uint8_t x, uint8_t value);
+
+  /*! ************************************************************************
+   * \brief Set some pixels of a byte of the frame buffer
+   *
+   * \param page    page
+   * \param x       pixel column
+   * \param mask    pixels to set, LSB = top
+   * \param bits    new value of these pixels
+   */
+  void mergeFrameByte(uint8_t page, uint8_t x, uint8_t mask, uint8_t bits);
+
+  /*! ************************************************************************
+   * \brief Send commands with one I2C transaction
+   *
+   * \param commands   commands and their parameters
+   * \param len        number of bytes
+   */
+  void sendCommands(const uint8_t *commands, size_t len);
+
+  /*! ************************************************************************
+   * \brief Send a run of the frame buffer of one page
+   *
+   * \param page   page
+   * \param x      first pixel column
+   * \param len    number of columns
+   */
+  void sendData(uint8_t page, uint8_t x, uint8_t len);
+};
+
+#endif // OLED_SSD1306_H
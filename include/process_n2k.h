@@ -15,52 +15,102 @@
 #define PROCESS_N2K_H
 
 #include <Arduino.h>
+#include <atomic>
 #include <versionInfo.h>
 #include <hardwareDef.h>
 #include <NMEA2000.h>
 #include <N2kMessages.h>
+#include <n2k_msg_cache.h>
+#include <n2k_rate_control.h>
 
-/// NMEA2000 Object from <NMEA2000_CAN.h>
+/// NMEA2000 Object with the event driven CAN driver (main.cpp)
 extern tNMEA2000 &NMEA2000;
-/// Mutex for protecting data integrity of \ref VolvoDataForN2k
-extern SemaphoreHandle_t xMutexVolvoN2kData;
+
+/// N2K instance of the engine
+#define N2K_ENGINE_INSTANCE 0
+/// N2K instance of the Balmar alternator (sent as engine data)
+#define N2K_ALTERNATOR1_INSTANCE 1
+/// N2K instance of the prop shaft speed (sent as engine data)
+#define N2K_SHAFT_INSTANCE 2
+/// N2K instance of the second alternator (sent as engine data)
+#define N2K_ALTERNATOR2_INSTANCE 3
+/// N2K DC connection number of the starter battery (PGN 127751)
+#define N2K_DC_BATTERY_INSTANCE 0
+/// N2K DC connection number of MCP3204 channel 1, channel 2..4 follow (PGN 127751)
+#define N2K_DC_MCP3204_INSTANCE 1
+/// N2K instance of the switch bank with the contacts (PGN 127501)
+#define N2K_SWITCH_BANK_INSTANCE 0
+/// Number of contacts in the switch bank
+#define N2K_SWITCH_BANK_SIZE 3
 
 /// List of messages the device will transmit.
-const unsigned long TransmitMessages[] PROGMEM={127493L,127489L,127488L,130316L,0};
+const unsigned long TransmitMessages[] PROGMEM={127493L,127489L,127488L,127501L,127751L,130316L,126983L,126985L,0};
+
+/// N2K resolution of engine and shaft speeds in rpm
+#define N2K_RES_SPEED 0.25
+/// N2K resolution of pressures in Pa
+#define N2K_RES_PRESSURE 100.0
+/// N2K resolution of oil temperatures in K
+#define N2K_RES_OIL_TEMP 0.1
+/// N2K resolution of the coolant temperature in K
+#define N2K_RES_COOLANT_TEMP 0.01
+/// N2K resolution of the temperature extended range in K
+#define N2K_RES_TEMP_EXT 0.001
+/// N2K resolution of voltages in V
+#define N2K_RES_VOLTAGE 0.01
+/// N2K resolution of the DC voltages in V (PGN 127751)
+#define N2K_RES_DC_VOLTAGE 0.1
+/// N2K resolution of the engine hours in s
+#define N2K_RES_SECONDS 1.0
 
 /*! ************************************************************************
  * \struct  VolvoPentaData
  * \brief   Structure contains all data ready to be send to N2K bus
  *
  * The data in this struct has been collected and converted (units etc...)
- * to be directly used inside the N2K functions.
+ * to be directly used inside the N2K functions. All values are scaled
+ * integers in the resolution of the N2K field they are sent in, so the
+ * conversion is done once at publish time and the encoders just copy
+ * the bytes.
  */
 typedef struct VolvoPentaData{
 
-  /// engine coolant temperature in kelvin
-  double engine_coolant_temperature = 0;
-  /// engine coolant temperature at the pipe in kelvin
-  double engine_coolant_temperature_wall = 0;
-  /// engine oel pressure in Pascal
-  double engine_oel_pressure = 0;
-  /// voltage of the starter batterie in volt
-  double battery_voltage = 0;
-  /// Alternator 1 temperature in kelvin
-  double alternator1_temperature = 0;
-  /// exhaust gas temperature in kelvin
-  double exhaust_temperature = 0;
-  /// gearbox temperature in kelvin
-  double gearbox_temperature = 0;
-  /// engine speed in rev per minute
-  double engine_speed = 0;
-  /// prop shaft speed in rev per minute
-  double shaft_speed = 0;
-  /// alternator 1 speed in rev per minute
-  double alternator1_speed = 0;
-  /// alternator 2 speed in rev per minute
-  double alternator2_speed = 0;
   /// engine hours run in seconds
-  double engine_seconds = 0;
+  uint32_t engine_seconds = 0;
+  /// engine coolant temperature at the pipe in 0.001 kelvin (PGN 130316)
+  uint32_t engine_coolant_temperature_wall = 0;
+  /// exhaust gas temperature in 0.001 kelvin (PGN 130316)
+  uint32_t exhaust_temperature = 0;
+  /// engine coolant temperature in 0.01 kelvin
+  uint16_t engine_coolant_temperature = 0;
+  /// Alternator 1 temperature in 0.01 kelvin (sent as coolant temperature)
+  uint16_t alternator1_temperature = 0;
+  /// gearbox temperature in 0.1 kelvin (PGN 127493)
+  uint16_t gearbox_temperature = 0;
+  /// engine oel pressure in 100 Pascal
+  uint16_t engine_oel_pressure = 0;
+  /// voltage of the starter batterie in 0.01 volt (PGN 127489)
+  int16_t battery_voltage = 0;
+  /// voltage of the starter batterie in 0.1 volt (PGN 127751)
+  uint16_t battery_dc_voltage = 0;
+  /// voltage of MCP3204 channel 1 in 0.1 volt
+  uint16_t mcp3204_ch1_voltage = 0;
+  /// voltage of MCP3204 channel 2 in 0.1 volt
+  uint16_t mcp3204_ch2_voltage = 0;
+  /// voltage of MCP3204 channel 3 in 0.1 volt
+  uint16_t mcp3204_ch3_voltage = 0;
+  /// voltage of MCP3204 channel 4 in 0.1 volt
+  uint16_t mcp3204_ch4_voltage = 0;
+  /// engine speed in 0.25 rev per minute
+  uint16_t engine_speed = 0;
+  /// prop shaft speed in 0.25 rev per minute
+  uint16_t shaft_speed = 0;
+  /// alternator 1 speed in 0.25 rev per minute
+  uint16_t alternator1_speed = 0;
+  /// alternator 2 speed in 0.25 rev per minute
+  uint16_t alternator2_speed = 0;
+  /// state of the contacts, bit 0 = contact 1 (PGN 127501)
+  uint8_t contacts = 0;
   /// engine status bits (1)
   tN2kEngineDiscreteStatus1 engineDiscreteStatus1;
   /// engine status bits (2)
@@ -70,6 +120,186 @@ typedef struct VolvoPentaData{
 
 }tVolvoPentaData;
 
+/// Out of range value of an unsigned 16 bit N2K field
+#define N2K_UINT16_OR 0xFFFE
+/// Out of range value of a signed 16 bit N2K field
+#define N2K_INT16_OR 0x7FFE
+/// Out of range value of an unsigned 32 bit N2K field
+#define N2K_UINT32_OR 0xFFFFFFFEUL
+/// Not available value of a signed 24 bit N2K field
+#define N2K_INT24_NA 0x7FFFFF
+/// Not available value of an unsigned 24 bit N2K field
+#define N2K_UINT24_NA 0xFFFFFFUL
+/// Out of range value of an unsigned 24 bit N2K field
+#define N2K_UINT24_OR 0xFFFFFEUL
+
+/*! ************************************************************************
+ * \brief Scale a value to an unsigned 16 bit N2K field
+ *
+ * The result is the same as the one of Add2ByteUDouble of the library.
+ *
+ * \param value        physical value, NaN or N2kDoubleNA = not available
+ * \param resolution   resolution of the N2K field
+ * \return scaled value 0 .. 0xFFFD, N2kUInt16NA if not available,
+ *         \ref N2K_UINT16_OR if out of range
+ */
+uint16_t N2kScaleUInt16(double value, double resolution);
+
+/*! ************************************************************************
+ * \brief Scale a value to a signed 16 bit N2K field
+ *
+ * The result is the same as the one of Add2ByteDouble of the library.
+ *
+ * \param value        physical value, NaN or N2kDoubleNA = not available
+ * \param resolution   resolution of the N2K field
+ * \return scaled value -0x8000 .. 0x7FFD, N2kInt16NA if not available,
+ *         \ref N2K_INT16_OR if out of range
+ */
+int16_t N2kScaleInt16(double value, double resolution);
+
+/*! ************************************************************************
+ * \brief Scale a value to an unsigned 32 bit N2K field
+ *
+ * The result is the same as the one of Add4ByteUDouble of the library.
+ *
+ * \param value        physical value, NaN or N2kDoubleNA = not available
+ * \param resolution   resolution of the N2K field
+ * \return scaled value 0 .. 0xFFFFFFFD, N2kUInt32NA if not available,
+ *         \ref N2K_UINT32_OR if out of range
+ */
+uint32_t N2kScaleUInt32(double value, double resolution);
+
+/*! ************************************************************************
+ * \brief Scale a value to an unsigned 24 bit N2K field
+ *
+ * The result is the same as the one of Add3ByteUDouble of the library.
+ *
+ * \param value        physical value, NaN or N2kDoubleNA = not available
+ * \param resolution   resolution of the N2K field
+ * \return scaled value 0 .. 0xFFFFFD, \ref N2K_UINT24_NA if not
+ *         available, \ref N2K_UINT24_OR if out of range
+ */
+uint32_t N2kScaleUInt24(double value, double resolution);
+
+/// Number of buffers for the hand over of \ref tVolvoPentaData
+#define N2K_DATA_BUFFERS 3
+/// Flag in the ready index: buffer has been published and not consumed yet
+#define N2K_DATA_FRESH 0x80
+/// Mask of the buffer index in the ready index
+#define N2K_DATA_INDEX_MASK 0x03
+/// Max age of the data at transmission in milliseconds, older data is stale
+#define N2K_DATA_MAX_AGE_MS 1000
+
+/*! ************************************************************************
+ * \struct  tN2kDataSlot
+ * \brief   One buffer for the hand over of \ref tVolvoPentaData
+ */
+typedef struct tN2kDataSlot
+{
+  /// data ready to be send to N2K bus
+  tVolvoPentaData data;
+  /// number of the publication, 0 = never published
+  uint32_t sequence = 0;
+  /// time of the publication in milliseconds
+  uint32_t publishMs = 0;
+} tN2kDataSlot;
+
+/*! ************************************************************************
+ * \class N2kDataExchange
+ * \brief Hands over \ref tVolvoPentaData from the measuring tasks to N2K
+ *
+ * Triple buffer: the producers fill the back buffer and publish it by an
+ * atomic exchange with the ready index. The N2K task takes the ready
+ * buffer by an other atomic exchange as its front buffer and reads it
+ * without any lock. The producers never touch the front buffer, so it is
+ * consistent until the next \ref consume.
+ *
+ * The two measuring tasks are serialized by a writer mutex, the reader
+ * never waits for it. Publications, consumptions, reused and stale data
+ * are counted to verify that no old data is sent.
+ *
+ * Other readers (Signal K) get a copy of the last publication with
+ * \ref getSnapshot, it is taken under a spinlock by \ref publish.
+ */
+class N2kDataExchange
+{
+public:
+  /*! ************************************************************************
+   * \brief Create the writer mutex
+   *
+   * Has to be called in the setup before the tasks are started.
+   */
+  void begin();
+
+  /*! ************************************************************************
+   * \brief Get the back buffer to fill it
+   *
+   * The writer mutex is taken, \ref publish has to be called afterwards.
+   *
+   * \return pointer to the back buffer, NULL if the mutex is not available
+   */
+  tVolvoPentaData *beginWrite();
+
+  /*! ************************************************************************
+   * \brief Publish the back buffer and give back the writer mutex
+   */
+  void publish();
+
+  /*! ************************************************************************
+   * \brief Get the latest published data (N2K task only)
+   *
+   * If new data has been published it becomes the front buffer, otherwise
+   * the front buffer is used again.
+   *
+   * \return reference to the front buffer, valid until the next call
+   */
+  const tVolvoPentaData &consume();
+
+  /*! ************************************************************************
+   * \brief Copy the last published data (any task except the producers)
+   *
+   * \param data   copy of the data
+   * \return false if no data has been published yet
+   */
+  bool getSnapshot(tVolvoPentaData &data) const;
+
+  /*! ************************************************************************
+   * \brief Print the publish and consume counters to the terminal
+   */
+  void printLog() const;
+
+private:
+  /// all buffers
+  tN2kDataSlot slot[N2K_DATA_BUFFERS];
+  /// index of the back buffer (producers only)
+  uint8_t backIndex = 0;
+  /// index of the ready buffer with \ref N2K_DATA_FRESH flag (shared)
+  std::atomic<uint32_t> readyIndex{1};
+  /// index of the front buffer (N2K task only)
+  uint8_t frontIndex = 2;
+  /// mutex to serialize the producers
+  SemaphoreHandle_t xMutexWriter = NULL;
+  /// copy of the last publication for other readers
+  tN2kDataSlot snapshot;
+  /// lock of the snapshot
+  mutable portMUX_TYPE muxSnapshot = portMUX_INITIALIZER_UNLOCKED;
+
+  /// number of publications
+  uint32_t publishCount = 0;
+  /// number of consumed publications
+  uint32_t consumeCount = 0;
+  /// publications overwritten before they have been consumed
+  uint32_t overwriteCount = 0;
+  /// calls of \ref consume without new data
+  uint32_t reuseCount = 0;
+  /// calls of \ref consume with data older than \ref N2K_DATA_MAX_AGE_MS
+  uint32_t staleCount = 0;
+  /// max age of the data at \ref consume in milliseconds
+  uint32_t maxAgeMs = 0;
+  /// sequence of the last consumed publication
+  uint32_t lastSequence = 0;
+};
+
 /*! ************************************************************************
  * \brief Setup for the Nk2 Module
  * 
@@ -79,24 +309,328 @@ typedef struct VolvoPentaData{
  */
 void setupN2K();
 
+/// Tick of the N2K transmit scheduler in milliseconds
+#define N2K_SCHEDULER_TICK_MS 10
+
+/// Number of entries in the N2K transmit schedule
+#define N2K_SCHEDULE_SIZE 6
+
+/// Number of channels in the N2K channel map
+#define N2K_CHANNEL_COUNT 12
+
 /*! ************************************************************************
- * \brief Sends out all the messages in a fast timeframe
- * 
- * This method sends out all N2k Messages in a fast task \ref taskMeasureFast
- * which measures all fast signals and sends them out.
+ * \enum   tN2kCacheSlot
+ * \brief  Slots of the cache of encoded messages (PGN and instance)
+ */
+typedef enum
+{
+  /** PGN 127489 engine */
+  n2kCache_engineDynamic,
+  /** PGN 127489 alternator 1 */
+  n2kCache_alternator1Dynamic,
+  /** PGN 127493 gearbox */
+  n2kCache_transmission,
+
+  /** number of slots */
+  n2kCache_count
+} tN2kCacheSlot;
+
+/// Pointer to a method which encodes and sends one PGN
+typedef void (*tN2kSendFunction)(const tVolvoPentaData &data);
+
+/*! ************************************************************************
+ * \enum   tN2kFieldType
+ * \brief  Type of a scaled value in \ref tVolvoPentaData
+ */
+typedef enum
+{
+  /// unsigned 8 bit value, a bit field without not available
+  n2kField_UInt8,
+  /// unsigned 16 bit value
+  n2kField_UInt16,
+  /// signed 16 bit value
+  n2kField_Int16,
+  /// unsigned 32 bit value
+  n2kField_UInt32,
+  /// unsigned 24 bit value in an uint32_t
+  n2kField_UInt24
+} tN2kFieldType;
+
+/*! ************************************************************************
+ * \brief Read a scaled value of \ref tVolvoPentaData
+ *
+ * Used by the N2K channels and the Signal K paths, which both map the
+ * values of \ref tVolvoPentaData by their offset.
  *
+ * \param data     data in N2K resolution
+ * \param offset   offset of the value in \ref tVolvoPentaData
+ * \param type     type of the value
+ * \param value    raw value, an unsigned 32 bit value with its bits
+ * \return true if the value is valid, false if it is not available or
+ *         out of range (the codes of the N2K field are kept in \p value)
+ */
+bool ReadN2kField(const tVolvoPentaData &data, uint16_t offset, tN2kFieldType type, int32_t &value);
+
+/*! ************************************************************************
+ * \struct  tN2kChannel
+ * \brief   Mapping of one value of \ref tVolvoPentaData to a PGN
+ *
+ * The PGN defines the type of the value in \ref tVolvoPentaData:
+ * - 127488 engine speed: uint16_t in 0.25 rpm
+ * - 127501 binary switch bank: uint8_t, one bit per switch
+ * - 127751 DC voltage: uint16_t in 0.1 V
+ * - 130316 temperature extended range: int32_t in 0.001 K
+ *
+ * Each channel is sent as its own message with its own instance.
+ */
+typedef struct tN2kChannel
+{
+  /// PGN the value is sent with
+  unsigned long pgn;
+  /// instance (engine, DC connection, switch bank, temperature)
+  uint8_t instance;
+  /// temperature source (130316) or number of switches (127501)
+  uint8_t param;
+  /// offset of the value in \ref tVolvoPentaData
+  uint16_t offset;
+} tN2kChannel;
+
+/// Mapping of the acquired values to the PGNs
+extern const tN2kChannel n2kChannels[N2K_CHANNEL_COUNT];
+
+/*! ************************************************************************
+ * \struct  tN2kScheduleEntry
+ * \brief   Transmit schedule of one PGN
+ *
+ * The phase shifts the first transmission of the PGN, so PGNs with the
+ * same period are not sent in the same scheduler tick. On a busy bus the
+ * period is stretched up to the max period (\ref N2kRateController). A
+ * max period equal to the period keeps the rate fixed.
+ */
+typedef struct tN2kScheduleEntry
+{
+  /// PGN that is sent by this entry
+  unsigned long pgn;
+  /// nominal transmit period in milliseconds
+  uint16_t periodMs;
+  /// max transmit period on a busy bus in milliseconds
+  uint16_t maxPeriodMs;
+  /// offset of the first transmission in milliseconds
+  uint16_t phaseMs;
+  /// method which encodes and sends the PGN, NULL = the channels of the
+  /// PGN in \ref n2kChannels (\ref SendN2kChannels)
+  tN2kSendFunction send;
+} tN2kScheduleEntry;
+
+/*! ************************************************************************
+ * \struct  tN2kTxTiming
+ * \brief   Logged transmit timing of one PGN
+ */
+typedef struct tN2kTxTiming
+{
+  /// number of transmissions
+  uint32_t count = 0;
+  /// timestamp of the last transmission in milliseconds
+  uint32_t lastSendMs = 0;
+  /// last interval in between two transmissions in milliseconds
+  uint32_t lastIntervalMs = 0;
+  /// min interval in between two transmissions in milliseconds
+  uint32_t minIntervalMs = 0xFFFFFFFF;
+  /// max interval in between two transmissions in milliseconds
+  uint32_t maxIntervalMs = 0;
+  /// max duration to encode and send the PGN in microseconds
+  uint32_t maxDurationUs = 0;
+} tN2kTxTiming;
+
+/*! ************************************************************************
+ * \class N2kScheduler
+ * \brief Sends all PGNs at their own rate
+ *
+ * The scheduler runs in its own task \ref taskN2kTransmit and is
+ * decoupled from the measuring tasks. Every PGN has a period and a phase
+ * in the table \ref n2kSchedule, so each PGN is sent at its nominal rate
+ * and the bus load is spread over time. The timing of every transmission
+ * is logged and can be shown on the terminal ("n2k").
+ */
+class N2kScheduler
+{
+public:
+  /*! ************************************************************************
+   * \brief Constructor for the N2kScheduler
+   *
+   * \param exchange   hand over of the data ready for N2k sending
+   */
+  N2kScheduler(N2kDataExchange &exchange);
+
+  /*! ************************************************************************
+   * \brief Process one tick of the scheduler
+   *
+   * This method sends all PGNs which are due. It has to be called every
+   * \ref N2K_SCHEDULER_TICK_MS.
+   */
+  void processTick();
+
+  /*! ************************************************************************
+   * \brief Print the transmit timing log to the terminal
+   *
+   * Additionally the statistic of the message cache and the counters of
+   * the data hand over are printed.
+   */
+  void printTimingLog();
+
+  /*! ************************************************************************
+   * \brief Set the stretch of the periods
+   *
+   * \param stretch   0 (nominal periods) .. \ref N2K_RATE_STRETCH_MAX (max periods)
+   */
+  void setStretch(uint16_t stretch) { this->stretch = stretch; }
+
+  /*! ************************************************************************
+   * \brief Send a PGN of the schedule with the next tick (ISO request)
+   *
+   * Has to be called by the N2K task.
+   *
+   * \param pgn   requested PGN
+   * \return true if the PGN is in the schedule
+   */
+  bool requestSend(unsigned long pgn);
+
+  /*! ************************************************************************
+   * \brief Get the current period of a PGN of the schedule
+   *
+   * \param index   index in the table \ref n2kSchedule
+   * \return period in milliseconds
+   */
+  uint16_t getPeriod(uint8_t index) const;
+
+private:
+  /// hand over of the data ready for N2k sending
+  N2kDataExchange &exchange;
+  /// scheduler has been started
+  bool started = false;
+  /// stretch of the periods of the PGNs with a max period
+  uint16_t stretch = 0;
+  /// time in milliseconds when each PGN is due next
+  uint32_t nextDueMs[N2K_SCHEDULE_SIZE];
+  /// transmit timing of each PGN
+  tN2kTxTiming timing[N2K_SCHEDULE_SIZE];
+};
+
+/// Transmit schedule for all PGNs (period and phase in ms)
+extern const tN2kScheduleEntry n2kSchedule[N2K_SCHEDULE_SIZE];
+
+/*! ************************************************************************
+ * \brief Encode the engine parameters rapid update (PGN 127488)
+ *
+ * Same layout as SetN2kEngineParamRapid, boost pressure and tilt/trim 0.
+ *
+ * \param N2kMsg     message to encode
+ * \param instance   engine instance
+ * \param speed      engine speed in 0.25 rpm
+ */
+void SetN2kEngineRapidScaled(tN2kMsg &N2kMsg, uint8_t instance, uint16_t speed);
+
+/*! ************************************************************************
+ * \brief Encode the engine parameters dynamic (PGN 127489)
+ *
+ * Same layout as SetN2kEngineDynamicParam, oil temperature, fuel rate,
+ * coolant pressure, fuel pressure, load and torque are not available.
+ *
+ * \param N2kMsg        message to encode
+ * \param instance      engine instance
+ * \param oilPressure   oil pressure in 100 Pa
+ * \param coolantTemp   coolant temperature in 0.01 K
+ * \param voltage       alternator voltage in 0.01 V
+ * \param seconds       engine hours in s
+ * \param status1       discrete status 1
+ * \param status2       discrete status 2
+ */
+void SetN2kEngineDynamicScaled(tN2kMsg &N2kMsg, uint8_t instance, uint16_t oilPressure,
+                               uint16_t coolantTemp, int16_t voltage, uint32_t seconds,
+                               uint16_t status1, uint16_t status2);
+
+/*! ************************************************************************
+ * \brief Encode the transmission parameters dynamic (PGN 127493)
+ *
+ * Same layout as SetN2kPGN127493 with gear unknown and no oil pressure.
+ *
+ * \param N2kMsg     message to encode
+ * \param instance   engine instance
+ * \param oilTemp    transmission oil temperature in 0.1 K
+ */
+void SetN2kTransmissionScaled(tN2kMsg &N2kMsg, uint8_t instance, uint16_t oilTemp);
+
+/*! ************************************************************************
+ * \brief Encode the temperature extended range (PGN 130316)
+ *
+ * Same layout as SetN2kTemperatureExt without set temperature.
+ *
+ * \param N2kMsg       message to encode
+ * \param sid          sequence id
+ * \param instance     temperature instance
+ * \param source       temperature source
+ * \param temperature  actual temperature in 0.001 K
+ */
+void SetN2kTemperatureExtScaled(tN2kMsg &N2kMsg, uint8_t sid, uint8_t instance,
+                                tN2kTempSource source, uint32_t temperature);
+
+/*! ************************************************************************
+ * \brief Encode the DC voltage (PGN 127751)
+ *
+ * The current is not available.
+ *
+ * \param N2kMsg       message to encode
+ * \param sid          sequence id
+ * \param connection   DC connection number
+ * \param voltage      voltage in 0.1 V (\ref N2K_RES_DC_VOLTAGE)
+ */
+void SetN2kDCVoltageScaled(tN2kMsg &N2kMsg, uint8_t sid, uint8_t connection, uint16_t voltage);
+
+/*! ************************************************************************
+ * \brief Encode the binary switch bank status (PGN 127501)
+ *
+ * The switches above the count are sent as unavailable.
+ *
+ * \param N2kMsg     message to encode
+ * \param instance   switch bank instance
+ * \param states     state of the switches, bit 0 = switch 1
+ * \param count      number of switches (max 8)
+ */
+void SetN2kSwitchBankScaled(tN2kMsg &N2kMsg, uint8_t instance, uint8_t states, uint8_t count);
+
+/*! ************************************************************************
+ * \brief Compare the scaled encoders with the encoders of the library
+ *
+ * A set of test values is encoded by both ways and the bytes of the
+ * messages are compared. The result is printed to the terminal
+ * ("n2k check").
+ *
+ * \return true if all messages are equal
+ */
+bool CheckN2kScaledEncoders();
+
+/*! ************************************************************************
+ * \brief Sends all channels of a PGN of the table \ref n2kChannels
+ *
+ * \param pgn  PGN to send
  * \param data contains all measured engine data
  */
-void SendN2kEngineParmFast(VolvoPentaData *data);
+void SendN2kChannels(unsigned long pgn, const tVolvoPentaData &data);
 
 /*! ************************************************************************
- * \brief Sends out all the messages in a slow timeframe
- * 
- * This method sends out all N2k Messages in a slow task which measures
- * all Onewire Sensors  in \ref taskMeasureOneWire
+ * \brief Sends the engine parameters dynamic (PGN 127489)
+ *
+ * Engine data (instance 0) and Balmar alternator data (instance 1)
+ *
+ * \param data contains all measured engine data
+ */
+void SendN2kEngineDynamic(const tVolvoPentaData &data);
+
+/*! ************************************************************************
+ * \brief Sends the transmission parameters dynamic (PGN 127493)
  *
  * \param data contains all measured engine data
  */
-void SendN2kEngineParmSlow(VolvoPentaData *data);
+void SendN2kTransmission(const tVolvoPentaData &data);
 
 #endif // PROCESS_N2K_H
\ No newline at end of file
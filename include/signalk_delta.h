@@ -0,0 +1,256 @@
+// Doxygen Documentation
+/*! \file 	signalk_delta.h
+ *  \brief  Signal K deltas of the measured engine data
+ *
+ * This File contains all the necessary methods to serialise the measured
+ * engine data into Signal K delta messages (JSON) in a fixed buffer
+ * without any heap allocation. Only the changed paths are sent to the
+ * serial terminal and, when enabled, as UDP broadcast.
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         ESP32-WROOM
+ * - Hardware:          az-delivery-devkit-v4
+ */
+
+#ifndef SIGNALK_DELTA_H
+#define SIGNALK_DELTA_H
+
+#include <Arduino.h>
+#include <process_n2k.h>
+#include <fixed_format.h>
+
+#ifdef SIGNALK_UDP_PORT
+#include <WiFi.h>
+#include <WiFiUdp.h>
+#endif // SIGNALK_UDP_PORT
+
+/// Number of paths in the Signal K table
+#define SIGNALK_PATH_COUNT 10
+/// Size of the buffer of one delta message in bytes
+#define SIGNALK_BUFFER_SIZE 1024
+/// Default period of the delta messages in milliseconds
+#define SIGNALK_DEFAULT_PERIOD_MS 1000
+/// Min period of the delta messages in milliseconds
+#define SIGNALK_MIN_PERIOD_MS 100
+/// Period in milliseconds after which all paths are sent again
+#define SIGNALK_FULL_PERIOD_MS 10000
+/// Label of the source in the delta messages
+#define SIGNALK_SOURCE_LABEL "volvo-penta-n2k"
+
+/// Last value of a path which has been sent as null
+#define SIGNALK_VALUE_NULL INT32_MIN
+
+/*! ************************************************************************
+ * \struct  tSignalKPath
+ * \brief   Mapping of one value of \ref tVolvoPentaData to a Signal K path
+ *
+ * The values of \ref tVolvoPentaData are already scaled integers. The
+ * resolution converts them into the SI unit of Signal K, the decimals are
+ * the resolution of the sent value. A path is sent again only when the
+ * value has changed in this resolution. A value which is not available
+ * or out of range is sent as null.
+ */
+typedef struct tSignalKPath
+{
+  /// Signal K path of the value
+  const char *path;
+  /// offset of the value in \ref tVolvoPentaData
+  uint16_t offset;
+  /// type of the value in \ref tVolvoPentaData
+  tN2kFieldType type;
+  /// resolution of the value in the SI unit of Signal K
+  double resolution;
+  /// number of decimals of the sent value
+  uint8_t decimals;
+} tSignalKPath;
+
+/// Mapping of the acquired values to the Signal K paths
+extern const tSignalKPath signalKPaths[SIGNALK_PATH_COUNT];
+
+/*! ************************************************************************
+ * \class SignalKWriter
+ * \brief Streaming writer of one Signal K delta message
+ *
+ * The message is written into a fixed buffer, the numbers are formatted
+ * from fixed point integers without floating point and without String:
+ *
+ * \code
+ * {"updates":[{"source":{"label":"volvo-penta-n2k"},"values":[
+ * {"path":"propulsion.port.revolutions","value":13.75}]}]}
+ * \endcode
+ *
+ * If the buffer is too small, the message is marked as overflowed and
+ * must not be sent.
+ */
+class SignalKWriter
+{
+public:
+  /*! ************************************************************************
+   * \brief Constructor for the SignalKWriter
+   *
+   * \param buffer   buffer of the message
+   * \param size     size of the buffer in bytes
+   */
+  SignalKWriter(char *buffer, size_t size) : buffer(buffer), size(size) {}
+
+  /*! ************************************************************************
+   * \brief Start a new delta message
+   */
+  void begin();
+
+  /*! ************************************************************************
+   * \brief Add one value to the delta message
+   *
+   * \param path       Signal K path
+   * \param value      value as fixed point integer
+   * \param decimals   number of decimals of the value
+   */
+  void addValue(const char *path, int32_t value, uint8_t decimals);
+
+  /*! ************************************************************************
+   * \brief Add a value which is not available to the delta message
+   * \param path   Signal K path
+   */
+  void addNull(const char *path);
+
+  /*! ************************************************************************
+   * \brief Finish the delta message with a line end
+   * \return length of the message, 0 if the buffer has overflowed
+   */
+  size_t end();
+
+  /*! ************************************************************************
+   * \brief Get the number of values in the message
+   * \return number of values
+   */
+  uint8_t getValueCount() const { return valueCount; }
+
+private:
+  /// buffer of the message
+  char *buffer;
+  /// size of the buffer in bytes
+  size_t size;
+  /// length of the message
+  size_t len = 0;
+  /// number of values in the message
+  uint8_t valueCount = 0;
+  /// the buffer has been too small
+  bool overflow = false;
+
+  /*! ************************************************************************
+   * \brief Append a string to the message
+   * \param text   string to append
+   */
+  void append(const char *text);
+
+  /*! ************************************************************************
+   * \brief Append a fixed point number to the message
+   *
+   * \param value      value as fixed point integer
+   * \param decimals   number of decimals of the value
+   */
+  void appendFixed(int32_t value, uint8_t decimals);
+};
+
+/*! ************************************************************************
+ * \class SignalKDelta
+ * \brief Sends the changed engine data as Signal K deltas
+ *
+ * With each period the snapshot of the data published for N2K is taken
+ * from \ref N2kDataExchange, so the values are consistent and the same
+ * as on the N2K bus. The values are compared with the
+ * last sent values in the resolution of their path, only the changed
+ * paths are written into the delta message. All paths are sent again
+ * every \ref SIGNALK_FULL_PERIOD_MS, so a server which has been started
+ * later gets all values.
+ *
+ * The message is written to the serial terminal (one delta per line) and,
+ * if the firmware is built with SIGNALK_UDP_PORT and the WiFi is
+ * connected, as UDP broadcast to this port.
+ */
+class SignalKDelta
+{
+public:
+  /*! ************************************************************************
+   * \brief Constructor for the SignalKDelta
+   * \param exchange   hand over of the data published for N2K
+   */
+  SignalKDelta(N2kDataExchange &exchange);
+
+  /*! ************************************************************************
+   * \brief Start or stop the delta messages
+   * \param enabled   true to send the delta messages
+   */
+  void setEnabled(bool enabled);
+
+  /*! ************************************************************************
+   * \brief Check if the delta messages are sent
+   * \return true if the delta messages are sent
+   */
+  bool isEnabled() const { return enabled; }
+
+  /*! ************************************************************************
+   * \brief Set the period of the delta messages
+   * \param periodMs   period in milliseconds (min \ref SIGNALK_MIN_PERIOD_MS)
+   */
+  void setPeriod(uint32_t periodMs);
+
+  /*! ************************************************************************
+   * \brief Send a delta message if the period has elapsed
+   *
+   * This method is non blocking and has to be called cyclically by the
+   * owner of the terminal.
+   */
+  void process();
+
+  /*! ************************************************************************
+   * \brief Print the counters of the delta messages to the terminal
+   */
+  void printLog() const;
+
+private:
+  /// hand over of the data published for N2K
+  N2kDataExchange &exchange;
+  /// delta messages are sent
+  volatile bool enabled = false;
+  /// period of the delta messages in milliseconds
+  uint32_t periodMs = SIGNALK_DEFAULT_PERIOD_MS;
+  /// time of the last delta message in milliseconds
+  uint32_t lastMs = 0;
+  /// time of the last delta message with all paths in milliseconds
+  uint32_t lastFullMs = 0;
+  /// all paths have to be sent with the next message
+  bool fullRequested = true;
+  /// last sent values as fixed point integers, \ref SIGNALK_VALUE_NULL for null
+  int32_t lastValue[SIGNALK_PATH_COUNT];
+  /// buffer of the delta message
+  char buffer[SIGNALK_BUFFER_SIZE];
+
+  /// sent delta messages
+  uint32_t messageCount = 0;
+  /// sent values
+  uint32_t valueCount = 0;
+  /// sent bytes
+  uint32_t byteCount = 0;
+  /// messages dropped because the buffer was too small
+  uint32_t overflowCount = 0;
+
+#ifdef SIGNALK_UDP_PORT
+  /// UDP socket for the broadcast
+  WiFiUDP udp;
+#endif // SIGNALK_UDP_PORT
+
+  /*! ************************************************************************
+   * \brief Read a value of the snapshot as fixed point integer
+   *
+   * \param path       mapping of the value
+   * \param snapshot   snapshot of the measured data
+   * \return value in the resolution of the path, \ref SIGNALK_VALUE_NULL
+   *         if it is not available or out of range
+   */
+  static int32_t readValue(const tSignalKPath &path, const tVolvoPentaData &snapshot);
+};
+
+#endif // SIGNALK_DELTA_H
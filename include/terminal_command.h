@@ -0,0 +1,119 @@
+// Doxygen Documentation
+/*! \file 	terminal_command.h
+ *  \brief  Interpretation of commands from the serial terminal
+ *
+ * This File contains all the necessary methods to read commands from
+ * the serial terminal (USB) and to dispatch them to the modules.
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         ESP32-WROOM
+ * - Hardware:          az-delivery-devkit-v4
+ */
+
+#ifndef TERMINAL_COMMAND_H
+#define TERMINAL_COMMAND_H
+
+#include <Arduino.h>
+#include <calibration_store.h>
+#include <process_n2k.h>
+#include <n2k_can_driver.h>
+#include <n2k_bus_monitor.h>
+#include <n2k_rate_control.h>
+#include <n2k_receive.h>
+#include <n2k_gateway.h>
+#include <n2k_alert.h>
+#include <signalk_delta.h>
+#include <display_data.h>
+
+/// max length of one command line from the terminal
+#define TERMINAL_CMD_MAX_LEN 160
+
+/// max time to wait for the self check of the LCD pages in milliseconds
+#define TERMINAL_LCD_CHECK_TIMEOUT_MS 1000
+
+/// arguments of the lcd command shown by the help
+#ifdef FIXED_FORMAT_BENCHMARK
+#define TERMINAL_LCD_ARGS "bench|check"
+#else
+#define TERMINAL_LCD_ARGS "check"
+#endif
+
+/*! ************************************************************************
+ * \class TerminalCommand
+ * \brief Reads and dispatches commands from the serial terminal
+ *
+ * The characters are collected in a fixed line buffer without any heap
+ * allocation. A command is executed when a line end is received. The
+ * first word selects the module, the rest of the line is passed to it.
+ */
+class TerminalCommand
+{
+public:
+  /*! ************************************************************************
+   * \brief Constructor for TerminalCommand
+   * \param calibration Reference to the CalibrationStore object
+   * \param n2kScheduler Reference to the N2kScheduler object
+   * \param n2kCanDriver Reference to the N2kCanDriver object
+   * \param n2kBusMonitor Reference to the N2kBusMonitor object
+   * \param n2kRateController Reference to the N2kRateController object
+   * \param n2kReceiver Reference to the N2kReceiver object
+   * \param n2kGateway Reference to the N2kGateway object
+   * \param n2kAlertManager Reference to the N2kAlertManager object
+   * \param signalKDelta Reference to the SignalKDelta object
+   * \param displayData Reference to the DisplayData object
+   */
+  TerminalCommand(CalibrationStore &calibration, N2kScheduler &n2kScheduler,
+                  N2kCanDriver &n2kCanDriver, N2kBusMonitor &n2kBusMonitor,
+                  N2kRateController &n2kRateController, N2kReceiver &n2kReceiver,
+                  N2kGateway &n2kGateway, N2kAlertManager &n2kAlertManager,
+                  SignalKDelta &signalKDelta, DisplayData &displayData);
+
+  /*! ************************************************************************
+   * \brief Process all characters available at the serial terminal
+   *
+   * This method is non blocking and has to be called cyclically.
+   *
+   * \return true   a command has been executed
+   * \return false  no complete command line available
+   */
+  bool processSerialInput();
+
+private:
+  /// Reference to the calibration store
+  CalibrationStore &calibration;
+  /// Reference to the N2K transmit scheduler
+  N2kScheduler &n2kScheduler;
+  /// Reference to the CAN driver of the NMEA2000 library
+  N2kCanDriver &n2kCanDriver;
+  /// Reference to the monitor of the NMEA2000 bus
+  N2kBusMonitor &n2kBusMonitor;
+  /// Reference to the controller of the transmit rate
+  N2kRateController &n2kRateController;
+  /// Reference to the receiver of the N2K messages of other devices
+  N2kReceiver &n2kReceiver;
+  /// Reference to the stream of all N2K frames
+  N2kGateway &n2kGateway;
+  /// Reference to the N2K alerts of the engine alarms
+  N2kAlertManager &n2kAlertManager;
+  /// Reference to the Signal K deltas
+  SignalKDelta &signalKDelta;
+  /// Reference to the LCD Panel
+  DisplayData &displayData;
+
+  /// Buffer for the current command line
+  char lineBuffer[TERMINAL_CMD_MAX_LEN + 1];
+  /// Number of characters in the line buffer
+  uint8_t lineLength = 0;
+  /// line exceeded the buffer and will be dropped
+  bool lineOverflow = false;
+
+  /*! ************************************************************************
+   * \brief Execute a complete command line
+   * \param line  command line (modified while parsing)
+   */
+  void executeCommand(char *line);
+};
+
+#endif // TERMINAL_COMMAND_H
@@ -0,0 +1,94 @@
+// Doxygen Documentation
+/*! \file 	trend_history.h
+ *  \brief  Downsampled history of a measured value
+ *
+ * This File contains all the necessary methods to keep the trend of a
+ * measured value for the last minutes. The samples are averaged into
+ * buckets incrementally, the history holds the bucket means only.
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         ESP32-WROOM
+ * - Hardware:          az-delivery-devkit-v4
+ */
+
+#ifndef TREND_HISTORY_H
+#define TREND_HISTORY_H
+
+#include <Arduino.h>
+
+/// Number of buckets of a trend (one column of the LCD Panel each)
+#define TREND_BUCKET_COUNT 20
+/// Time of one bucket in milliseconds (20 buckets = 5 minutes)
+#define TREND_BUCKET_MS 15000
+
+/*! ************************************************************************
+ * \class TrendHistory
+ * \brief Ring buffer of the bucket means of a measured value
+ *
+ * Each sample is added to the open bucket (sum and count). When the
+ * bucket time has elapsed, the mean is stored in the ring buffer and a
+ * new bucket is opened. The work per sample is constant, the history is
+ * never calculated from raw samples.
+ *
+ * The version is increased with each closed bucket, so a page only has
+ * to be rendered again when the version has changed.
+ */
+class TrendHistory
+{
+public:
+  /*! ************************************************************************
+   * \brief Add a sample to the open bucket
+   *
+   * \param value   measured value
+   * \param nowMs   current time in milliseconds
+   */
+  void addSample(float value, uint32_t nowMs);
+
+  /*! ************************************************************************
+   * \brief Get the number of closed buckets
+   * \return number of buckets (max \ref TREND_BUCKET_COUNT)
+   */
+  uint8_t getCount() const { return count; }
+
+  /*! ************************************************************************
+   * \brief Get the mean of a closed bucket
+   * \param age   0 = newest bucket, getCount() - 1 = oldest bucket
+   * \return mean of the bucket
+   */
+  float getBucket(uint8_t age) const;
+
+  /*! ************************************************************************
+   * \brief Get the min and max of all closed buckets
+   *
+   * \param min   min of the bucket means
+   * \param max   max of the bucket means
+   * \return false if there is no closed bucket
+   */
+  bool getRange(float &min, float &max) const;
+
+  /*! ************************************************************************
+   * \brief Get the version of the history
+   * \return number of closed buckets since the start
+   */
+  uint32_t getVersion() const { return version; }
+
+private:
+  /// bucket means, ring buffer
+  float bucket[TREND_BUCKET_COUNT];
+  /// index of the next bucket to write
+  uint8_t head = 0;
+  /// number of closed buckets
+  uint8_t count = 0;
+  /// sum of the samples of the open bucket
+  float sum = 0;
+  /// number of samples of the open bucket
+  uint16_t samples = 0;
+  /// start time of the open bucket in milliseconds
+  uint32_t startMs = 0;
+  /// number of closed buckets since the start
+  uint32_t version = 0;
+};
+
+#endif // TREND_HISTORY_H
@@ -24,6 +24,8 @@ extern AcquireData data;
 extern LookUpTable1D mapTCO;
 extern LookUpTable1D mapPOIL;
 
+extern CalibrationStore calibration;
+
 //****************************************
 // Construct a new AcquireDataobject
 AcquireData::AcquireData()
@@ -155,10 +157,13 @@ void AcquireData::measureVoltage()
 {
   double voltage;
   int voltageMax;
+  // active calibration data (loaded from NVS at boot)
+  const tCalibrationData &cal = calibration.get();
+
   // measure ESP32 AD-Channel UBat
   voltage = analogRead(UBAT_ADC_PIN);
   voltage = ADC_CH36_LUT[(int)voltage];
-  voltage = voltage / 4096 * ACH_CH36_FACTOR + ACH_CH36_OFFSET;
+  voltage = voltage / 4096 * cal.adcCh36Factor + cal.adcCh36Offset;
 // Simulationsdata verwenden
 #ifdef USE_SIM_DATA
   voltage = SIM_DATA_UBAT_ADC_PIN;
@@ -168,7 +173,7 @@ void AcquireData::measureVoltage()
   // measure MCP3204 Channel 1
   voltageMax = mcp3204.maxValue();
   voltage = (double)mcp3204.analogRead(0);
-  voltage = voltage / voltageMax * MCP3204_VREF * MCP3204_CH1_FAC;
+  voltage = voltage / voltageMax * cal.mcp3204Vref * cal.mcp3204Factor[0];
 // Simulationsdata verwenden
 #ifdef USE_SIM_DATA
   voltage = SIM_DATA_MCP3201_CHN1;
@@ -177,7 +182,7 @@ void AcquireData::measureVoltage()
 
   // measure MCP3204 Channel 2
   voltage = (double)mcp3204.analogRead(1);
-  voltage = voltage / voltageMax * MCP3204_VREF * MCP3204_CH2_FAC;
+  voltage = voltage / voltageMax * cal.mcp3204Vref * cal.mcp3204Factor[1];
 // Simulationsdata verwenden
 #ifdef USE_SIM_DATA
   voltage = SIM_DATA_MCP3201_CHN2;
@@ -186,7 +191,7 @@ void AcquireData::measureVoltage()
 
   // measure MCP3204 Channel 3
   voltage = (double)mcp3204.analogRead(2);
-  voltage = voltage / voltageMax * MCP3204_VREF * MCP3204_CH3_FAC;
+  voltage = voltage / voltageMax * cal.mcp3204Vref * cal.mcp3204Factor[2];
 // Simulationsdata verwenden
 #ifdef USE_SIM_DATA
   voltage = SIM_DATA_MCP3201_CHN3;
@@ -195,7 +200,7 @@ void AcquireData::measureVoltage()
 
   // measure MCP3204 Channel 4
   voltage = (double)mcp3204.analogRead(3);
-  voltage = voltage / voltageMax * MCP3204_VREF * MCP3204_CH4_FAC;
+  voltage = voltage / voltageMax * cal.mcp3204Vref * cal.mcp3204Factor[3];
 // Simulationsdata verwenden
 #ifdef USE_SIM_DATA
   voltage = SIM_DATA_MCP3201_CHN4;
@@ -714,50 +719,48 @@ void AcquireData::measureSpeed()
 // Convert all measured data into N2kData formats
 void AcquireData::convertDataToN2k(tVolvoPentaData *n2kVolvoData)
 {
+  // scale once into the N2K resolution, the encoders only copy the bytes
+  n2kVolvoData->engine_seconds = N2kScaleUInt32(this->engSecond.getValue(), N2K_RES_SECONDS);
 
-  // Check if the Semaphore used for Dataprotection is initialzed
-  if (xMutexVolvoN2kData != NULL)
-  {
-    // See if we can obtain the semaphore. If the semaphore is not
-    // available wait 5ms to see if it becomes free.
-    if (xSemaphoreTake(xMutexVolvoN2kData, (TickType_t)5) == pdTRUE)
-    {
+  n2kVolvoData->engine_coolant_temperature = N2kScaleUInt16(this->tEngine.getValue() + 273.15, N2K_RES_COOLANT_TEMP);
+  n2kVolvoData->engine_coolant_temperature_wall = N2kScaleUInt24(this->tSeaOutletWall.getValue() + 273.15, N2K_RES_TEMP_EXT);
+  n2kVolvoData->alternator1_temperature = N2kScaleUInt16(this->tAlternator.getValue() + 273.15, N2K_RES_COOLANT_TEMP);
+  n2kVolvoData->gearbox_temperature = N2kScaleUInt16(this->tGearbox.getValue() + 273.15, N2K_RES_OIL_TEMP);
+  n2kVolvoData->exhaust_temperature = N2kScaleUInt24(this->tExhaust.getValue() + 273.15, N2K_RES_TEMP_EXT);
 
-      n2kVolvoData->engine_seconds = this->engSecond.getValue();
+  n2kVolvoData->engine_oel_pressure = N2kScaleUInt16(this->pOil.getValue() * 100000, N2K_RES_PRESSURE); // bar to PA
 
-      n2kVolvoData->engine_coolant_temperature = this->tEngine.getValue() + 273.15;
-      n2kVolvoData->engine_coolant_temperature_wall = this->tSeaOutletWall.getValue() + 273.15;
-      n2kVolvoData->alternator1_temperature = this->tAlternator.getValue() + 273.15;
-      n2kVolvoData->gearbox_temperature = this->tGearbox.getValue() + 273.15;
-      n2kVolvoData->exhaust_temperature = this->tExhaust.getValue() + 273.15;
+  n2kVolvoData->engine_speed = N2kScaleUInt16(this->nMot.getValue(), N2K_RES_SPEED);
+  n2kVolvoData->shaft_speed = N2kScaleUInt16(this->nShaft.getValue(), N2K_RES_SPEED);
+  n2kVolvoData->alternator1_speed = N2kScaleUInt16(this->nAlternator1.getValue(), N2K_RES_SPEED);
+  n2kVolvoData->alternator2_speed = N2kScaleUInt16(this->nAlternator2.getValue(), N2K_RES_SPEED);
 
-      n2kVolvoData->engine_oel_pressure = this->pOil.getValue() * 100000; // bar to PA
+  n2kVolvoData->battery_voltage = N2kScaleInt16(this->uBat.getValue(), N2K_RES_VOLTAGE);
+  // the DC voltages are rounded once from the measured value
+  n2kVolvoData->battery_dc_voltage = N2kScaleUInt16(this->uBat.getValue(), N2K_RES_DC_VOLTAGE);
+  n2kVolvoData->mcp3204_ch1_voltage = N2kScaleUInt16(this->uMcp3204Ch1.getValue(), N2K_RES_DC_VOLTAGE);
+  n2kVolvoData->mcp3204_ch2_voltage = N2kScaleUInt16(this->uMcp3204Ch2.getValue(), N2K_RES_DC_VOLTAGE);
+  n2kVolvoData->mcp3204_ch3_voltage = N2kScaleUInt16(this->uMcp3204Ch3.getValue(), N2K_RES_DC_VOLTAGE);
+  n2kVolvoData->mcp3204_ch4_voltage = N2kScaleUInt16(this->uMcp3204Ch4.getValue(), N2K_RES_DC_VOLTAGE);
 
-      n2kVolvoData->engine_speed = this->nMot.getValue();
-      n2kVolvoData->shaft_speed = this->nShaft.getValue();
-      n2kVolvoData->alternator1_speed = this->nAlternator1.getValue();
-      n2kVolvoData->alternator2_speed = this->nAlternator2.getValue();
+  // contacts as switch bank, bit 0 = contact 1
+  n2kVolvoData->contacts = ((this->flgContact1.getValue() > 0.5) ? 0x01 : 0) |
+                           ((this->flgContact2.getValue() > 0.5) ? 0x02 : 0) |
+                           ((this->flgContact3.getValue() > 0.5) ? 0x04 : 0);
 
-      n2kVolvoData->battery_voltage = this->uBat.getValue();
+  // convert the engine status
+  n2kVolvoData->engineDiscreteStatus1.Bits.LowOilLevel = this->currentEngineDiscreteStatus.flgLowOilPressure.isFlagSet();
 
-      // convert the engine status
-      n2kVolvoData->engineDiscreteStatus1.Bits.LowOilLevel = this->currentEngineDiscreteStatus.flgLowOilPressure.isFlagSet();
+  n2kVolvoData->engineDiscreteStatus1.Bits.OverTemperature = this->currentEngineDiscreteStatus.flgHighCoolantTemp.isFlagSet();
 
-      n2kVolvoData->engineDiscreteStatus1.Bits.OverTemperature = this->currentEngineDiscreteStatus.flgHighCoolantTemp.isFlagSet();
-      
-      n2kVolvoData->engineDiscreteStatus1.Bits.EGRSystem = this->currentEngineDiscreteStatus.flgHighExhaustTemp.isFlagSet();
-      
-      n2kVolvoData->engineDiscreteStatus1.Bits.CheckEngine = this->currentEngineDiscreteStatus.flgHighGearboxTemp.isFlagSet();
+  n2kVolvoData->engineDiscreteStatus1.Bits.EGRSystem = this->currentEngineDiscreteStatus.flgHighExhaustTemp.isFlagSet();
 
-      n2kVolvoData->engineDiscreteStatus1.Bits.PreheatIndicator = this->currentEngineDiscreteStatus.flgHighSeaWaterTemp.isFlagSet();
+  n2kVolvoData->engineDiscreteStatus1.Bits.CheckEngine = this->currentEngineDiscreteStatus.flgHighGearboxTemp.isFlagSet();
 
-      // convert the alternator status
-      n2kVolvoData->alternatorDiscreteStatus1.Bits.OverTemperature = this->currentEngineDiscreteStatus.flgHighAlternatorTemp.isFlagSet();
+  n2kVolvoData->engineDiscreteStatus1.Bits.PreheatIndicator = this->currentEngineDiscreteStatus.flgHighSeaWaterTemp.isFlagSet();
 
-      // unlock the resource again
-      xSemaphoreGive(xMutexVolvoN2kData);
-    }
-  }
+  // convert the alternator status
+  n2kVolvoData->alternatorDiscreteStatus1.Bits.OverTemperature = this->currentEngineDiscreteStatus.flgHighAlternatorTemp.isFlagSet();
 }
 
 //==============================================================================
@@ -190,7 +190,6 @@ void ButtonInterpreter::triggerButtonAction(uint8_t buttonIndex, uint8_t current
 
       // Reset the backlight counter of the LCD Panel
       lcdDisplayObject.resetLcdBacklightCounter();
-      lcdDisplayObject.updateLcdBacklight();
     }
 
     // Action if button 1 is pressed long
@@ -252,7 +251,6 @@ void ButtonInterpreter::triggerButtonAction(uint8_t buttonIndex, uint8_t current
 
       // Reset the backlight counter of the LCD Panel
       lcdDisplayObject.resetLcdBacklightCounter();
-      lcdDisplayObject.updateLcdBacklight();
     }
 
     // Action if button 1 is pressed long
@@ -267,9 +265,26 @@ void ButtonInterpreter::triggerButtonAction(uint8_t buttonIndex, uint8_t current
         //   // do something
         //   break;
 
-        // case PAGE_ENGINE:
-        //   // do something
-        //   break;
+      case PAGE_ENGINE:
+
+        // show LCD panel page with the trend of the engine data
+        lcdDisplayObject.setLcdCurrentPage(PAGE_TREND);
+
+        break;
+
+      case PAGE_TREND:
+
+        // show the trend of the next value
+        lcdDisplayObject.nextTrendChannel();
+
+        break;
+
+      case PAGE_ALARM:
+
+        // show the next alarms of the list
+        lcdDisplayObject.scrollAlarmList();
+
+        break;
 
       case PAGE_TEMPERATURE:
 
@@ -278,9 +293,12 @@ void ButtonInterpreter::triggerButtonAction(uint8_t buttonIndex, uint8_t current
 
         break;
 
-        // case PAGE_VOLTAGE:
-        //   // do something
-        //   break;
+      case PAGE_VOLTAGE:
+
+        // show LCD panel page with the diagnostic of the N2K bus
+        lcdDisplayObject.setLcdCurrentPage(PAGE_N2K_BUS);
+
+        break;
 
         // case PAGE_SPEED:
         //   // do something
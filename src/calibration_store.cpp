@@ -0,0 +1,414 @@
+// Doxygen Documentation
+/*! \file 	calibration_store.cpp
+ *  \brief  Runtime calibration data stored in the NVS
+ *
+ * This File contains all the necessary methods to keep the calibration
+ * data (ADC factors and sensor maps) in the NVS of the ESP32. So a
+ * changed sender can be calibrated via the terminal without reflashing.
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         ESP32-WROOM
+ * - Hardware:          az-delivery-devkit-v4
+ */
+
+#include <calibration_store.h>
+#include <adc_calib.h>
+#include <rom/crc.h>
+#include <stddef.h>
+#include <errno.h>
+
+//****************************************
+// Construct a new CalibrationStore object
+CalibrationStore::CalibrationStore()
+{
+  setDefaults(this->activeData);
+  setDefaults(this->stagedData);
+}
+
+//****************************************
+// Fill calibration data with the compiled defaults
+void CalibrationStore::setDefaults(tCalibrationData &cal)
+{
+  uint8_t i;
+
+  memset(&cal, 0, sizeof(cal));
+  cal.magic = CALIB_MAGIC;
+  cal.version = CALIB_VERSION;
+  cal.size = sizeof(tCalibrationData);
+
+  cal.mcp3204Vref = MCP3204_VREF;
+  cal.mcp3204Factor[0] = MCP3204_CH1_FAC;
+  cal.mcp3204Factor[1] = MCP3204_CH2_FAC;
+  cal.mcp3204Factor[2] = MCP3204_CH3_FAC;
+  cal.mcp3204Factor[3] = MCP3204_CH4_FAC;
+  cal.adcCh36Factor = ACH_CH36_FACTOR;
+  cal.adcCh36Offset = ACH_CH36_OFFSET;
+
+  cal.tcoLength = TCO_AXIS_LEN;
+  cal.tcoPrecision = TCO_MAP_PREC;
+  for (i = 0; i < TCO_AXIS_LEN; i++)
+  {
+    cal.tcoAxis[i] = axis_v_tco_mes[i];
+    cal.tcoMap[i] = map_tco_mes[i];
+  }
+
+  cal.poilLength = POIL_AXIS_LEN;
+  cal.poilPrecision = POIL_MAP_PREC;
+  for (i = 0; i < POIL_AXIS_LEN; i++)
+  {
+    cal.poilAxis[i] = axis_v_poil_mes[i];
+    cal.poilMap[i] = map_poil_mes[i];
+  }
+
+  cal.crc = calcCrc(cal);
+}
+
+//****************************************
+// Calculate the CRC32 of the calibration data
+uint32_t CalibrationStore::calcCrc(const tCalibrationData &cal)
+{
+  return crc32_le(0, (const uint8_t *)&cal, offsetof(tCalibrationData, crc));
+}
+
+//****************************************
+// Check a map for length and strictly rising axis
+bool CalibrationStore::isMapValid(const uint32_t *axis, uint8_t length, uint8_t prec)
+{
+  uint8_t i;
+
+  if ((length < 2) || (length > LUT_MAX_AXIS_LEN) || (prec > 4))
+  {
+    return false;
+  }
+
+  // the axis has to be strict monotone rising
+  for (i = 1; i < length; i++)
+  {
+    if (axis[i] <= axis[i - 1])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//****************************************
+// Check header, CRC and maps of calibration data
+bool CalibrationStore::isValid(const tCalibrationData &cal)
+{
+  if ((cal.magic != CALIB_MAGIC) || (cal.version != CALIB_VERSION) ||
+      (cal.size != sizeof(tCalibrationData)))
+  {
+    return false;
+  }
+  if (cal.crc != calcCrc(cal))
+  {
+    return false;
+  }
+  return isMapValid(cal.tcoAxis, cal.tcoLength, cal.tcoPrecision) &&
+         isMapValid(cal.poilAxis, cal.poilLength, cal.poilPrecision);
+}
+
+//****************************************
+// Load the calibration data from the NVS
+bool CalibrationStore::load()
+{
+  size_t length = 0;
+
+  // open the namespace read only
+  if (this->nvsStorage.begin(CALIB_NVS_NAMESPACE, true))
+  {
+    // read the blob directly into the active data
+    if (this->nvsStorage.getBytesLength(CALIB_NVS_KEY) == sizeof(tCalibrationData))
+    {
+      length = this->nvsStorage.getBytes(CALIB_NVS_KEY, &this->activeData,
+                                         sizeof(tCalibrationData));
+    }
+    this->nvsStorage.end();
+  }
+
+  if ((length == sizeof(tCalibrationData)) && isValid(this->activeData))
+  {
+    this->activeSource = calibSource_nvs;
+  }
+  else
+  {
+    // fallback to the compiled defaults
+    setDefaults(this->activeData);
+    this->activeSource = calibSource_default;
+  }
+
+  // start editing with the active data
+  memcpy(&this->stagedData, &this->activeData, sizeof(tCalibrationData));
+
+// Debugging
+#ifdef DEBUG_LEVEL
+  Serial.print("Calibration loaded from ");
+  Serial.println(this->activeSource == calibSource_nvs ? "NVS" : "defaults");
+#endif // DEBUG_LEVEL
+
+  return (this->activeSource == calibSource_nvs);
+}
+
+//****************************************
+// Apply the active maps to the LookUpTables
+void CalibrationStore::applyMaps(LookUpTable1D &mapTCO, LookUpTable1D &mapPOIL) const
+{
+  mapTCO.setTable(this->activeData.tcoAxis, this->activeData.tcoMap,
+                  this->activeData.tcoLength, this->activeData.tcoPrecision);
+  mapPOIL.setTable(this->activeData.poilAxis, this->activeData.poilMap,
+                   this->activeData.poilLength, this->activeData.poilPrecision);
+}
+
+//****************************************
+// Parse an unsigned decimal number from the terminal
+bool CalibrationStore::parseUInt32(const char *text, uint32_t max, uint32_t &value)
+{
+  char *end = NULL;
+
+  // strtoul accepts a sign and wraps negative numbers around
+  if ((text[0] < '0') || (text[0] > '9'))
+  {
+    return false;
+  }
+  errno = 0;
+  unsigned long number = strtoul(text, &end, 10);
+  if ((*end != '\0') || (errno == ERANGE) || (number > max))
+  {
+    return false;
+  }
+  value = (uint32_t)number;
+  return true;
+}
+
+//****************************************
+// Parse a floating point number from the terminal
+bool CalibrationStore::parseDouble(const char *text, double &value)
+{
+  char *end = NULL;
+
+  errno = 0;
+  double number = strtod(text, &end);
+  if ((end == text) || (*end != '\0') || (errno == ERANGE) || !isfinite(number))
+  {
+    return false;
+  }
+  value = number;
+  return true;
+}
+
+//****************************************
+// Parse a map from the terminal into calibration data
+bool CalibrationStore::parseMap(char *args, uint32_t *axis, uint32_t *map,
+                                uint8_t &length, uint8_t &prec)
+{
+  char *savePtr = NULL;
+  char *tokPrec = (args != NULL) ? strtok_r(args, " ", &savePtr) : NULL;
+  char *item;
+  char *saveItem = NULL;
+  uint32_t newAxis[LUT_MAX_AXIS_LEN];
+  uint32_t newMap[LUT_MAX_AXIS_LEN];
+  uint8_t lenAxis = 0;
+  uint8_t lenMap = 0;
+  uint32_t newPrec;
+
+  if (tokPrec == NULL)
+  {
+    return false;
+  }
+  char *tokAxis = strtok_r(NULL, " ", &savePtr);
+  char *tokMap = strtok_r(NULL, " ", &savePtr);
+  if ((tokAxis == NULL) || (tokMap == NULL))
+  {
+    return false;
+  }
+
+  // comma separated values of the axis
+  for (item = strtok_r(tokAxis, ",", &saveItem); item != NULL;
+       item = strtok_r(NULL, ",", &saveItem))
+  {
+    if ((lenAxis >= LUT_MAX_AXIS_LEN) || !parseUInt32(item, UINT32_MAX, newAxis[lenAxis]))
+    {
+      return false;
+    }
+    lenAxis++;
+  }
+
+  // comma separated values of the map
+  for (item = strtok_r(tokMap, ",", &saveItem); item != NULL;
+       item = strtok_r(NULL, ",", &saveItem))
+  {
+    if ((lenMap >= LUT_MAX_AXIS_LEN) || !parseUInt32(item, UINT32_MAX, newMap[lenMap]))
+    {
+      return false;
+    }
+    lenMap++;
+  }
+
+  if (!parseUInt32(tokPrec, UINT8_MAX, newPrec) || (lenAxis != lenMap) ||
+      !isMapValid(newAxis, lenAxis, (uint8_t)newPrec))
+  {
+    return false;
+  }
+
+  // take over the new map
+  memset(axis, 0, sizeof(uint32_t) * LUT_MAX_AXIS_LEN);
+  memset(map, 0, sizeof(uint32_t) * LUT_MAX_AXIS_LEN);
+  memcpy(axis, newAxis, sizeof(uint32_t) * lenAxis);
+  memcpy(map, newMap, sizeof(uint32_t) * lenMap);
+  length = lenAxis;
+  prec = (uint8_t)newPrec;
+  return true;
+}
+
+//****************************************
+// Print calibration data to the terminal
+void CalibrationStore::printData(const char *title, const tCalibrationData &cal)
+{
+  uint8_t i;
+
+  Serial.println(title);
+  Serial.print("  MCP3204 Vref: ");
+  Serial.print(cal.mcp3204Vref, 4);
+  Serial.print(" Factors:");
+  for (i = 0; i < CALIB_MCP3204_CHANNELS; i++)
+  {
+    Serial.print(" ");
+    Serial.print(cal.mcp3204Factor[i], 6);
+  }
+  Serial.println();
+  Serial.print("  ADC36 Factor: ");
+  Serial.print(cal.adcCh36Factor, 4);
+  Serial.print(" Offset: ");
+  Serial.println(cal.adcCh36Offset, 4);
+
+  Serial.print("  TCO  prec ");
+  Serial.print(cal.tcoPrecision);
+  Serial.print(":");
+  for (i = 0; i < cal.tcoLength && i < LUT_MAX_AXIS_LEN; i++)
+  {
+    Serial.print(" ");
+    Serial.print(cal.tcoAxis[i]);
+    Serial.print("->");
+    Serial.print(cal.tcoMap[i]);
+  }
+  Serial.println();
+
+  Serial.print("  POIL prec ");
+  Serial.print(cal.poilPrecision);
+  Serial.print(":");
+  for (i = 0; i < cal.poilLength && i < LUT_MAX_AXIS_LEN; i++)
+  {
+    Serial.print(" ");
+    Serial.print(cal.poilAxis[i]);
+    Serial.print("->");
+    Serial.print(cal.poilMap[i]);
+  }
+  Serial.println();
+}
+
+//****************************************
+// Process the terminal command "cal"
+void CalibrationStore::processCommand(char *args)
+{
+  char *savePtr = NULL;
+  char *subCmd = (args != NULL) ? strtok_r(args, " ", &savePtr) : NULL;
+  uint8_t i;
+
+  if ((subCmd == NULL) || (strcmp(subCmd, "show") == 0))
+  {
+    printData(this->activeSource == calibSource_nvs ? "Active calibration (NVS):"
+                                                    : "Active calibration (defaults):",
+              this->activeData);
+    printData("Staged calibration:", this->stagedData);
+  }
+  else if (strcmp(subCmd, "adc") == 0)
+  {
+    double values[CALIB_MCP3204_CHANNELS + 3];
+    char *tok;
+
+    // vref, 4 channel factors, ch36 factor and ch36 offset
+    for (i = 0; i < CALIB_MCP3204_CHANNELS + 3; i++)
+    {
+      tok = strtok_r(NULL, " ", &savePtr);
+      if (tok == NULL)
+      {
+        Serial.println("cal adc: <vref> <f1> <f2> <f3> <f4> <f36> <o36>");
+        return;
+      }
+      if (!parseDouble(tok, values[i]))
+      {
+        Serial.print("cal adc: invalid value ");
+        Serial.println(tok);
+        return;
+      }
+    }
+    if (values[0] <= 0.0)
+    {
+      Serial.println("cal adc: vref has to be positive");
+      return;
+    }
+    this->stagedData.mcp3204Vref = values[0];
+    for (i = 0; i < CALIB_MCP3204_CHANNELS; i++)
+    {
+      this->stagedData.mcp3204Factor[i] = values[i + 1];
+    }
+    this->stagedData.adcCh36Factor = values[CALIB_MCP3204_CHANNELS + 1];
+    this->stagedData.adcCh36Offset = values[CALIB_MCP3204_CHANNELS + 2];
+    Serial.println("cal adc: staged");
+  }
+  else if (strcmp(subCmd, "tco") == 0)
+  {
+    if (parseMap(savePtr, this->stagedData.tcoAxis, this->stagedData.tcoMap,
+                 this->stagedData.tcoLength, this->stagedData.tcoPrecision))
+    {
+      Serial.println("cal tco: staged");
+    }
+    else
+    {
+      Serial.println("cal tco: invalid, <prec> <x1,x2,..> <y1,y2,..> (rising axis)");
+    }
+  }
+  else if (strcmp(subCmd, "poil") == 0)
+  {
+    if (parseMap(savePtr, this->stagedData.poilAxis, this->stagedData.poilMap,
+                 this->stagedData.poilLength, this->stagedData.poilPrecision))
+    {
+      Serial.println("cal poil: staged");
+    }
+    else
+    {
+      Serial.println("cal poil: invalid, <prec> <x1,x2,..> <y1,y2,..> (rising axis)");
+    }
+  }
+  else if (strcmp(subCmd, "save") == 0)
+  {
+    this->stagedData.magic = CALIB_MAGIC;
+    this->stagedData.version = CALIB_VERSION;
+    this->stagedData.size = sizeof(tCalibrationData);
+    this->stagedData.crc = calcCrc(this->stagedData);
+
+    this->nvsStorage.begin(CALIB_NVS_NAMESPACE, false);
+    size_t written = this->nvsStorage.putBytes(CALIB_NVS_KEY, &this->stagedData,
+                                               sizeof(tCalibrationData));
+    this->nvsStorage.end();
+
+    Serial.println(written == sizeof(tCalibrationData)
+                       ? "cal save: stored, reboot to activate"
+                       : "cal save: failed");
+  }
+  else if (strcmp(subCmd, "default") == 0)
+  {
+    this->nvsStorage.begin(CALIB_NVS_NAMESPACE, false);
+    this->nvsStorage.remove(CALIB_NVS_KEY);
+    this->nvsStorage.end();
+    setDefaults(this->stagedData);
+    Serial.println("cal default: removed, reboot to activate");
+  }
+  else
+  {
+    Serial.println("cal: show | adc | tco | poil | save | default");
+  }
+}
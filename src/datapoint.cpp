@@ -197,45 +197,56 @@ bool DataPoint::printDatapointFull()
 {
 
   uint8_t k;
-  String str = "";
+  char number[FIXED_FORMAT_BUFFER_SIZE];
 
   // Add Timestamp
-  str = str + String(this->timestamp) + " -> ";
+  Serial.print(this->timestamp);
+  Serial.print(" -> ");
 
   // Add Name
-  str = str + "Name: " + this->signalName;
+  Serial.print("Name: ");
+  Serial.print(this->signalName);
   // Add Sensortype
   switch (this->sensorTyp)
   {
   case senType_ds1820:
-    str = str + " - DS18S20";
+    Serial.print(" - DS18S20");
     break;
   case senType_virtual:
-    str = str + " - virtual";
+    Serial.print(" - virtual");
     break;
 
   default:
-    str = str + " ------";
+    Serial.print(" ------");
     break;
   }
 
   // Add Value
-  str = str + " -> Value: " + String(this->value, 3U) + " " + this->signalUnit;
+  formatFixedFloat(number, 0, this->value, 3);
+  Serial.print(" -> Value: ");
+  Serial.print(number);
+  Serial.print(" ");
+  Serial.print(this->signalUnit);
 
   // Add Mean
-  str = str + " -> Mean: " + String(this->value_mean) + " " + this->signalUnit;
+  formatFixedFloat(number, 0, this->value_mean, 2);
+  Serial.print(" -> Mean: ");
+  Serial.print(number);
+  Serial.print(" ");
+  Serial.print(this->signalUnit);
 
-  // Add Mean
-  str = str + " -> History: ";
+  // Add History
+  Serial.print(" -> History: ");
 
   for (k = 0; k < MAX_HISTORY_BUFFER_SIZE; k++)
   {
-
-    str = str + String(this->value_history[k]) + " ";
+    formatFixedFloat(number, 0, this->value_history[k], 2);
+    Serial.print(number);
+    Serial.print(" ");
   }
 
   // print
-  Serial.println(str);
+  Serial.println();
 
   return true;
 }
@@ -246,17 +257,18 @@ bool DataPoint::printDatapointFull()
 bool DataPoint::printDatapointShort()
 {
 
-  uint8_t k;
-  String str = "";
+  char number[FIXED_FORMAT_BUFFER_SIZE];
 
   // Add Name
-  str = this->signalName + ": ";
+  Serial.print(this->signalName);
+  Serial.print(": ");
 
   // Add Value
-  str = str + String(this->value, 3U) + " " + this->signalUnit + "; ";
-
-  // print
-  Serial.print(str);
+  formatFixedFloat(number, 0, this->value, 3);
+  Serial.print(number);
+  Serial.print(" ");
+  Serial.print(this->signalUnit);
+  Serial.print("; ");
 
   return true;
 }
\ No newline at end of file
@@ -14,6 +14,7 @@
  */
 
 #include <display_data.h>
+#include <stdarg.h>
 
 /// Object for I2C Bus
 TwoWire WireI2C(0x3f);
@@ -21,10 +22,31 @@ TwoWire WireI2C(0x3f);
 /// Define the semaphore handle for the LCD Display Update
 SemaphoreHandle_t xMutexLCDUpdate = NULL;
 
+/// DDRAM address of the first character of each row (HD44780 20x4)
+static const uint8_t lcdRowAddress[LCD_ROWS] = {0x00, 0x40, 0x14, 0x54};
+
+//****************************************
+// DDRAM address of the cursor after writing up to an address
+static uint8_t lcdNextAddress(uint8_t address)
+{
+  // row 3 continues in row 2, row 4 continues in row 1
+  if (address == 0x28)
+  {
+    return 0x40;
+  }
+  if (address == 0x68)
+  {
+    return 0x00;
+  }
+  return address;
+}
+
 //****************************************
 // Construct a new DisplayData object
-DisplayData::DisplayData(AcquireData &data) : data(data), lcd(0x3F)
+DisplayData::DisplayData(AcquireData &data, N2kBusMonitor &busMonitor, DisplayBackend &lcd)
+    : data(data), busMonitor(busMonitor), lcd(lcd)
 {
+  memset(lcdDisplay, ' ', sizeof(lcdDisplay));
 }
 
 // Setup the LCD Panel
@@ -33,25 +55,24 @@ void DisplayData::setupLCDPanel()
   // Create the mutex before using it
   xMutexLCDUpdate = xSemaphoreCreateMutex();
 
-  WireI2C.begin(21, 22);   // custom i2c port on ESP
-  WireI2C.setClock(80000); // set 80kHz (PCF8574 max speed 100kHz)
+  WireI2C.begin(21, 22);           // custom i2c port on ESP
+  WireI2C.setClock(this->lcd.getI2cClock()); // PCF8574 100kHz, OLED 400kHz
 
-  this->lcd.begin(20, 4, WireI2C);
-  this->lcd.setBacklight(255);
+  this->lcd.begin(LCD_COLS, LCD_ROWS, WireI2C);
+  writeBacklight(LCD_BACKLIGHT_FULL);
 } // setupLCDPanel
 
 //****************************************
 // Increase the current page of the LCD Panel by One
 void DisplayData::increaseLcdCurrentPage()
 {
-  lcdCurrentPage++;
+  uint8_t page = lcdCurrentPage + 1;
   // limit the page number
-  if (lcdCurrentPage > MAX_MAIN_PAGES)
+  if (page > MAX_MAIN_PAGES)
   {
-    setLcdCurrentPage(WELCOME_PAGE + 1);
+    page = WELCOME_PAGE + 1;
   }
-  lcdScreenRenew = true;   // reload the screen
-  updateLcdContent(false); // update the content completely
+  setLcdCurrentPage(page);
 
 } // increaseLcdCurrentPage
 
@@ -59,12 +80,171 @@ void DisplayData::increaseLcdCurrentPage()
 // Set the current page for the LCD Panel
 void DisplayData::setLcdCurrentPage(uint8_t page)
 {
+  uint32_t startUs = micros();
+
+  // the alarm page is requested cyclically while an alarm is active
+  if (page == lcdCurrentPage && !lcdPageChanged)
+  {
+    return;
+  }
   lcdCurrentPage = page;
-  lcdScreenRenew = true;   // reload the screen
-  updateLcdContent(false); // update the content completely
+  lcdPageChanged = true; // update the content completely
+  requestRender();
+
+  // time the calling task was blocked
+  uint32_t blockedUs = micros() - startUs;
+  if (blockedUs > lcdStat.pageRequestUsMax)
+  {
+    lcdStat.pageRequestUsMax = blockedUs;
+  }
 
 } // setLcdCurrentPage
 
+//****************************************
+// Wake up the LCD task
+void DisplayData::requestRender()
+{
+  // before the LCD task runs, the request is rendered with its first cycle
+  if (renderTask != NULL)
+  {
+    xTaskNotifyGive(renderTask);
+  }
+} // requestRender
+
+//****************************************
+// Render the current page and flush it to the LCD Panel (LCD task only)
+void DisplayData::render()
+{
+  // a request between reading and clearing the flag must not get lost
+  bool pageChanged = lcdPageChanged.exchange(false);
+
+  // the check renders all pages, then the current page is rendered again
+  if (lcdCheckRequested)
+  {
+    runSelfCheck();
+    lcdCheckRequested = false;
+    pageChanged = true;
+  }
+
+  // the trends are kept also while another page is shown
+  sampleTrends();
+
+  // Update the Content of the LCD Panel, the static text on a page change
+  updateLcdContent(!pageChanged);
+
+  // Update LED Backlight Brightness
+  updateLcdBacklight();
+} // render
+
+//****************************************
+// Show the trend of the next value on the trend page
+void DisplayData::nextTrendChannel()
+{
+  lcdTrendChannel = (lcdTrendChannel + 1) % TREND_CHANNEL_COUNT;
+  lcdPageChanged = true; // update the content completely
+  requestRender();
+} // nextTrendChannel
+
+//****************************************
+// Request the self check of all pages
+void DisplayData::requestSelfCheck()
+{
+  lcdCheckDone = false;
+  lcdCheckRequested = true;
+  requestRender();
+} // requestSelfCheck
+
+//****************************************
+// Render all pages into the back buffer and check them (LCD task only)
+void DisplayData::runSelfCheck()
+{
+  for (uint8_t i = 0; i < LCD_PAGE_COUNT; i++)
+  {
+    tLcdCheckResult &result = lcdCheck[i];
+    uint32_t rowOverflows = lcdStat.rowOverflows;
+    uint32_t fieldOverflows = lcdStat.fieldOverflows;
+
+    memset(lcdDisplay, ' ', sizeof(lcdDisplay));
+    renderLcdPage(lcdPages[i], false);
+
+    result.page = lcdPages[i].page;
+    result.rowOverflows = lcdStat.rowOverflows - rowOverflows;
+    result.fieldOverflows = lcdStat.fieldOverflows - fieldOverflows;
+    memcpy(result.grid, lcdDisplay, sizeof(result.grid));
+  }
+  memset(lcdDisplay, ' ', sizeof(lcdDisplay));
+  lcdCheckDone = true;
+} // runSelfCheck
+
+//****************************************
+// Print the result of the self check to the terminal
+bool DisplayData::printSelfCheck()
+{
+  char buffer[96];
+  uint8_t failed = 0;
+
+  if (!lcdCheckDone)
+  {
+    Serial.println("LCD check not finished");
+    return false;
+  }
+
+  for (uint8_t i = 0; i < LCD_PAGE_COUNT; i++)
+  {
+    const tLcdCheckResult &result = lcdCheck[i];
+    bool ok = (result.rowOverflows == 0);
+
+    snprintf(buffer, sizeof(buffer), "Page %2u  row overflow %u  field overflow %u  %s",
+             result.page, result.rowOverflows, result.fieldOverflows, ok ? "ok" : "FAILED");
+    Serial.println(buffer);
+
+    // the grid, glyphs as their number, the full block as '#'
+    for (uint8_t row = 0; row < LCD_ROWS; row++)
+    {
+      buffer[0] = '|';
+      for (uint8_t col = 0; col < LCD_COLS; col++)
+      {
+        uint8_t c = (uint8_t)result.grid[row][col];
+        if (c >= LCD_GLYPH_CODE && c < LCD_GLYPH_CODE + LCD_GLYPH_COUNT)
+        {
+          c = '0' + (c - LCD_GLYPH_CODE);
+        }
+        else if (c == 0xFF)
+        {
+          c = '#';
+        }
+        buffer[1 + col] = (char)c;
+      }
+      buffer[1 + LCD_COLS] = '|';
+      buffer[2 + LCD_COLS] = '\0';
+      Serial.println(buffer);
+    }
+    if (!ok)
+    {
+      failed++;
+    }
+  }
+
+  snprintf(buffer, sizeof(buffer), "LCD check %s: %u of %u pages failed",
+           (failed == 0) ? "passed" : "FAILED", failed, LCD_PAGE_COUNT);
+  Serial.println(buffer);
+  return failed == 0;
+} // printSelfCheck
+
+//****************************************
+// Scroll the alarm page by one alarm, from the last back to the first
+void DisplayData::scrollAlarmList()
+{
+  uint8_t next = lcdAlarmScroll + 1;
+
+  if (next + LCD_ALARM_ROWS > lcdAlarmCount)
+  {
+    next = 0;
+  }
+  lcdAlarmScroll = next;
+  requestRender();
+} // scrollAlarmList
+
 //****************************************
 // Update the backlight of the LCD Panel
 void DisplayData::updateLcdBacklight()
@@ -88,312 +268,632 @@ void DisplayData::updateLcdBacklight()
 // Set the backlight of the LCD Panel to full brightness
 void DisplayData::setBacklightFull()
 {
-  this->lcd.setBacklight(LCD_BACKLIGHT_FULL);
+  writeBacklight(LCD_BACKLIGHT_FULL);
 } // setBacklightFull
 
 //****************************************
 // Set the backlight of the LCD Panel to off
 void DisplayData::setBacklightOff()
 {
-  this->lcd.setBacklight(LCD_BACKLIGHT_OFF);
+  writeBacklight(LCD_BACKLIGHT_OFF);
 } // setBacklightOff
 
+//****************************************
+// Set the backlight of the LCD Panel if it has changed
+void DisplayData::writeBacklight(uint8_t value)
+{
+  if (lcdBacklightValue == value)
+  {
+    return;
+  }
+  this->lcd.setBacklight(value);
+  lcdBacklightValue = value;
+} // writeBacklight
+
 //****************************************
 // Update the content of all LCD pages
 void DisplayData::updateLcdContent(boolean blnUpdateDataOnly)
 {
-  char buffer[21];
-  int length;
-
-  // count the number of alarms
-  uint8_t alarmCount = this->data.getActiveWarningCount();
-  // temporary buffer for alarmtext
-  char bufferAlarmTxt[21];
-  // number of alarm line
-  uint8_t alarmLine = 0;
-
-  // // when there are alarms, then switch to the alarm page
-  // if (alarmCount > 0)&&()
-  // {
-  //   lcdCurrentPage = (uint8_t)PAGE_ALARM;
-  // }
-
-  // Edit the content of the LCD Panel
-  switch (lcdCurrentPage)
-  {
-  case WELCOME_PAGE:
-    // ------------------------------
-    // Welcome Screen
-    // ------------------------------
-    // fill the screen buffer with permanent text
-    length = sprintf(buffer, "VolvoPenta Connect");
-    strncpy(&lcdDisplay[0][0], buffer, 20);
-
-    length = sprintf(buffer, "---  Tatooine  ---");
-    strncpy(&lcdDisplay[1][0], buffer, 20);
-
-    length = sprintf(buffer, "by Matthias Werner  ");
-    strncpy(&lcdDisplay[2][0], buffer, 20);
-
-    length = sprintf(buffer, "      Version %d.%d.%d ", 
-              SW_VERSION_MAJOR, SW_VERSION_MINOR, SW_VERSION_PATCH);
-    strncpy(&lcdDisplay[3][0], buffer, 20);
+  const tLcdPage *page = &lcdErrorPage;
 
-    break;
+  // search the description of the current page
+  for (uint8_t i = 0; i < LCD_PAGE_COUNT; i++)
+  {
+    if (lcdPages[i].page == lcdCurrentPage)
+    {
+      page = &lcdPages[i];
+      break;
+    }
+  }
 
-  case PAGE_ENGINE:
-    // ------------------------------
-    // Engine Screen
-    // ------------------------------
-    if (!blnUpdateDataOnly || (lcdUpdateCounter > LCD_MAX_CYCLE_COUNT_TILL_FULL_UPDATE))
-    { // fill the screen buffer with permanent text
-      length = sprintf(buffer, "Engine Data  %6.1fh", this->data.engSecond.getValue() / 3600);
-      strncpy(&lcdDisplay[0][0], buffer, 20);
+  renderLcdPage(*page, blnUpdateDataOnly);
 
-      length = sprintf(buffer, "--------------------");
-      strncpy(&lcdDisplay[1][0], buffer, 20);
+  // update the LCD Panel
+  updateLCDPanel();
+}
 
-      length = sprintf(buffer, "  rpm GrdC  bar GrdC");
-      strncpy(&lcdDisplay[2][0], buffer, 20);
+//****************************************
+// Render a page into the back buffer
+void DisplayData::renderLcdPage(const tLcdPage &page, boolean blnUpdateDataOnly)
+{
+  // the static rows and the glyphs are written only when the page is shown
+  if (!blnUpdateDataOnly)
+  {
+    for (uint8_t row = 0; row < LCD_ROWS; row++)
+    {
+      if (page.rows[row] != NULL)
+      {
+        setLcdRow(row, page.rows[row]);
+      }
+    }
+    // a panel with pixels draws the graphs without glyphs
+    lcdPixelRender = lcdRender_None;
+    if (page.glyphs != NULL && !isPixelPanel())
+    {
+      for (uint8_t slot = 0; slot < LCD_GLYPH_COUNT; slot++)
+      {
+        setLcdGlyph(slot, page.glyphs[slot]);
+      }
     }
+  }
 
-    // fill buffer with data
-    length = sprintf(buffer, "%5d%5d%5.1f%5d", (uint16_t)this->data.nMot.getValue(), (uint16_t)this->data.tEngine.getValue(), this->data.pOil.getValue(), (int16_t)this->data.tExhaust.getValue());
-    strncpy(&lcdDisplay[3][0], buffer, 20);
+  // format the measured values, slow fields only from time to time
+  uint32_t startUs = micros();
+  bool slowUpdate = !blnUpdateDataOnly || (lcdUpdateCounter > LCD_MAX_CYCLE_COUNT_TILL_FULL_UPDATE);
+  for (uint8_t i = 0; i < page.fieldCount; i++)
+  {
+    if (!page.fields[i].slow || slowUpdate)
+    {
+      renderField(page.fields[i]);
+    }
+  }
+  lcdStat.formatUsLast = micros() - startUs;
+  if (lcdStat.formatUsLast > lcdStat.formatUsMax)
+  {
+    lcdStat.formatUsMax = lcdStat.formatUsLast;
+  }
 
+  // pages with lists
+  switch (page.render)
+  {
+  case lcdRender_OneWire:
+    renderOneWirePage();
     break;
-  case PAGE_TEMPERATURE:
-    // ------------------------------
-    // Temperature Screen
-    // ------------------------------
-    if (!blnUpdateDataOnly)
-    { // fill the screen buffer with permanent text
-      length = sprintf(buffer, "Temperature   [GrdC]");
-      strncpy(&lcdDisplay[0][0], buffer, 20);
-
-      length = sprintf(buffer, "--------------------");
-      strncpy(&lcdDisplay[1][0], buffer, 20);
-
-      length = sprintf(buffer, "  Eng Gear  Sea  Exh");
-      strncpy(&lcdDisplay[2][0], buffer, 20);
-    }
+  case lcdRender_N2kBus:
+    renderN2kBusPage();
+    break;
+  case lcdRender_Alarm:
+    renderAlarmPage();
+    break;
+  case lcdRender_Trend:
+    renderTrendPage(blnUpdateDataOnly);
+    break;
+  case lcdRender_BigDigits:
+    renderBigDigitPage();
+    break;
+  case lcdRender_None:
+  default:
+    break;
+  }
+} // renderLcdPage
 
-    // fill buffer with data
-    length = sprintf(buffer, "%5d%5d%5.1f%5d", (int16_t)this->data.tEngine.getValue(), (int16_t)this->data.tGearbox.getValue(), this->data.tSeaOutletWall.getValue(), (int16_t)this->data.tExhaust.getValue());
-    strncpy(&lcdDisplay[3][0], buffer, 20);
+//****************************************
+// Write a text into one row of the back buffer, filled with blanks
+void DisplayData::setLcdRow(uint8_t row, const char *text)
+{
+  uint8_t col = 0;
 
-    break;
+  while (col < LCD_COLS && text[col] != '\0')
+  {
+    lcdDisplay[row][col] = text[col];
+    col++;
+  }
+  memset(&lcdDisplay[row][col], ' ', LCD_COLS - col);
 
-  case PAGE_SPEED:
-    // ------------------------------
-    // Speed Screen
-    // ------------------------------
-    if (!blnUpdateDataOnly)
-    { // fill the screen buffer with permanent text
-      length = sprintf(buffer, "Speed        [U/min]");
-      strncpy(&lcdDisplay[0][0], buffer, 20);
+  // the text has been cut
+  if (text[col] != '\0')
+  {
+    lcdStat.rowOverflows++;
+  }
+} // setLcdRow
 
-      length = sprintf(buffer, "--------------------");
-      strncpy(&lcdDisplay[1][0], buffer, 20);
+//****************************************
+// Format a text into one row of the back buffer, filled with blanks
+void DisplayData::printLcdRow(uint8_t row, const char *format, ...)
+{
+  char buffer[LCD_COLS + 1];
+  va_list args;
 
-      length = sprintf(buffer, "  Eng Gear Alt1 Alt2");
-      strncpy(&lcdDisplay[2][0], buffer, 20);
-    }
+  va_start(args, format);
+  int length = vsnprintf(buffer, sizeof(buffer), format, args);
+  va_end(args);
 
-    // fill buffer with data
-    length = sprintf(buffer, "%5d%5d%5d%5d", (uint16_t)this->data.nMot.getValue(), (uint16_t)this->data.nShaft.getValue(), (uint16_t)this->data.nAlternator1.getValue(), (uint16_t)this->data.nAlternator2.getValue());
-    strncpy(&lcdDisplay[3][0], buffer, 20);
+  // the text has been cut
+  if (length > LCD_COLS)
+  {
+    lcdStat.rowOverflows++;
+  }
+  setLcdRow(row, buffer);
+} // printLcdRow
 
-    break;
+//****************************************
+// Format one field into the back buffer
+void DisplayData::renderField(const tLcdField &field)
+{
+  char buffer[FIXED_FORMAT_BUFFER_SIZE];
+  double value = (this->data.*field.source).getValue() * field.factor;
+  uint8_t width = (field.width > LCD_FIELD_MAX_WIDTH) ? LCD_FIELD_MAX_WIDTH : field.width;
+
+  // a value which does not fit is written as '*'
+  formatFixedFloat(buffer, width, value, field.decimals);
+  if (buffer[0] == '*')
+  {
+    lcdStat.fieldOverflows++;
+  }
+
+  // never write behind the end of the row
+  uint8_t col = field.col;
+  for (uint8_t i = 0; i < width && col < LCD_COLS; i++)
+  {
+    lcdDisplay[field.row][col++] = buffer[i];
+  }
+  for (const char *unit = field.unit; *unit != '\0' && col < LCD_COLS; unit++)
+  {
+    lcdDisplay[field.row][col++] = *unit;
+  }
+} // renderField
 
-  case PAGE_ALTERNATOR:
-    // ------------------------------
-    // Alternator Screen
-    // ------------------------------
-    if (!blnUpdateDataOnly)
-    { // fill the screen buffer with permanent text
-      length = sprintf(buffer, "Alternator  Data    ");
-      strncpy(&lcdDisplay[0][0], buffer, 20);
+//****************************************
+// Render the list of the 1-Wire sensors
+void DisplayData::renderOneWirePage()
+{
+  DeviceAddress address;
 
-      length = sprintf(buffer, "--------------------");
-      strncpy(&lcdDisplay[1][0], buffer, 20);
+  // locate devices on the bus
+  uint8_t deviceCount = oneWireSensors.getDeviceCount();
+  printLcdRow(0, "Found %1d DS18S20.", deviceCount);
 
-      length = sprintf(buffer, "  rpm GrdC  rpm    V");
-      strncpy(&lcdDisplay[2][0], buffer, 20);
+  // Print Adresses to LCD Display
+  for (uint8_t i = 0; i < 3; i++)
+  {
+    if (i >= deviceCount)
+    {
+      // clear line
+      setLcdRow(i + 1, "");
+    }
+    else
+    {
+      // show the address
+      oneWireSensors.getAddress(address, i);
+      printLcdRow(i + 1, "> 0x%02x%02x%02x%02x%02x%02x%02x%02x",
+                  address[0], address[1], address[2], address[3], address[4],
+                  address[5], address[6], address[7]);
     }
+  }
+} // renderOneWirePage
 
-    // fill buffer with data
-    length = sprintf(buffer, "%5d%5d%5d%5.1f", (uint16_t)this->data.nAlternator1.getValue(), (int16_t)this->data.tAlternator.getValue(), (uint16_t)this->data.nAlternator2.getValue(), this->data.uBat.getValue());
-    strncpy(&lcdDisplay[3][0], buffer, 20);
+//****************************************
+// Render the diagnostic of the NMEA2000 bus
+void DisplayData::renderN2kBusPage()
+{
+  tN2kBusStatistic busStat = this->busMonitor.getStatistic();
 
-    break;
+  // "Filt": the CAN controller filters, the load holds the admitted frames only
+  printLcdRow(0, "N2K %s Load %3u.%u%%", busStat.admittedOnly ? "Filt" : "Bus ",
+              busStat.busLoad1s / 10, busStat.busLoad1s % 10);
 
-  case PAGE_VOLTAGE:
-    // ------------------------------
-    // Voltage Screen
-    // ------------------------------
-    if (!blnUpdateDataOnly || (lcdUpdateCounter > LCD_MAX_CYCLE_COUNT_TILL_FULL_UPDATE))
-    { // fill the screen buffer with permanent text
-      length = sprintf(buffer, "MCP3204       %5.2fV", this->data.uBat.getValue());
-      strncpy(&lcdDisplay[0][0], buffer, 20);
+  printLcdRow(1, "10s%3u.%u%% 60s%3u.%u%%",
+              busStat.busLoad10s / 10, busStat.busLoad10s % 10,
+              busStat.busLoad60s / 10, busStat.busLoad60s % 10);
 
-      length = sprintf(buffer, "--------------------");
-      strncpy(&lcdDisplay[1][0], buffer, 20);
+  printLcdRow(2, "Rx%5u/s  Tx%5u/s", busStat.rxFramesPerSecond, busStat.txFramesPerSecond);
 
-      length = sprintf(buffer, "    V    V    V    V");
-      strncpy(&lcdDisplay[2][0], buffer, 20);
-    }
+  if (busStat.busOff)
+  {
+    printLcdRow(3, "!!! BUS OFF !!! %4lu", (unsigned long)(busStat.busOffEvents % 10000));
+  }
+  else
+  {
+    printLcdRow(3, "TEC%3u REC%3u Off%3lu", busStat.txErrorCounter, busStat.rxErrorCounter,
+                (unsigned long)(busStat.busOffEvents % 1000));
+  }
+} // renderN2kBusPage
 
-    // fill buffer with data
-    length = sprintf(buffer, "%5.1f%5.1f%5.1f%5.1f", this->data.uMcp3204Ch1.getValue(), this->data.uMcp3204Ch2.getValue(), this->data.uMcp3204Ch3.getValue(), this->data.uMcp3204Ch4.getValue());
-    strncpy(&lcdDisplay[3][0], buffer, 20);
+//****************************************
+// Render the list of the active alarms
+void DisplayData::renderAlarmPage()
+{
+  char buffer[21];
+  uint32_t now = millis();
 
-    break;
+  updateAlarmList();
 
-  case PAGE_1WIRE_LIST:
-    // ------------------------------
-    // List DS18S20 Sensors Screen
-    // ------------------------------
-    uint8_t i;
-    uint8_t deviceCount;
-    DeviceAddress address;
-
-    // locate devices on the bus
-    deviceCount = oneWireSensors.getDeviceCount();
-    length = sprintf(buffer, "Found %1d DS18S20.    ", deviceCount);
-    strncpy(&lcdDisplay[0][0], buffer, 20);
-
-    // Print Adresses to LCD Display
-    for (int i = 0; i < 3; i++)
-    {
-      if (i >= deviceCount)
-      {
-        // clear line
-        length = sprintf(buffer, "                    ");
-        strncpy(&lcdDisplay[i + 1][0], buffer, 20);
-      }
-      else
-      {
-        // show the address
-        oneWireSensors.getAddress(address, i);
-        length = sprintf(buffer, "> 0x%02x%02x%02x%02x%02x%02x%02x%02x",
-                         address[0], address[1], address[2], address[3], address[4],
-                         address[5], address[6], address[7]);
-        strncpy(&lcdDisplay[i + 1][0], buffer, 20);
-      }
-    }
-    break;
+  if (lcdAlarmCount == 0)
+  {
+    setLcdRow(0, "--- No Alarms ---");
+    setLcdRow(1, "");
+    setLcdRow(2, "");
+    setLcdRow(3, "");
+    return;
+  }
 
-  case PAGE_ALARM:
-    // ------------------------------
-    // Alarm Screen
-    // ------------------------------
+  // the list may have become shorter
+  uint8_t first = lcdAlarmScroll;
+  if (first + LCD_ALARM_ROWS > lcdAlarmCount)
+  {
+    first = (lcdAlarmCount > LCD_ALARM_ROWS) ? lcdAlarmCount - LCD_ALARM_ROWS : 0;
+    lcdAlarmScroll = first;
+  }
+  uint8_t last = (first + LCD_ALARM_ROWS < lcdAlarmCount) ? first + LCD_ALARM_ROWS : lcdAlarmCount;
 
-    // renew the screen always when the page is selected
-    lcdScreenRenew = true;
+  printLcdRow(0, "%u Alarm%s", lcdAlarmCount, (lcdAlarmCount == 1) ? "" : "s");
+  // visible part of the list
+  if (lcdAlarmCount > LCD_ALARM_ROWS)
+  {
+    snprintf(buffer, sizeof(buffer), "%u-%u", first + 1, last);
+    memcpy(&lcdDisplay[0][LCD_COLS - strlen(buffer)], buffer, strlen(buffer));
+  }
 
-    // count the number of alarms
-    if (alarmCount == 0)
+  for (uint8_t row = 0; row < LCD_ALARM_ROWS; row++)
+  {
+    uint8_t index = first + row;
+    if (index >= lcdAlarmCount)
     {
-      // fill the screen buffer with permanent text
-      length = sprintf(buffer, "--- No Alarms ---   ");
-      strncpy(&lcdDisplay[0][0], buffer, 20);
-
-      length = sprintf(buffer, "                    ");
-      strncpy(&lcdDisplay[1][0], buffer, 20);
+      setLcdRow(1 + row, "");
+      continue;
+    }
 
-      length = sprintf(buffer, "                    ");
-      strncpy(&lcdDisplay[2][0], buffer, 20);
+    const tN2kAlertDefinition &alert = n2kAlerts[lcdAlarmList[index]];
+    ErrorFlag &flag = this->data.currentEngineDiscreteStatus.*alert.flag;
 
-      length = sprintf(buffer, "                    ");
-      strncpy(&lcdDisplay[3][0], buffer, 20);
+    // time since the onset, mm:ss up to 99 minutes, then hh:mm
+    uint32_t age = (now - flag.getTimeStampWhenSet()) / 1000;
+    if (age < 6000)
+    {
+      printLcdRow(1 + row, "%c%c%-12.12s %02lu:%02lu",
+                  (alert.type == N2K_ALERT_TYPE_ALARM) ? 'A' : 'W', flag.isFlagAcknowledged() ? ' ' : '!',
+                  alert.lcdText, (unsigned long)(age / 60), (unsigned long)(age % 60));
     }
     else
     {
-      // fill the screen buffer with permanent text
-      length = sprintf(buffer, " Alarms Active !!! %d", alarmCount);
-      strncpy(&lcdDisplay[0][0], buffer, 20);
+      printLcdRow(1 + row, "%c%c%-12.12s %02luh%02lu",
+                  (alert.type == N2K_ALERT_TYPE_ALARM) ? 'A' : 'W', flag.isFlagAcknowledged() ? ' ' : '!',
+                  alert.lcdText, (unsigned long)((age / 3600) % 100), (unsigned long)((age / 60) % 60));
+    }
+  }
+} // renderAlarmPage
 
-      length = sprintf(buffer, "--------------------");
-      strncpy(&lcdDisplay[1][0], buffer, 20);
+//****************************************
+// Build the list of the active alarms if an error flag has changed
+void DisplayData::updateAlarmList()
+{
+  uint32_t changeCount = ErrorFlag::getChangeCount();
 
-      // create alarm text cooresponding to the active alarms
-      if (this->data.currentEngineDiscreteStatus.flgHighCoolantTemp.isFlagSet())
-      {
-        length = sprintf(bufferAlarmTxt, "Overtemp Coolant    ");
-        strncpy(&lcdDisplay[2 + alarmLine][0], bufferAlarmTxt, 20);
-        alarmLine++;
-      }
-      if (this->data.currentEngineDiscreteStatus.flgLowOilPressure.isFlagSet())
-      {
-        length = sprintf(bufferAlarmTxt, "Low Oil Pressure    ");
-        strncpy(&lcdDisplay[2 + alarmLine][0], bufferAlarmTxt, 20);
-        alarmLine++;
-      }
-      if (this->data.currentEngineDiscreteStatus.flgHighExhaustTemp.isFlagSet() && (alarmCount <= 2))
-      {
-        length = sprintf(bufferAlarmTxt, "High Exhaust Temp   ");
-        strncpy(&lcdDisplay[2 + alarmLine][0], bufferAlarmTxt, 20);
-        alarmLine++;
-      }
-      if (this->data.currentEngineDiscreteStatus.flgHighGearboxTemp.isFlagSet() && (alarmCount <= 2))
+  if (lcdAlarmListValid && changeCount == lcdAlarmChangeCount)
+  {
+    return;
+  }
+  lcdAlarmListValid = true;
+  lcdAlarmChangeCount = changeCount;
+
+  // insertion sort: alarms before warnings, the newest first
+  lcdAlarmCount = 0;
+  for (uint8_t i = 0; i < N2K_ALERT_COUNT; i++)
+  {
+    ErrorFlag &flag = this->data.currentEngineDiscreteStatus.*n2kAlerts[i].flag;
+    if (!flag.isFlagSet())
+    {
+      continue;
+    }
+
+    uint8_t pos = lcdAlarmCount;
+    while (pos > 0)
+    {
+      const tN2kAlertDefinition &other = n2kAlerts[lcdAlarmList[pos - 1]];
+      ErrorFlag &otherFlag = this->data.currentEngineDiscreteStatus.*other.flag;
+
+      bool before = (n2kAlerts[i].type < other.type) ||
+                    (n2kAlerts[i].type == other.type &&
+                     (long)(flag.getTimeStampWhenSet() - otherFlag.getTimeStampWhenSet()) > 0);
+      if (!before)
       {
-        length = sprintf(bufferAlarmTxt, "High Gearbox Temp   ");
-        strncpy(&lcdDisplay[2 + alarmLine][0], bufferAlarmTxt, 20);
-        alarmLine++;
+        break;
       }
-      if (this->data.currentEngineDiscreteStatus.flgHighAlternatorTemp.isFlagSet() && (alarmCount <= 2))
+      lcdAlarmList[pos] = lcdAlarmList[pos - 1];
+      pos--;
+    }
+    lcdAlarmList[pos] = i;
+    lcdAlarmCount++;
+  }
+} // updateAlarmList
+
+//****************************************
+// Render the bar graph of the trend
+void DisplayData::renderTrendPage(boolean blnUpdateDataOnly)
+{
+  uint8_t channel = lcdTrendChannel;
+  const TrendHistory &trend = trendHistory[channel];
+  char buffer[FIXED_FORMAT_BUFFER_SIZE];
+  float min;
+  float max;
+
+  // nothing has changed until the next bucket is closed
+  if (blnUpdateDataOnly && trend.getVersion() == lcdTrendVersion)
+  {
+    return;
+  }
+  lcdTrendVersion = trend.getVersion();
+
+  setLcdRow(0, trendChannels[channel].title);
+  if (!trend.getRange(min, max))
+  {
+    lcdPixelRender = lcdRender_None;
+    setLcdRow(1, "");
+    setLcdRow(2, "  collecting data");
+    setLcdRow(3, "");
+    return;
+  }
+
+  // range of the trend
+  formatFixedFloat(buffer, 4, min, 0);
+  memcpy(&lcdDisplay[0][10], buffer, 4);
+  lcdDisplay[0][14] = ' ';
+  lcdDisplay[0][15] = '-';
+  formatFixedFloat(buffer, 4, max, 0);
+  memcpy(&lcdDisplay[0][16], buffer, 4);
+
+  // small changes are not magnified
+  float span = max - min;
+  if (span < trendChannels[channel].minSpan)
+  {
+    min -= (trendChannels[channel].minSpan - span) / 2;
+    span = trendChannels[channel].minSpan;
+  }
+
+  // one bucket per column, the oldest bucket left, glyph k is a bar with k + 1 pixel rows
+  bool pixels = isPixelPanel();
+  const uint8_t levels = TREND_GRAPH_ROWS * (pixels ? this->lcd.getPixelHeight() / LCD_ROWS : LCD_GLYPH_ROWS);
+  for (uint8_t col = 0; col < LCD_COLS; col++)
+  {
+    uint8_t age = LCD_COLS - 1 - col;
+    int16_t level = 0;
+
+    if (age < trend.getCount())
+    {
+      level = 1 + lroundf((trend.getBucket(age) - min) / span * (levels - 1));
+    }
+    if (pixels)
+    {
+      // the bar is drawn by drawTrendBars, the cells stay blank
+      lcdTrendBar[col] = level;
+      level = 0;
+    }
+    for (uint8_t row = 0; row < TREND_GRAPH_ROWS; row++)
+    {
+      // pixel rows of the bar within this row of the LCD Panel
+      int16_t cell = level - (TREND_GRAPH_ROWS - 1 - row) * LCD_GLYPH_ROWS;
+      char c = ' ';
+
+      if (cell >= LCD_GLYPH_ROWS)
       {
-        length = sprintf(bufferAlarmTxt, "High Alternator Temp");
-        strncpy(&lcdDisplay[2 + alarmLine][0], bufferAlarmTxt, 20);
-        alarmLine++;
+        c = LCD_GLYPH_CODE + LCD_GLYPH_COUNT - 1;
       }
-      if (this->data.currentEngineDiscreteStatus.flgHighSeaWaterTemp.isFlagSet() && (alarmCount <= 2))
+      else if (cell > 0)
       {
-        length = sprintf(bufferAlarmTxt, "High Seawater InTemp");
-        strncpy(&lcdDisplay[2 + alarmLine][0], bufferAlarmTxt, 20);
-        alarmLine++;
+        c = LCD_GLYPH_CODE + cell - 1;
       }
+      lcdDisplay[1 + row][col] = c;
+    }
+  }
+  lcdPixelRender = pixels ? lcdRender_Trend : lcdRender_None;
+} // renderTrendPage
+
+//****************************************
+// Render the engine speed and the coolant temperature with big digits
+void DisplayData::renderBigDigitPage()
+{
+  // the digits are rewritten each cycle, only changed digits are sent to the LCD Panel
+  for (uint8_t row = 0; row < LCD_ROWS; row++)
+  {
+    setLcdRow(row, "");
+  }
+  lcdBigNumberCount = 0;
+
+  writeBigNumber(0, 0, lround(this->data.nMot.getValue()), 4);
+  memcpy(&lcdDisplay[1][16], " rpm", 4);
+
+  writeBigNumber(2, 4, lround(this->data.tEngine.getValue()), 3);
+  memcpy(&lcdDisplay[3][16], "GrdC", 4);
 
-      // more then 2 alarms
-      if (alarmCount > 2)
+  lcdPixelRender = isPixelPanel() ? lcdRender_BigDigits : lcdRender_None;
+} // renderBigDigitPage
+
+//****************************************
+// Write a number with big digits into the back buffer
+void DisplayData::writeBigNumber(uint8_t row, uint8_t col, int32_t value, uint8_t digits)
+{
+  int32_t limit = 1;
+
+  for (uint8_t i = 0; i < digits; i++)
+  {
+    limit *= 10;
+  }
+  // limit the number
+  if (value < 0)
+  {
+    value = 0;
+  }
+  if (value >= limit)
+  {
+    value = limit - 1;
+  }
+
+  // drawn with segments by drawBigNumbers, the cells stay blank
+  if (isPixelPanel())
+  {
+    if (lcdBigNumberCount < LCD_BIG_NUMBER_MAX)
+    {
+      lcdBigNumber[lcdBigNumberCount++] = {row, col, digits, value};
+    }
+    return;
+  }
+
+  // from the last digit to the first, one blank column in between
+  for (int8_t i = digits - 1; i >= 0; i--)
+  {
+    uint8_t digitCol = col + i * (LCD_BIG_DIGIT_COLS + 1);
+    bool leadingZero = (value == 0) && (i < digits - 1);
+
+    for (uint8_t r = 0; r < LCD_BIG_DIGIT_ROWS; r++)
+    {
+      if (leadingZero)
       {
-        length = sprintf(buffer, "  %1d more Alarms     ", alarmCount - 1);
-        strncpy(&lcdDisplay[3][0], buffer, 20);
+        memset(&lcdDisplay[row + r][digitCol], ' ', LCD_BIG_DIGIT_COLS);
       }
-
-      // when just 1 alarm is active
-      if (alarmCount == 1)
+      else
       {
-        length = sprintf(buffer, "                    ");
-        strncpy(&lcdDisplay[3][0], buffer, 20);
+        memcpy(&lcdDisplay[row + r][digitCol], lcdBigDigitFont[value % 10][r], LCD_BIG_DIGIT_COLS);
       }
     }
-    break;
+    value /= 10;
+  }
+} // writeBigNumber
 
+//****************************************
+// Draw the content of the page which is drawn with pixels
+void DisplayData::drawPixelPage()
+{
+  switch (lcdPixelRender)
+  {
+  case lcdRender_Trend:
+    drawTrendBars();
+    break;
+  case lcdRender_BigDigits:
+    drawBigNumbers();
+    break;
   default:
+    break;
+  }
+} // drawPixelPage
 
-    // ------------------------------
-    // Error Screen
-    // ------------------------------
-    // fill the screen buffer with permanent text
-    length = sprintf(buffer, "something went wrong");
-    strncpy(&lcdDisplay[0][0], buffer, 20);
+//****************************************
+// Draw the bars of the trend page below the title row
+void DisplayData::drawTrendBars()
+{
+  uint8_t cellWidth = this->lcd.getPixelWidth() / LCD_COLS;
+  uint8_t rowHeight = this->lcd.getPixelHeight() / LCD_ROWS;
+  uint8_t gridX = (this->lcd.getPixelWidth() - LCD_COLS * cellWidth) / 2;
+  uint8_t height = TREND_GRAPH_ROWS * rowHeight;
+  uint8_t bottom = (1 + TREND_GRAPH_ROWS) * rowHeight;
+
+  // one pixel column between the bars, the free part and the bar do not overlap
+  for (uint8_t col = 0; col < LCD_COLS; col++)
+  {
+    uint8_t x = gridX + col * cellWidth;
+    uint8_t bar = (lcdTrendBar[col] > height) ? height : lcdTrendBar[col];
 
-    length = sprintf(buffer, "--------------------");
-    strncpy(&lcdDisplay[1][0], buffer, 20);
+    this->lcd.fillRect(x, bottom - height, cellWidth - 1, height - bar, false);
+    this->lcd.fillRect(x, bottom - bar, cellWidth - 1, bar, true);
+  }
+} // drawTrendBars
 
-    length = sprintf(buffer, "  by Matthias Werner");
-    strncpy(&lcdDisplay[2][0], buffer, 20);
+//****************************************
+// Draw the numbers of the big digit page with segments
+void DisplayData::drawBigNumbers()
+{
+  uint8_t cellWidth = this->lcd.getPixelWidth() / LCD_COLS;
+  uint8_t rowHeight = this->lcd.getPixelHeight() / LCD_ROWS;
+  uint8_t gridX = (this->lcd.getPixelWidth() - LCD_COLS * cellWidth) / 2;
 
-    length = sprintf(buffer, "                    ");
-    strncpy(&lcdDisplay[3][0], buffer, 20);
+  for (uint8_t n = 0; n < lcdBigNumberCount; n++)
+  {
+    const tLcdBigNumber &number = lcdBigNumber[n];
+    int32_t value = number.value;
 
-  }; // switch
+    // from the last digit to the first, leading zeros without segments
+    for (int8_t i = number.digits - 1; i >= 0; i--)
+    {
+      bool leadingZero = (value == 0) && (i < number.digits - 1);
+      uint8_t col = number.col + i * (LCD_BIG_DIGIT_COLS + 1);
 
-  // update the LCD Panel
-  updateLCDPanel();
-}
+      drawBigDigit(gridX + col * cellWidth, number.row * rowHeight,
+                   leadingZero ? 0 : lcdSegmentFont[value % 10]);
+      value /= 10;
+    }
+  }
+} // drawBigNumbers
+
+//****************************************
+// Draw the segments of one big digit
+void DisplayData::drawBigDigit(uint8_t x, uint8_t y, uint8_t segments)
+{
+  // the digit fills its cells with a margin of one pixel
+  const uint8_t t = LCD_SEGMENT_WIDTH;
+  uint8_t w = LCD_BIG_DIGIT_COLS * (this->lcd.getPixelWidth() / LCD_COLS) - 2;
+  uint8_t h = LCD_BIG_DIGIT_ROWS * (this->lcd.getPixelHeight() / LCD_ROWS) - 2;
+  uint8_t mid = (h - t) / 2;
+  x++;
+  y++;
+
+  // segments a..g (x, y, width, height), the corners stay free
+  const uint8_t rect[7][4] = {
+      {(uint8_t)(x + t), y, (uint8_t)(w - 2 * t), t},
+      {(uint8_t)(x + w - t), (uint8_t)(y + t), t, (uint8_t)(mid - t)},
+      {(uint8_t)(x + w - t), (uint8_t)(y + mid + t), t, (uint8_t)(h - mid - 2 * t)},
+      {(uint8_t)(x + t), (uint8_t)(y + h - t), (uint8_t)(w - 2 * t), t},
+      {x, (uint8_t)(y + mid + t), t, (uint8_t)(h - mid - 2 * t)},
+      {x, (uint8_t)(y + t), t, (uint8_t)(mid - t)},
+      {(uint8_t)(x + t), (uint8_t)(y + mid), (uint8_t)(w - 2 * t), t},
+  };
+  for (uint8_t s = 0; s < 7; s++)
+  {
+    this->lcd.fillRect(rect[s][0], rect[s][1], rect[s][2], rect[s][3], (segments & (1 << s)) != 0);
+  }
+} // drawBigDigit
+
+//****************************************
+// Add the current values to the trends
+void DisplayData::sampleTrends()
+{
+  uint32_t now = millis();
+
+  for (uint8_t i = 0; i < TREND_CHANNEL_COUNT; i++)
+  {
+    trendHistory[i].addSample((this->data.*trendChannels[i].source).getValue(), now);
+  }
+} // sampleTrends
+
+//****************************************
+// Define a glyph of the CGRAM
+void DisplayData::setLcdGlyph(uint8_t slot, const uint8_t bitmap[LCD_GLYPH_ROWS])
+{
+  uint8_t mask = 1 << slot;
+
+  if ((lcdGlyphUsed & mask) && memcmp(lcdGlyph[slot], bitmap, LCD_GLYPH_ROWS) == 0)
+  {
+    return;
+  }
+  memcpy(lcdGlyph[slot], bitmap, LCD_GLYPH_ROWS);
+  lcdGlyphUsed |= mask;
+  lcdGlyphDirty |= mask;
+} // setLcdGlyph
+
+//****************************************
+// Write the changed glyphs to the CGRAM
+void DisplayData::uploadLcdGlyphs()
+{
+  for (uint8_t slot = 0; slot < LCD_GLYPH_COUNT; slot++)
+  {
+    if (lcdGlyphDirty & (1 << slot))
+    {
+      this->lcd.createChar(slot, lcdGlyph[slot]);
+      lcdStat.glyphUploads++;
+      // the DDRAM address is lost
+      lcdCursorAddress = 0xFF;
+    }
+  }
+  lcdGlyphDirty = 0;
+} // uploadLcdGlyphs
 
 //****************************************
 // Update the LCD Panel
@@ -404,50 +904,154 @@ void DisplayData::updateLCDPanel()
   if (xSemaphoreTake(xMutexLCDUpdate, (TickType_t)pdMS_TO_TICKS(100)) == pdTRUE)
   { // Mutex is taken
 
-    char lcdbuf[21];
-    memset(lcdbuf, ' ', 20);
-    lcdbuf[20] = '\0';
-    // check if a full update is required
-    bool fullUpdateRequired = (lcdUpdateCounter > LCD_MAX_CYCLE_COUNT_TILL_FULL_UPDATE);
+    uint32_t startUs = micros();
+    uint32_t startBytes = this->lcd.getI2cByteCount();
+    uint32_t startTransactions = this->lcd.getI2cTransactionCount();
 
-    if (lcdScreenRenew || fullUpdateRequired)
+    // write the whole LCD from time to time, characters may be lost by EMI
+    if (++lcdResyncCounter >= LCD_SHADOW_RESYNC_CYCLES)
     {
+      lcdResyncCounter = 0;
+      lcdShadowValid = false;
+      lcdGlyphDirty = lcdGlyphUsed;
+    }
 
-      // Update row 1
-      this->lcd.setCursor(0, 0);
-      strncpy(lcdbuf, &lcdDisplay[0][0], 20);
-      lcdbuf[20] = '\0';
-      this->lcd.print(lcdbuf); // print the line to screen
-
-      // Update row 2
-      this->lcd.setCursor(0, 1);
-      strncpy(lcdbuf, &lcdDisplay[1][0], 20);
-      lcdbuf[20] = '\0';
-      this->lcd.print(lcdbuf); // print the line to screen
-
-      // Update row 3
-      this->lcd.setCursor(0, 2);
-      strncpy(lcdbuf, &lcdDisplay[2][0], 20);
-      lcdbuf[20] = '\0';
-      this->lcd.print(lcdbuf); // print the line to screen
-
-      // reset count
-      lcdUpdateCounter = 0;
-      lcdScreenRenew = false;
+    // a failed I2C transaction of the last update, the shadow is unknown
+    uint32_t i2cErrors = this->lcd.getI2cErrorCount();
+    if (i2cErrors != lcdI2cErrorCount)
+    {
+      lcdI2cErrorCount = i2cErrors;
+      lcdShadowValid = false;
+      lcdCursorAddress = 0xFF;
+      lcdGlyphDirty = lcdGlyphUsed;
+      lcdStat.errorResyncs++;
     }
-    // Update measured values more often for good response
-    // Update row 4
-    this->lcd.setCursor(0, 3);
-    strncpy(lcdbuf, &lcdDisplay[3][0], 20);
-    lcdbuf[20] = '\0';
-    this->lcd.print(lcdbuf); // print the line to screen
 
+    // the glyphs first, characters shown with a changed glyph change as well
+    uploadLcdGlyphs();
+
+    for (uint8_t row = 0; row < LCD_ROWS; row++)
+    {
+      uint8_t col = 0;
+      while (col < LCD_COLS)
+      {
+        // skip the unchanged characters
+        if (lcdShadowValid && lcdDisplay[row][col] == lcdShadow[row][col])
+        {
+          col++;
+          continue;
+        }
+
+        // end of the run, short gaps are cheaper to rewrite than a cursor move
+        uint8_t end = col + 1;
+        for (uint8_t i = col + 1; i < LCD_COLS && (i - end) <= LCD_RUN_MAX_GAP; i++)
+        {
+          if (!lcdShadowValid || lcdDisplay[row][i] != lcdShadow[row][i])
+          {
+            end = i + 1;
+          }
+        }
+
+        writeLcdRun(row, col, end - col);
+        col = end;
+      }
+    }
+    lcdShadowValid = true;
+    // graphs and big digits over the blank cells
+    drawPixelPage();
+    // a panel with a frame buffer sends its changes now
+    this->lcd.endUpdate();
+
+    // the content of row 1 is renewed after some cycles
+    if (lcdUpdateCounter > LCD_MAX_CYCLE_COUNT_TILL_FULL_UPDATE)
+    {
+      lcdUpdateCounter = 0;
+    }
     // increase LCD Update counter
     lcdUpdateCounter++;
 
+    // I2C traffic of this update
+    uint32_t i2cBytes = this->lcd.getI2cByteCount() - startBytes;
+    lcdStat.transactionCount += this->lcd.getI2cTransactionCount() - startTransactions;
+    lcdStat.refreshCount++;
+    if (i2cBytes == 0)
+    {
+      lcdStat.idleCount++;
+    }
+    lcdStat.bytesLast = i2cBytes;
+    lcdStat.bytesTotal += i2cBytes;
+    if (i2cBytes > lcdStat.bytesMax)
+    {
+      lcdStat.bytesMax = i2cBytes;
+    }
+    lcdStat.busyUsLast = micros() - startUs;
+    if (lcdStat.busyUsLast > lcdStat.busyUsMax)
+    {
+      lcdStat.busyUsMax = lcdStat.busyUsLast;
+    }
+
     // Give back the Mutex
     xSemaphoreGive(xMutexLCDUpdate);
 
   } // if
 
 } // updateLCDPanel
+
+//****************************************
+// Write a run of characters to the LCD Panel
+void DisplayData::writeLcdRun(uint8_t row, uint8_t col, uint8_t len)
+{
+  uint8_t address = lcdRowAddress[row] + col;
+
+  // the cursor is already there after the last run
+  if (address != lcdCursorAddress)
+  {
+    this->lcd.writeAt(col, row, (const uint8_t *)&lcdDisplay[row][col], len);
+    lcdStat.cursorCount++;
+  }
+  else
+  {
+    this->lcd.write((const uint8_t *)&lcdDisplay[row][col], len);
+  }
+  memcpy(&lcdShadow[row][col], &lcdDisplay[row][col], len);
+  lcdCursorAddress = lcdNextAddress(address + len);
+
+  lcdStat.charCount += len;
+} // writeLcdRun
+
+//****************************************
+// Print the I2C statistic of the LCD Panel updates to the terminal
+void DisplayData::printLcdStatistic()
+{
+  char buffer[96];
+  tLcdStatistic stat = lcdStat;
+
+  snprintf(buffer, sizeof(buffer), "LCD updates %lu  idle %lu  chars %lu  cursor moves %lu  glyphs %lu",
+           (unsigned long)stat.refreshCount, (unsigned long)stat.idleCount,
+           (unsigned long)stat.charCount, (unsigned long)stat.cursorCount,
+           (unsigned long)stat.glyphUploads);
+  Serial.println(buffer);
+  snprintf(buffer, sizeof(buffer), "Texts cut  rows %lu  fields %lu",
+           (unsigned long)stat.rowOverflows, (unsigned long)stat.fieldOverflows);
+  Serial.println(buffer);
+  snprintf(buffer, sizeof(buffer), "I2C bytes  last %lu  max %lu  total %lu  mean %lu  transactions %lu",
+           (unsigned long)stat.bytesLast, (unsigned long)stat.bytesMax, (unsigned long)stat.bytesTotal,
+           (unsigned long)(stat.refreshCount > 0 ? stat.bytesTotal / stat.refreshCount : 0),
+           (unsigned long)stat.transactionCount);
+  Serial.println(buffer);
+  snprintf(buffer, sizeof(buffer), "I2C errors %lu  resyncs after an error %lu",
+           (unsigned long)this->lcd.getI2cErrorCount(), (unsigned long)stat.errorResyncs);
+  Serial.println(buffer);
+  snprintf(buffer, sizeof(buffer), "Mutex held  last %lu us  max %lu us  (I2C %lu kHz)",
+           (unsigned long)stat.busyUsLast, (unsigned long)stat.busyUsMax,
+           (unsigned long)(this->lcd.getI2cClock() / 1000));
+  Serial.println(buffer);
+  // a page request rendered in the calling task blocked it as long as a full update
+  snprintf(buffer, sizeof(buffer), "Page request blocked the caller  max %lu us",
+           (unsigned long)stat.pageRequestUsMax);
+  Serial.println(buffer);
+  snprintf(buffer, sizeof(buffer), "Fields formatted  last %lu us  max %lu us  LCD task stack free %lu",
+           (unsigned long)stat.formatUsLast, (unsigned long)stat.formatUsMax,
+           (unsigned long)(renderTask != NULL ? uxTaskGetStackHighWaterMark(renderTask) : 0));
+  Serial.println(buffer);
+} // printLcdStatistic
@@ -0,0 +1,189 @@
+// Doxygen Documentation
+/*! \file 	display_pages.cpp
+ *  \brief  Page table of the LCD Panel
+ *
+ * This File contains the description of all LCD pages: the static text
+ * of each row and the fields with the measured values. To add a page, a
+ * row has to be added to \ref lcdPages, no code is needed.
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         ESP32-WROOM
+ * - Hardware:          az-delivery-devkit-v4
+ */
+
+#include <display_data.h>
+
+/// Convert a number define into a string
+#define LCD_STR(x) LCD_STR_(x)
+/// Helper of \ref LCD_STR
+#define LCD_STR_(x) #x
+
+/// Separator row below the title
+static const char lcdSeparator[] = "--------------------";
+
+//*************************************************************
+// Fields of the pages
+//
+//  value                        factor      row col width dec unit slow
+static const tLcdField engineFields[] = {
+    {&AcquireData::engSecond, 1.0 / 3600, 0, 13, 6, 1, "h", true},
+    {&AcquireData::nMot, 1, 3, 0, 5, 0, "", false},
+    {&AcquireData::tEngine, 1, 3, 5, 5, 0, "", false},
+    {&AcquireData::pOil, 1, 3, 10, 5, 1, "", false},
+    {&AcquireData::tExhaust, 1, 3, 15, 5, 0, "", false},
+};
+
+static const tLcdField temperatureFields[] = {
+    {&AcquireData::tEngine, 1, 3, 0, 5, 0, "", false},
+    {&AcquireData::tGearbox, 1, 3, 5, 5, 0, "", false},
+    {&AcquireData::tSeaOutletWall, 1, 3, 10, 5, 1, "", false},
+    {&AcquireData::tExhaust, 1, 3, 15, 5, 0, "", false},
+};
+
+static const tLcdField speedFields[] = {
+    {&AcquireData::nMot, 1, 3, 0, 5, 0, "", false},
+    {&AcquireData::nShaft, 1, 3, 5, 5, 0, "", false},
+    {&AcquireData::nAlternator1, 1, 3, 10, 5, 0, "", false},
+    {&AcquireData::nAlternator2, 1, 3, 15, 5, 0, "", false},
+};
+
+static const tLcdField alternatorFields[] = {
+    {&AcquireData::nAlternator1, 1, 3, 0, 5, 0, "", false},
+    {&AcquireData::tAlternator, 1, 3, 5, 5, 0, "", false},
+    {&AcquireData::nAlternator2, 1, 3, 10, 5, 0, "", false},
+    {&AcquireData::uBat, 1, 3, 15, 5, 1, "", false},
+};
+
+static const tLcdField voltageFields[] = {
+    {&AcquireData::uBat, 1, 0, 14, 5, 2, "V", true},
+    {&AcquireData::uMcp3204Ch1, 1, 3, 0, 5, 1, "", false},
+    {&AcquireData::uMcp3204Ch2, 1, 3, 5, 5, 1, "", false},
+    {&AcquireData::uMcp3204Ch3, 1, 3, 10, 5, 1, "", false},
+    {&AcquireData::uMcp3204Ch4, 1, 3, 15, 5, 1, "", false},
+};
+
+/// Number of fields of a field table
+#define LCD_FIELDS(table) table, sizeof(table) / sizeof(table[0])
+
+//*************************************************************
+// Glyphs of the pages
+
+/// Bars with 1..8 pixel rows for the bar graph of the trend page
+static const uint8_t lcdBarGlyphs[LCD_GLYPH_COUNT][LCD_GLYPH_ROWS] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F, 0x1F},
+    {0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F, 0x1F, 0x1F},
+    {0x00, 0x00, 0x00, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F},
+    {0x00, 0x00, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F},
+    {0x00, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F},
+    {0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F},
+};
+
+/// Segments of the big digits
+static const uint8_t lcdBigDigitGlyphs[LCD_GLYPH_COUNT][LCD_GLYPH_ROWS] = {
+    {0x07, 0x0F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F}, // 0 upper left corner
+    {0x1F, 0x1F, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x00}, // 1 upper bar
+    {0x1C, 0x1E, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F}, // 2 upper right corner
+    {0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x0F, 0x07}, // 3 lower left corner
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F, 0x1F}, // 4 lower bar
+    {0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1E, 0x1C}, // 5 lower right corner
+    {0x1F, 0x1F, 0x1F, 0x00, 0x00, 0x00, 0x1F, 0x1F}, // 6 upper and lower bar
+    {0x1F, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F, 0x1F}, // 7 thin upper and lower bar
+};
+
+/// Character of a big digit segment
+#define SEG(n) (char)(LCD_GLYPH_CODE + (n))
+/// Full block of the character ROM of the LCD
+#define FULL (char)0xFF
+
+/// Characters of the big digits 0..9 (upper row, lower row)
+const char lcdBigDigitFont[10][LCD_BIG_DIGIT_ROWS][LCD_BIG_DIGIT_COLS] = {
+    {{SEG(0), SEG(1), SEG(2)}, {SEG(3), SEG(4), SEG(5)}},
+    {{SEG(1), SEG(2), ' '}, {SEG(4), FULL, SEG(4)}},
+    {{SEG(6), SEG(6), SEG(2)}, {SEG(3), SEG(4), SEG(4)}},
+    {{SEG(6), SEG(6), SEG(2)}, {SEG(4), SEG(4), SEG(5)}},
+    {{SEG(3), SEG(4), FULL}, {' ', ' ', FULL}},
+    {{SEG(3), SEG(6), SEG(6)}, {SEG(4), SEG(4), SEG(5)}},
+    {{SEG(0), SEG(6), SEG(6)}, {SEG(3), SEG(4), SEG(5)}},
+    {{SEG(1), SEG(1), SEG(2)}, {' ', ' ', FULL}},
+    {{SEG(0), SEG(6), SEG(2)}, {SEG(3), SEG(4), SEG(5)}},
+    {{SEG(0), SEG(6), SEG(2)}, {' ', ' ', FULL}},
+};
+
+/// Segments of the big digits 0..9 on a panel with pixels (bit 0 = a .. bit 6 = g)
+const uint8_t lcdSegmentFont[10] = {0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, 0x7F, 0x6F};
+
+/// I2C bytes of a rewrite of the whole LCD (4 runs of 20 characters)
+#define LCD_FULL_REFRESH_BYTES (LCD_ROWS * DISPLAY_RUN_BYTES(LCD_COLS))
+/// I2C bytes of a refresh of the value row
+#define LCD_VALUE_ROW_BYTES DISPLAY_RUN_BYTES(LCD_COLS)
+/// I2C bytes of a refresh of the value row and a field with unit in the title
+#define LCD_VALUE_TITLE_BYTES (DISPLAY_RUN_BYTES(LCD_COLS) + DISPLAY_RUN_BYTES(7))
+
+//*************************************************************
+// Table of all pages
+//
+// A row with NULL is filled by the fields or the render method only. The
+// budget is the max of I2C bytes of a refresh of the data (not a page
+// change) on the panel of the build: one row with the values is
+// 1 + 4 * (1 + 20) = 85 bytes on the LCD and 2 pages of 16 tiles on the
+// OLED, pages whose list can change completely get a whole panel.
+const tLcdPage lcdPages[] = {
+    {WELCOME_PAGE,
+     {"VolvoPenta Connect", "---  Tatooine  ---", "by Matthias Werner",
+      "      Version " LCD_STR(SW_VERSION_MAJOR) "." LCD_STR(SW_VERSION_MINOR) "." LCD_STR(SW_VERSION_PATCH)},
+     NULL, 0, lcdRender_None, NULL, 0},
+    {PAGE_ENGINE,
+     {"Engine Data", lcdSeparator, "  rpm GrdC  bar GrdC", NULL},
+     LCD_FIELDS(engineFields), lcdRender_None, NULL, LCD_VALUE_TITLE_BYTES},
+    {PAGE_TEMPERATURE,
+     {"Temperature   [GrdC]", lcdSeparator, "  Eng Gear  Sea  Exh", NULL},
+     LCD_FIELDS(temperatureFields), lcdRender_None, NULL, LCD_VALUE_ROW_BYTES},
+    {PAGE_SPEED,
+     {"Speed        [U/min]", lcdSeparator, "  Eng Gear Alt1 Alt2", NULL},
+     LCD_FIELDS(speedFields), lcdRender_None, NULL, LCD_VALUE_ROW_BYTES},
+    {PAGE_ALTERNATOR,
+     {"Alternator  Data", lcdSeparator, "  rpm GrdC  rpm    V", NULL},
+     LCD_FIELDS(alternatorFields), lcdRender_None, NULL, LCD_VALUE_ROW_BYTES},
+    {PAGE_VOLTAGE,
+     {"MCP3204", lcdSeparator, "    V    V    V    V", NULL},
+     LCD_FIELDS(voltageFields), lcdRender_None, NULL, LCD_VALUE_TITLE_BYTES},
+    {PAGE_ALARM,
+     {NULL, NULL, NULL, NULL},
+     NULL, 0, lcdRender_Alarm, NULL, LCD_FULL_REFRESH_BYTES},
+    {PAGE_BIG_DIGITS,
+     {NULL, NULL, NULL, NULL},
+     NULL, 0, lcdRender_BigDigits, lcdBigDigitGlyphs, LCD_FULL_REFRESH_BYTES},
+    {PAGE_1WIRE_LIST,
+     {NULL, NULL, NULL, NULL},
+     NULL, 0, lcdRender_OneWire, NULL, LCD_FULL_REFRESH_BYTES},
+    {PAGE_N2K_BUS,
+     {NULL, NULL, NULL, NULL},
+     NULL, 0, lcdRender_N2kBus, NULL, LCD_FULL_REFRESH_BYTES},
+    {PAGE_TREND,
+     {NULL, NULL, NULL, NULL},
+     NULL, 0, lcdRender_Trend, lcdBarGlyphs, LCD_FULL_REFRESH_BYTES},
+};
+
+// the loops and the self check use the count of the header
+static_assert(sizeof(lcdPages) / sizeof(lcdPages[0]) == LCD_PAGE_COUNT,
+              "LCD_PAGE_COUNT has to be the number of rows of lcdPages");
+
+/// Page shown for an unknown page number
+const tLcdPage lcdErrorPage = {
+    0xFF,
+    {"something went wrong", lcdSeparator, "  by Matthias Werner", ""},
+    NULL, 0, lcdRender_None, NULL, 0};
+
+//*************************************************************
+// Values with a trend on the trend page
+//
+//  title         value                    min span
+const tTrendChannel trendChannels[TREND_CHANNEL_COUNT] = {
+    {"Cool GrdC", &AcquireData::tEngine, 10},
+    {"Exh  GrdC", &AcquireData::tExhaust, 50},
+    {"Eng  rpm", &AcquireData::nMot, 200},
+};
@@ -13,55 +13,80 @@
 
 #include <errorflag.h>
 
+/// Number of changes of all flags
+std::atomic<uint32_t> ErrorFlag::changeCount{0};
+
 // ********************************************************
 // Constructor
 ErrorFlag::ErrorFlag()
 {
   // Initialization code
-  resetFlag();
+  flagState = 0;
+  flagSetTimeStamp = 0;
 }
 
 // ********************************************************
 // Acknowledge the error flag
 void ErrorFlag::acknowledgeFlag()
 {
-  flagIsAcknowledged = true;
+  uint8_t expected = ERROR_FLAG_SET;
+
+  // fails if the flag is not set, already acknowledged or reset meanwhile
+  if (flagState.compare_exchange_strong(expected, ERROR_FLAG_SET | ERROR_FLAG_ACKNOWLEDGED))
+  {
+    changeCount++;
+  }
 }
 
 // ********************************************************
 // Set the error flag
 void ErrorFlag::setFlag()
-{ 
-  flagStatus = true;
-  flagSetTimeStamp = millis();
+{
+  // only a new occurrence gets a new timestamp
+  if ((flagState.load() & ERROR_FLAG_SET) == 0)
+  {
+    // a reset flag cannot be acknowledged, so nobody else writes the state
+    flagSetTimeStamp.store(millis());
+    flagState.store(ERROR_FLAG_SET);
+    changeCount++;
+  }
 }
 
 // ********************************************************
 // Reset the error flag
 void ErrorFlag::resetFlag()
 {
-  flagStatus = false;
-  flagSetTimeStamp = 0;
-  flagIsAcknowledged = false;
+  if (flagState.exchange(0) & ERROR_FLAG_SET)
+  {
+    changeCount++;
+  }
+  flagSetTimeStamp.store(0);
 }
 
 // ********************************************************
 // Check if the error flag is set
 bool ErrorFlag::isFlagSet()
 {
-  return flagStatus;
+  return (flagState.load() & ERROR_FLAG_SET) != 0;
 }
 
 // ********************************************************
 // Check if the error flag is acknowledged
 bool ErrorFlag::isFlagAcknowledged()
 {
-  return flagIsAcknowledged;
+  return (flagState.load() & ERROR_FLAG_ACKNOWLEDGED) != 0;
 }
 
 // ********************************************************
 // Get the timestamp when the error flag was set
 unsigned long ErrorFlag::getTimeStampWhenSet()
 {
-  return flagSetTimeStamp;
+  return flagSetTimeStamp.load();
+}
+
+// ********************************************************
+// Get the number of changes of all error flags
+uint32_t ErrorFlag::getChangeCount()
+{
+  return changeCount.load();
 }
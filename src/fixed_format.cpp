@@ -0,0 +1,128 @@
+// Doxygen Documentation
+/*! \file 	fixed_format.cpp
+ *  \brief  Formatting of integer and fixed point numbers
+ *
+ * This File contains small formatter functions for numbers with a fixed
+ * width. They need no heap, no String and no floating point formatting
+ * of newlib, so they can be used in tasks with a small stack.
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         ESP32-WROOM
+ * - Hardware:          az-delivery-devkit-v4
+ */
+
+#include <fixed_format.h>
+
+/// Powers of ten for the fixed point values
+static const int32_t fixedPowersOfTen[FIXED_FORMAT_MAX_DECIMALS + 1] = {1, 10, 100, 1000, 10000, 100000, 1000000};
+
+//****************************************
+// Format a fixed point integer
+uint8_t formatFixed(char *buffer, uint8_t width, int32_t value, uint8_t decimals)
+{
+  char digits[FIXED_FORMAT_BUFFER_SIZE];
+  uint8_t count = 0;
+  uint32_t magnitude = (value < 0) ? (uint32_t)(-(int64_t)value) : (uint32_t)value;
+
+  if (decimals > FIXED_FORMAT_MAX_DECIMALS)
+  {
+    decimals = FIXED_FORMAT_MAX_DECIMALS;
+  }
+
+  // digits in reverse order, at least one digit in front of the point
+  do
+  {
+    digits[count++] = '0' + (magnitude % 10);
+    magnitude /= 10;
+    if (count == decimals)
+    {
+      digits[count++] = '.';
+      if (magnitude == 0)
+      {
+        digits[count++] = '0';
+      }
+    }
+  } while (magnitude > 0 || count <= decimals);
+
+  if (value < 0)
+  {
+    digits[count++] = '-';
+  }
+
+  uint8_t len = 0;
+  if (width == 0)
+  {
+    width = count;
+  }
+  else if (count > width)
+  {
+    // the number does not fit
+    memset(buffer, '*', width);
+    buffer[width] = '\0';
+    return width;
+  }
+
+  // right aligned
+  while (len < width - count)
+  {
+    buffer[len++] = ' ';
+  }
+  while (count > 0)
+  {
+    buffer[len++] = digits[--count];
+  }
+  buffer[len] = '\0';
+  return len;
+}
+
+//****************************************
+// Format a floating point value with a fixed number of decimals
+uint8_t formatFixedFloat(char *buffer, uint8_t width, double value, uint8_t decimals)
+{
+  if (decimals > FIXED_FORMAT_MAX_DECIMALS)
+  {
+    decimals = FIXED_FORMAT_MAX_DECIMALS;
+  }
+
+  double scaled = value * fixedPowersOfTen[decimals];
+  // NaN and values outside of the 32 bit range
+  if (!(scaled > -2147483647.0 && scaled < 2147483647.0))
+  {
+    uint8_t len = (width == 0) ? 1 : width;
+    memset(buffer, '*', len);
+    buffer[len] = '\0';
+    return len;
+  }
+  return formatFixed(buffer, width, (int32_t)lround(scaled), decimals);
+}
+
+#ifdef FIXED_FORMAT_BENCHMARK
+//****************************************
+// Compare the formatting time with snprintf
+void printFixedFormatBenchmark()
+{
+  char buffer[FIXED_FORMAT_BUFFER_SIZE];
+  char line[96];
+  double value = -12.34;
+
+  uint32_t startUs = micros();
+  for (uint16_t i = 0; i < FIXED_FORMAT_BENCH_LOOPS; i++)
+  {
+    snprintf(buffer, sizeof(buffer), "%5.1f", value + i);
+  }
+  uint32_t printfUs = micros() - startUs;
+
+  startUs = micros();
+  for (uint16_t i = 0; i < FIXED_FORMAT_BENCH_LOOPS; i++)
+  {
+    formatFixedFloat(buffer, 5, value + i, 1);
+  }
+  uint32_t fixedUs = micros() - startUs;
+
+  snprintf(line, sizeof(line), "Format %u values  snprintf %lu us  formatFixedFloat %lu us",
+           FIXED_FORMAT_BENCH_LOOPS, (unsigned long)printfUs, (unsigned long)fixedUs);
+  Serial.println(line);
+}
+#endif // FIXED_FORMAT_BENCHMARK
@@ -0,0 +1,171 @@
+// Doxygen Documentation
+/*! \file 	lcd_pcf8574.cpp
+ *  \brief  HD44780 LCD behind a PCF8574 I2C expander
+ *
+ * This File contains all the necessary methods to drive an HD44780
+ * compatible LCD Panel in the 4 bit mode through a PCF8574 I2C port
+ * expander. All expander writes of a run of characters are packed into
+ * one I2C transaction.
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         ESP32-WROOM
+ * - Hardware:          az-delivery-devkit-v4
+ */
+
+#include <lcd_pcf8574.h>
+
+/// DDRAM address of the first character of each row (HD44780 20x4)
+static const uint8_t rowAddress[4] = {0x00, 0x40, 0x14, 0x54};
+
+//****************************************
+// Constructor
+LcdPcf8574::LcdPcf8574(uint8_t address) : address(address)
+{
+}
+
+//****************************************
+// Initialise the LCD in the 4 bit mode
+void LcdPcf8574::begin(uint8_t cols, uint8_t rows, TwoWire &wire)
+{
+  this->wire = &wire;
+  this->rows = (rows > 4) ? 4 : rows;
+
+  // wait for the LCD after power on
+  delay(50);
+  this->batchLen = 0;
+  this->batch[this->batchLen++] = this->backlight;
+  flush();
+
+  // reset sequence into the 4 bit mode (HD44780 datasheet figure 24)
+  addNibble(0x30, 0);
+  flush();
+  delayMicroseconds(4500);
+  addNibble(0x30, 0);
+  flush();
+  delayMicroseconds(150);
+  addNibble(0x30, 0);
+  flush();
+  addNibble(0x20, 0);
+  flush();
+
+  addByte(LCD_CMD_FUNCTION_SET, 0);
+  addByte(LCD_CMD_DISPLAY_ON, 0);
+  addByte(LCD_CMD_ENTRY_MODE, 0);
+  flush();
+  clear();
+}
+
+//****************************************
+// Switch the backlight
+void LcdPcf8574::setBacklight(uint8_t brightness)
+{
+  this->backlight = (brightness > 0) ? LCD_PCF_BACKLIGHT : 0;
+  this->batch[this->batchLen++] = this->backlight;
+  flush();
+}
+
+//****************************************
+// Clear the LCD and move the cursor home
+void LcdPcf8574::clear()
+{
+  addByte(LCD_CMD_CLEAR, 0);
+  flush();
+  // clear needs 1.52 ms
+  delayMicroseconds(2000);
+}
+
+//****************************************
+// Move the cursor
+void LcdPcf8574::setCursor(uint8_t col, uint8_t row)
+{
+  if (row >= this->rows)
+  {
+    row = this->rows - 1;
+  }
+  addByte(LCD_CMD_SET_DDRAM | (rowAddress[row] + col), 0);
+  flush();
+}
+
+//****************************************
+// Write characters at the cursor position
+void LcdPcf8574::write(const uint8_t *buf, size_t len)
+{
+  for (size_t i = 0; i < len; i++)
+  {
+    addByte(buf[i], LCD_PCF_RS);
+  }
+  flush();
+}
+
+//****************************************
+// Move the cursor and write characters with one I2C transaction
+void LcdPcf8574::writeAt(uint8_t col, uint8_t row, const uint8_t *buf, size_t len)
+{
+  if (row >= this->rows)
+  {
+    row = this->rows - 1;
+  }
+  addByte(LCD_CMD_SET_DDRAM | (rowAddress[row] + col), 0);
+  write(buf, len);
+}
+
+//****************************************
+// Define a custom character in the CGRAM
+void LcdPcf8574::createChar(uint8_t location, const uint8_t charmap[8])
+{
+  addByte(LCD_CMD_SET_CGRAM | ((location & 0x07) << 3), 0);
+  for (uint8_t i = 0; i < 8; i++)
+  {
+    addByte(charmap[i], LCD_PCF_RS);
+  }
+  flush();
+}
+
+//****************************************
+// Add one nibble with the enable strobe to the batch
+void LcdPcf8574::addNibble(uint8_t nibble, uint8_t mode)
+{
+  uint8_t value = (nibble & 0xF0) | mode | this->backlight;
+
+  // the LCD latches the nibble with the falling edge of enable
+  this->batch[this->batchLen++] = value | LCD_PCF_EN;
+  this->batch[this->batchLen++] = value;
+}
+
+//****************************************
+// Add one LCD byte to the batch
+void LcdPcf8574::addByte(uint8_t value, uint8_t mode)
+{
+  // a full batch is sent, the next byte starts a new transaction
+  if (this->batchLen + LCD_EXPANDER_BYTES_PER_LCD_BYTE > LCD_I2C_BATCH_SIZE)
+  {
+    flush();
+  }
+  addNibble(value, mode);
+  addNibble(value << 4, mode);
+}
+
+//****************************************
+// Send the batch with one I2C transaction
+void LcdPcf8574::flush()
+{
+  if (this->batchLen == 0 || this->wire == NULL)
+  {
+    this->batchLen = 0;
+    return;
+  }
+  this->wire->beginTransmission(this->address);
+  this->wire->write(this->batch, this->batchLen);
+  if (this->wire->endTransmission() != 0)
+  {
+    // the LCD may have missed a nibble, DisplayData writes it again
+    this->i2cErrorCount++;
+  }
+
+  // address byte and the expander writes
+  this->i2cByteCount += 1 + this->batchLen;
+  this->i2cTransactionCount++;
+  this->batchLen = 0;
+}
@@ -13,16 +13,116 @@
 
 
 #include "lookUpTable.h"
+#include <math.h>
 
 //*********************************************************************
 // Constructor
 LookUpTable1D::LookUpTable1D(const uint32_t *axis, const uint32_t *table,
+                             uint8_t length, uint8_t fixed_point_decimals,
+                             tLutInterpolation interpolation)
+{
+  this->m_requested_interpolation = interpolation;
+  setTable(axis, table, length, fixed_point_decimals);
+}
+
+//*********************************************************************
+// Assign a new axis and table to the 1D-LookUpTable
+void LookUpTable1D::setTable(const uint32_t *axis, const uint32_t *table,
                              uint8_t length, uint8_t fixed_point_decimals)
 {
   this->m_x_axis = axis;
   this->m_table = table;
   this->m_length_x_axis = length;
   this->m_fixed_point_decimals = fixed_point_decimals;
+
+  // the cubic interpolation needs a least one segment and the
+  // coefficients have to fit into the object
+  if ((this->m_requested_interpolation == lutInterp_pchip) && (length >= 2) &&
+      (length <= LUT_MAX_AXIS_LEN))
+  {
+    this->m_interpolation = lutInterp_pchip;
+    CalcPchipCoefficients();
+  }
+  else
+  {
+    this->m_interpolation = lutInterp_linear;
+  }
+}
+
+//*********************************************************************
+// Calculate the coefficients for the monotone cubic interpolation
+void LookUpTable1D::CalcPchipCoefficients()
+{
+  uint8_t n = this->m_length_x_axis;
+  uint8_t k;
+
+  // width and slope (secant) of each segment
+  double h[LUT_MAX_AXIS_LEN - 1];
+  double delta[LUT_MAX_AXIS_LEN - 1];
+  // slope of the curve at each point of the axis
+  double m[LUT_MAX_AXIS_LEN];
+
+  for (k = 0; k < n - 1; k++)
+  {
+    h[k] = (double)this->m_x_axis[k + 1] - (double)this->m_x_axis[k];
+    delta[k] = ((double)this->m_table[k + 1] - (double)this->m_table[k]) / h[k];
+  }
+
+  if (n == 2)
+  {
+    // just one segment -> straight line
+    m[0] = delta[0];
+    m[1] = delta[0];
+  }
+  else
+  {
+    // inner points -> weighted harmonic mean of the neighbouring secants
+    for (k = 1; k < n - 1; k++)
+    {
+      if ((delta[k - 1] * delta[k]) <= 0)
+      {
+        // local extremum or flat segment -> horizontal tangent
+        m[k] = 0;
+      }
+      else
+      {
+        double w1 = 2 * h[k] + h[k - 1];
+        double w2 = h[k] + 2 * h[k - 1];
+        m[k] = (w1 + w2) / (w1 / delta[k - 1] + w2 / delta[k]);
+      }
+    }
+
+    // end points -> non centered three point formula (shape preserving)
+    m[0] = ((2 * h[0] + h[1]) * delta[0] - h[0] * delta[1]) / (h[0] + h[1]);
+    if ((m[0] * delta[0]) <= 0)
+    {
+      m[0] = 0;
+    }
+    else if (((delta[0] * delta[1]) <= 0) && (fabs(m[0]) > fabs(3 * delta[0])))
+    {
+      m[0] = 3 * delta[0];
+    }
+
+    m[n - 1] = ((2 * h[n - 2] + h[n - 3]) * delta[n - 2] - h[n - 2] * delta[n - 3]) /
+               (h[n - 2] + h[n - 3]);
+    if ((m[n - 1] * delta[n - 2]) <= 0)
+    {
+      m[n - 1] = 0;
+    }
+    else if (((delta[n - 2] * delta[n - 3]) <= 0) &&
+             (fabs(m[n - 1]) > fabs(3 * delta[n - 2])))
+    {
+      m[n - 1] = 3 * delta[n - 2];
+    }
+  }
+
+  // coefficients of the hermite polynom for each segment
+  for (k = 0; k < n - 1; k++)
+  {
+    this->m_coef[k][0] = (float)m[k];
+    this->m_coef[k][1] = (float)((3 * delta[k] - 2 * m[k] - m[k + 1]) / h[k]);
+    this->m_coef[k][2] = (float)((m[k] + m[k + 1] - 2 * delta[k]) / (h[k] * h[k]));
+  }
 }
 
 //*********************************************************************
@@ -178,6 +278,20 @@ bool LookUpTable1D::LookUpMap(uint32_t x_value)
   {
     m_result = Y1;
   }
+  else if (this->m_interpolation == lutInterp_pchip)
+  {
+    // monotone cubic interpolation (horner scheme)
+    const float *coef = this->m_coef[this->m_x_position - 1];
+    float dx = (float)(x_value - this->m_lower_x_value);
+    float y = (float)Y1 + dx * (coef[0] + dx * (coef[1] + dx * coef[2]));
+
+    // the curve stays within Y1/Y2, just guard the rounding
+    if (y < 0)
+    {
+      y = 0;
+    }
+    m_result = (uint32_t)lroundf(y);
+  }
   else
   {
     // linear interpolation
@@ -18,9 +18,14 @@
 #include "nvs_flash.h"
 #include "nvs.h"
 
-// This will automatically choose right CAN library and create suitable
-// NMEA2000 object
-#include <NMEA2000_CAN.h>
+// CAN driver of the ESP32 which wakes up the N2K task on received frames
+#include <n2k_can_driver.h>
+#include <n2k_bus_monitor.h>
+#include <n2k_rate_control.h>
+#include <n2k_receive.h>
+#include <n2k_gateway.h>
+#include <n2k_alert.h>
+#include <signalk_delta.h>
 #include <N2kMessages.h>
 #include <OneWire.h>
 #include <DallasTemperature.h>
@@ -31,6 +36,8 @@
 #include <display_data.h>
 #include <button_interpreter.h>
 #include <lookUpTable.h>
+#include <calibration_store.h>
+#include <terminal_command.h>
 #include "process_warnings.h"
 
 // Forward declaration
@@ -39,20 +46,55 @@ class ProcessWarnings;
 /// Milliseconds for updating the terminal output
 #define UPDATE_TERMINAL_PERIOD 1000
 
+/// Baud rate of the USB terminal, the gateway build sets 921600 for "gw on"
+/// at full bus load
+#ifndef TERMINAL_BAUD_RATE
+#define TERMINAL_BAUD_RATE 115200
+#endif
+
+/// Milliseconds the idle loop sleeps in between two runs
+#define LOOP_IDLE_PERIOD_MS 20
+
 /// Millisecond counter for Updating the Terminal Output
 static unsigned long timeUpdatedCnt = millis();
 
 /// Class that contains a map to convert the measured voltage into tEngine
-LookUpTable1D mapTCO(AXIS_TCO_MES, MAP_TCO_MES, TCO_AXIS_LEN, TCO_MAP_PREC);
+LookUpTable1D mapTCO(AXIS_TCO_MES, MAP_TCO_MES, TCO_AXIS_LEN, TCO_MAP_PREC, lutInterp_pchip);
 
 /// Class that contains a map to convert the measured voltage into pOil
-LookUpTable1D mapPOIL(AXIS_POIL_MES, MAP_POIL_MES, POIL_AXIS_LEN, POIL_MAP_PREC);
+LookUpTable1D mapPOIL(AXIS_POIL_MES, MAP_POIL_MES, POIL_AXIS_LEN, POIL_MAP_PREC, lutInterp_pchip);
+
+/// Runtime calibration data for maps and ADC factors (NVS)
+CalibrationStore calibration;
 
 /// class that contains all measured data
 AcquireData data;
 
+/// Stream of all N2K frames to the USB terminal
+N2kGateway n2kGateway;
+
+/// CAN driver of the ESP32 for the NMEA2000 library
+N2kCanDriver n2kCanDriver(ESP32_CAN_TX_PIN, ESP32_CAN_RX_PIN, n2kGateway);
+
+/// NMEA2000 Object using the event driven CAN driver
+tNMEA2000 &NMEA2000 = n2kCanDriver;
+
+/// Monitor for load and errors of the NMEA2000 bus
+N2kBusMonitor n2kBusMonitor(n2kCanDriver);
+
+/// Controller for the transmit rate on a busy bus
+N2kRateController n2kRateController(n2kCanDriver, n2kBusMonitor);
+
+#ifdef DISPLAY_OLED
+/// 128x64 OLED on I2C Bus, shows the 4x20 characters of the LCD Panel
+OledSsd1306 lcdPanel(OLED_I2C_ADDRESS, DISPLAY_OLED);
+#else
+/// LCD 4x20 behind a PCF8574 on I2C Bus
+LcdPcf8574 lcdPanel(0x3F);
+#endif // DISPLAY_OLED
+
 /// class that contains all data for the LCD Panel
-DisplayData lcdDisplayData(data);
+DisplayData lcdDisplayData(data, n2kBusMonitor, lcdPanel);
 
 /// Process Warnings class
 ProcessWarnings processWarnings(data);
@@ -60,10 +102,25 @@ ProcessWarnings processWarnings(data);
 /// Button Interpreter class
 ButtonInterpreter buttonInterpreter(lcdDisplayData, processWarnings);
 
-/// structure that hold all data ready for N2k sending
-tVolvoPentaData VolvoDataForN2k;
-/// Mutex for protecting data integrity of \ref VolvoDataForN2k
-SemaphoreHandle_t xMutexVolvoN2kData = NULL;
+/// hand over of all data ready for N2k sending
+N2kDataExchange n2kDataExchange;
+
+/// Scheduler that sends all PGNs at their own rate
+N2kScheduler n2kScheduler(n2kDataExchange);
+
+/// Receiver of the PGNs of other devices
+N2kReceiver n2kReceiver(n2kCanDriver, n2kScheduler);
+
+/// N2K alerts of the engine alarms
+N2kAlertManager n2kAlertManager(data);
+
+/// Signal K deltas of the measured data
+SignalKDelta signalKDelta(n2kDataExchange);
+
+/// Interpreter for the commands from the serial terminal
+TerminalCommand terminalCommand(calibration, n2kScheduler, n2kCanDriver, n2kBusMonitor,
+                                n2kRateController, n2kReceiver, n2kGateway, n2kAlertManager,
+                                signalKDelta, lcdDisplayData);
 /// Mutex for protection stdout
 SemaphoreHandle_t xMutexStdOut = NULL;
 
@@ -91,11 +148,20 @@ TaskHandle_t TaskInterpretButtonHandle;
  */
 TaskHandle_t TaskInterpretStorePermanentData;
 
+/*! ************************************************************************
+ * \brief Task Handle for task N2K (receive and transmit)
+ */
+TaskHandle_t TaskN2kHandle;
+
+/*! ************************************************************************
+ * \brief Task Handle for task N2K receive (decoding of other devices)
+ */
+TaskHandle_t TaskN2kReceiveHandle;
+
 /*! ************************************************************************
  * \brief Task for measuring oneWire signals
  *
- * This tasks measures all oneWire signals, converts them to N2K format
- * and sends out corresponding N2K messages \ref SendN2kEngineParmSlow.
+ * This tasks measures all oneWire signals and converts them to N2K format.
  *
  * \param pvParameters
  */
@@ -104,8 +170,7 @@ void taskMeasureOneWire(void *pvParameters);
 /*! ************************************************************************
  * \brief Task for measuring fast signals
  *
- * This tasks measures all fast signals, converts them to N2K format
- * and sends out corresponding N2K messages \ref SendN2kEngineParmFast.
+ * This tasks measures all fast signals and converts them to N2K format.
  *
  * \param pvParameters
  */
@@ -139,6 +204,28 @@ void taskInterpretButton(void *pvParameters);
  */
 void taskStorePermanentData(void *pvParameters);
 
+/*! ************************************************************************
+ * \brief Task for the N2K communication
+ *
+ * This task is the only one which accesses the NMEA2000 library. It
+ * sleeps until a frame is received by the CAN interrupt or the next tick
+ * of the transmit scheduler is due. Received frames are handled at once,
+ * all N2K messages are sent at their own rate \ref N2kScheduler.
+ *
+ * \param pvParameters
+ */
+void taskN2k(void *pvParameters);
+
+/*! ************************************************************************
+ * \brief Task for the decoding of the received N2K messages
+ *
+ * This task sleeps until the N2K task hands over a message of the
+ * dispatch table and decodes it \ref N2kReceiver.
+ *
+ * \param pvParameters
+ */
+void taskN2kReceive(void *pvParameters);
+
 //***************************************************************
 // Setup Task
 void setup()
@@ -152,12 +239,17 @@ void setup()
   }
   ESP_ERROR_CHECK(ret);
 
+  // Start Serial Output/Input
+  Serial.begin(TERMINAL_BAUD_RATE);
+
+  // Load the calibration data and apply it to the maps
+  calibration.load();
+  calibration.applyMaps(mapTCO, mapPOIL);
+
   // Setup LCD Display
   lcdDisplayData.setupLCDPanel();
   lcdDisplayData.setLcdCurrentPage(WELCOME_PAGE);
-
-  // Start Serial Output/Input
-  Serial.begin(115200);
+  lcdDisplayData.render();
 
   // Init all the PINs
   pinMode(STATUS_LED_PIN, OUTPUT);
@@ -200,7 +292,9 @@ void setup()
   // Start the DS18B20 sensor
   oneWireSensors.begin();
 
-  // Setup NMEA2000 Interface
+  // Setup NMEA2000 Interface (acceptance filter before the bus is opened)
+  n2kReceiver.begin();
+  n2kAlertManager.begin();
   setupN2K();
 
   // Setup all Measurement Channels
@@ -216,7 +310,7 @@ void setup()
   lcdDisplayData.setLcdCurrentPage(PAGE_ENGINE);
 
   // Create mutex before starting tasks
-  xMutexVolvoN2kData = xSemaphoreCreateMutex();
+  n2kDataExchange.begin();
   xMutexStdOut = xSemaphoreCreateMutex();
 
   // Create TaskMeasureOnewire with priority 1 at core 0
@@ -243,11 +337,13 @@ void setup()
   xTaskCreatePinnedToCore(
       taskUpdateLCD,        /* Function to implement the task */
       "TaskUpdateLCD",      /* Name of the task */
-      3000,                 /* Stack size in words */
+      2560,                 /* Stack size in words */
       NULL,                 /* Task input parameter */
       2,                    /* Priority of the task */
       &TaskUpdateLCDHandle, /* Task handle. */
       0);                   /* Core where the task should run */
+  // page requests of all tasks wake up the LCD task
+  lcdDisplayData.setRenderTask(TaskUpdateLCDHandle);
 
   // Create TaskInterpretButton with priority 2 at core 0
   xTaskCreatePinnedToCore(
@@ -268,6 +364,26 @@ void setup()
       1,                                /* Priority of the task */
       &TaskInterpretStorePermanentData, /* Task handle. */
       0);
+
+  // Create TaskN2k with priority 3 at core 0
+  xTaskCreatePinnedToCore(
+      taskN2k,        /* Function to implement the task */
+      "TaskN2k",      /* Name of the task */
+      3000,           /* Stack size in words */
+      NULL,           /* Task input parameter */
+      3,              /* Priority of the task */
+      &TaskN2kHandle, /* Task handle. */
+      0);             /* Core where the task should run */
+
+  // Create TaskN2kReceive with priority 2 at core 0
+  xTaskCreatePinnedToCore(
+      taskN2kReceive,        /* Function to implement the task */
+      "TaskN2kReceive",      /* Name of the task */
+      2500,                  /* Stack size in words */
+      NULL,                  /* Task input parameter */
+      2,                     /* Priority of the task */
+      &TaskN2kReceiveHandle, /* Task handle. */
+      0);                    /* Core where the task should run */
 }
 
 //***************************************************************
@@ -275,8 +391,15 @@ void setup()
 void loop()
 {
 
-  // Check N2k Messages
-  NMEA2000.ParseMessages();
+  // Interpret commands from the terminal
+  if (Serial.available() > 0)
+  {
+    if (xSemaphoreTake(xMutexStdOut, (TickType_t)50) == pdTRUE)
+    {
+      terminalCommand.processSerialInput();
+      xSemaphoreGive(xMutexStdOut);
+    }
+  }
 
   // Datenausgabe auf den Standard Terminal via USB
   if ((timeUpdatedCnt + UPDATE_TERMINAL_PERIOD) < millis())
@@ -285,7 +408,7 @@ void loop()
 
 // Debugging
 #ifdef DEBUG_LEVEL
-    if (DEBUG_LEVEL == 1)
+    if (DEBUG_LEVEL == 1 && !n2kGateway.isEnabled() && !signalKDelta.isEnabled())
     {
       if (xSemaphoreTake(xMutexStdOut, (TickType_t)50) == pdTRUE)
       {
@@ -295,6 +418,28 @@ void loop()
     }
 #endif // DEBUG_LEVEL
   }
+  // stream all N2K frames in batches
+  if (n2kGateway.isEnabled())
+  {
+    if (xSemaphoreTake(xMutexStdOut, (TickType_t)50) == pdTRUE)
+    {
+      n2kGateway.processStream();
+      xSemaphoreGive(xMutexStdOut);
+    }
+  }
+
+  // Signal K deltas of the changed values
+  if (signalKDelta.isEnabled())
+  {
+    if (xSemaphoreTake(xMutexStdOut, (TickType_t)50) == pdTRUE)
+    {
+      signalKDelta.process();
+      xSemaphoreGive(xMutexStdOut);
+    }
+  }
+
+  // nothing to poll, let the core sleep
+  vTaskDelay(pdMS_TO_TICKS(LOOP_IDLE_PERIOD_MS));
 }
 
 //***************************************************************
@@ -322,10 +467,13 @@ void taskMeasureOneWire(void *pvParameters)
 
     // measure onewire devices
     data.measureOnewire();
-    // convert data
-    data.convertDataToN2k(&VolvoDataForN2k);
-    // send data to NMEA2000 Bus
-    SendN2kEngineParmSlow(&VolvoDataForN2k);
+    // convert data and publish it for N2k
+    tVolvoPentaData *n2kData = n2kDataExchange.beginWrite();
+    if (n2kData != NULL)
+    {
+      data.convertDataToN2k(n2kData);
+      n2kDataExchange.publish();
+    }
 
     // non blocking delay for the slow measuring
     vTaskDelay(pdMS_TO_TICKS(300));
@@ -372,10 +520,13 @@ void taskMeasureFast(void *pvParameters)
       lcdDisplayData.setLcdCurrentPage(PAGE_ALARM);
     }
 
-    // convert data
-    data.convertDataToN2k(&VolvoDataForN2k);
-    // send data to NMEA2000 Bus
-    SendN2kEngineParmFast(&VolvoDataForN2k);
+    // convert data and publish it for N2k
+    tVolvoPentaData *n2kData = n2kDataExchange.beginWrite();
+    if (n2kData != NULL)
+    {
+      data.convertDataToN2k(n2kData);
+      n2kDataExchange.publish();
+    }
 
     // non blocking delay for the fast measuring
     vTaskDelay(pdMS_TO_TICKS(249));
@@ -404,16 +555,12 @@ void taskUpdateLCD(void *pvParameters)
 
 #endif // DEBUG_TASK_STACK_SIZE
 
-    // Update the Content of the LCD Panel for an specific page
-    // on standard just update the 4th line
-    // with the actual measured values
-    lcdDisplayData.updateLcdContent(true);
-
-    // Update LED Backlight Brightness
-    lcdDisplayData.updateLcdBacklight();
+    // Render the current page and write the changed characters,
+    // the other tasks only request a page
+    lcdDisplayData.render();
 
-    // non blocking delay for the lcd Display
-    vTaskDelay(pdMS_TO_TICKS(100));
+    // sleep until a page change is requested or the period has elapsed
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(LCD_REFRESH_PERIOD_MS));
   }
 }
 
@@ -458,4 +605,76 @@ void taskStorePermanentData(void *pvParameters)
     // non blocking delay for the button (every 5min)
     vTaskDelay(pdMS_TO_TICKS(1000 * 60 * 1));
   }
-}
\ No newline at end of file
+}
+
+//***************************************************************
+// Task for the N2K communication (receive and transmit)
+void taskN2k(void *pvParameters)
+{
+  TickType_t nextTick = xTaskGetTickCount();
+
+  while (1)
+  {
+    // sleep until a frame is received or the scheduler is due
+    int32_t remaining = (int32_t)(nextTick - xTaskGetTickCount());
+    if (remaining < 0)
+    {
+      remaining = 0;
+    }
+    n2kCanDriver.waitForFrame((TickType_t)remaining);
+
+    // handle all received frames, the timers of the library and the TX queue
+    n2kCanDriver.processMessages();
+
+    if ((int32_t)(xTaskGetTickCount() - nextTick) < 0)
+    {
+      continue;
+    }
+
+// just to debug the stacksize
+#ifdef DEBUG_TASK_STACK_SIZE
+    if (xSemaphoreTake(xMutexStdOut, (TickType_t)50) == pdTRUE)
+    {
+      UBaseType_t stackHighWaterMark;
+      stackHighWaterMark = uxTaskGetStackHighWaterMark(NULL);
+      Serial.print(millis());
+      Serial.print(" N2k Task is started -> free stack: ");
+      Serial.println(stackHighWaterMark);
+
+      xSemaphoreGive(xMutexStdOut);
+    }
+
+#endif // DEBUG_TASK_STACK_SIZE
+
+    // send all PGNs which are due
+    n2kScheduler.processTick();
+
+    // send the alerts which have changed
+    n2kAlertManager.processTick();
+
+    // sample the state of the bus
+    n2kBusMonitor.processTick();
+
+    // adapt the periods to the load of the bus
+    n2kRateController.processTick();
+    n2kScheduler.setStretch(n2kRateController.getStretch());
+
+    // fixed raster for the scheduler, skip missed ticks
+    nextTick += pdMS_TO_TICKS(N2K_SCHEDULER_TICK_MS);
+    if ((int32_t)(xTaskGetTickCount() - nextTick) >= 0)
+    {
+      nextTick = xTaskGetTickCount() + pdMS_TO_TICKS(N2K_SCHEDULER_TICK_MS);
+    }
+  }
+}
+
+//***************************************************************
+// Task for the decoding of the received N2K messages
+void taskN2kReceive(void *pvParameters)
+{
+  while (1)
+  {
+    // sleep until a message is handed over by the N2K task
+    n2kReceiver.processQueue(portMAX_DELAY);
+  }
+}
@@ -0,0 +1,309 @@
+// Doxygen Documentation
+/*! \file 	n2k_alert.cpp
+ *  \brief  NMEA2000 alerts of the engine alarms
+ *
+ * This File contains all the necessary methods to send the engine alarms
+ * as N2K alerts (PGN 126983, 126985) and to receive the acknowledgement
+ * of an MFD (PGN 126984).
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         ESP32-WROOM
+ * - Hardware:          az-delivery-devkit-v4
+ */
+
+#include <n2k_alert.h>
+
+/// Alert PGNs which are sent and received as fast packet (0 terminated)
+static const unsigned long n2kAlertFastPacket[] = {126983L, 126984L, 126985L, 0};
+
+//****************************************
+// Name of an alert state for the log
+static const char *alertStateName(uint8_t state)
+{
+  switch (state)
+  {
+  case N2K_ALERT_STATE_NORMAL:
+    return "normal";
+  case N2K_ALERT_STATE_ACTIVE:
+    return "active";
+  case N2K_ALERT_STATE_ACKNOWLEDGED:
+    return "acknowledged";
+  default:
+    return "?";
+  }
+}
+
+//*************************************************************
+// Table of all alerts
+//
+// To add an alert add an error flag to tEngineStatus and a row here,
+// the alert ID must never change once it has been used on a boat.
+const tN2kAlertDefinition n2kAlerts[N2K_ALERT_COUNT] = {
+    // ID  error flag                              type                     threshold                     prio  text                           LCD text
+    {1, &tEngineStatus::flgLowOilPressure, N2K_ALERT_TYPE_ALARM, N2K_ALERT_THRESHOLD_LOW, 0, "Low oil pressure", "Oil pressure"},
+    {2, &tEngineStatus::flgHighCoolantTemp, N2K_ALERT_TYPE_ALARM, N2K_ALERT_THRESHOLD_EXCEEDED, 1, "High coolant temperature", "Coolant temp"},
+    {3, &tEngineStatus::flgHighSeaWaterTemp, N2K_ALERT_TYPE_ALARM, N2K_ALERT_THRESHOLD_EXCEEDED, 2, "High sea water temperature", "Seawater tmp"},
+    {4, &tEngineStatus::flgHighExhaustTemp, N2K_ALERT_TYPE_WARNING, N2K_ALERT_THRESHOLD_EXCEEDED, 3, "High exhaust temperature", "Exhaust temp"},
+    {5, &tEngineStatus::flgHighGearboxTemp, N2K_ALERT_TYPE_WARNING, N2K_ALERT_THRESHOLD_EXCEEDED, 4, "High gearbox temperature", "Gearbox temp"},
+    {6, &tEngineStatus::flgHighAlternatorTemp, N2K_ALERT_TYPE_WARNING, N2K_ALERT_THRESHOLD_EXCEEDED, 5, "High alternator temperature", "Altern. temp"},
+};
+
+//****************************************
+// Constructor
+N2kAlertManager::N2kAlertManager(AcquireData &data) : data(data)
+{
+}
+
+//****************************************
+// Register the fast packet PGNs of the alerts
+void N2kAlertManager::begin()
+{
+  NMEA2000.ExtendFastPacketMessages(n2kAlertFastPacket);
+}
+
+//****************************************
+// Send the alerts which have changed or are due again (N2K task only)
+void N2kAlertManager::processTick()
+{
+  uint32_t changeCount = ErrorFlag::getChangeCount();
+  bool resend = this->resendRequested;
+  uint32_t now = millis();
+
+  // nothing has changed since the last evaluation and no alert is due
+  if (changeCount == this->lastChangeCount && !resend && !isResendDue(now))
+  {
+    return;
+  }
+  this->lastChangeCount = changeCount;
+  this->resendRequested = false;
+
+  for (uint8_t i = 0; i < N2K_ALERT_COUNT; i++)
+  {
+    ErrorFlag &flag = getFlag(i);
+    tN2kAlertState &alert = this->alertState[i];
+    uint8_t state = N2K_ALERT_STATE_NORMAL;
+
+    if (flag.isFlagSet())
+    {
+      state = flag.isFlagAcknowledged() ? N2K_ALERT_STATE_ACKNOWLEDGED : N2K_ALERT_STATE_ACTIVE;
+    }
+
+    if (state == alert.state)
+    {
+      // answer an ISO request with all alerts which are not normal
+      if (resend && state != N2K_ALERT_STATE_NORMAL)
+      {
+        sendAlertText(i);
+        sendAlert(i);
+      }
+      // an alert which is not normal is repeated periodically
+      else if (state != N2K_ALERT_STATE_NORMAL &&
+               (uint32_t)(now - alert.lastSentMs) >= N2K_ALERT_RESEND_PERIOD_MS)
+      {
+        sendAlert(i);
+      }
+      continue;
+    }
+
+    if (alert.state == N2K_ALERT_STATE_NORMAL)
+    {
+      // new occurrence of the alert
+      alert.occurrence++;
+      portENTER_CRITICAL(&this->alertMux);
+      alert.ackName = 0;
+      portEXIT_CRITICAL(&this->alertMux);
+      sendAlertText(i);
+    }
+    alert.state = state;
+
+    // acknowledged with the button, the own device is the source
+    if (state == N2K_ALERT_STATE_ACKNOWLEDGED)
+    {
+      portENTER_CRITICAL(&this->alertMux);
+      if (alert.ackName == 0)
+      {
+        alert.ackName = NMEA2000.GetN2kName();
+      }
+      portEXIT_CRITICAL(&this->alertMux);
+    }
+    sendAlert(i);
+  }
+}
+
+//****************************************
+// Check if an alert which is not normal has to be sent again
+bool N2kAlertManager::isResendDue(uint32_t now) const
+{
+  for (uint8_t i = 0; i < N2K_ALERT_COUNT; i++)
+  {
+    const tN2kAlertState &alert = this->alertState[i];
+    if (alert.state != N2K_ALERT_STATE_NORMAL &&
+        (uint32_t)(now - alert.lastSentMs) >= N2K_ALERT_RESEND_PERIOD_MS)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+//****************************************
+// Handle an alert response of an MFD (PGN 126984, RX task)
+void N2kAlertManager::processResponse(const tN2kMsg &msg)
+{
+  int index = 0;
+
+  this->responseCount++;
+  if (msg.PGN != 126984L || msg.DataLen < 25)
+  {
+    this->rejectCount++;
+    return;
+  }
+
+  index++; // alert type and category
+  uint8_t system = msg.GetByte(index);
+  uint8_t subSystem = msg.GetByte(index);
+  uint16_t alertId = msg.Get2ByteUInt(index);
+  uint64_t sourceName = msg.GetUInt64(index);
+  index += 2; // data source instance and index
+  uint8_t occurrence = msg.GetByte(index);
+  uint64_t ackName = msg.GetUInt64(index);
+  uint8_t command = msg.GetByte(index) & 0x03;
+
+  // the response has to match an alert of this device
+  if (system != N2K_ALERT_SYSTEM || subSystem != N2K_ALERT_SUBSYSTEM ||
+      sourceName != NMEA2000.GetN2kName() || command != N2K_ALERT_RESPONSE_ACK)
+  {
+    this->rejectCount++;
+    return;
+  }
+
+  for (uint8_t i = 0; i < N2K_ALERT_COUNT; i++)
+  {
+    if (n2kAlerts[i].alertId != alertId)
+    {
+      continue;
+    }
+    tN2kAlertState &alert = this->alertState[i];
+    ErrorFlag &flag = getFlag(i);
+
+    // an old occurrence must not acknowledge a new one
+    if (occurrence != alert.occurrence || !flag.isFlagSet() || flag.isFlagAcknowledged())
+    {
+      break;
+    }
+    portENTER_CRITICAL(&this->alertMux);
+    alert.ackName = ackName;
+    portEXIT_CRITICAL(&this->alertMux);
+
+    // same state as the button, the N2K task sends the change (the flag
+    // is atomic, a reset of the measure task in between wins)
+    flag.acknowledgeFlag();
+    return;
+  }
+  this->rejectCount++;
+}
+
+//****************************************
+// Request to send all active alerts again
+bool N2kAlertManager::requestSend(unsigned long pgn)
+{
+  if (pgn != 126983L && pgn != 126985L)
+  {
+    return false;
+  }
+  this->resendRequested = true;
+  return true;
+}
+
+//****************************************
+// Print the state of all alerts to the terminal
+void N2kAlertManager::printLog()
+{
+  char buffer[96];
+
+  Serial.println(" ID state         occ  sent  text");
+  for (uint8_t i = 0; i < N2K_ALERT_COUNT; i++)
+  {
+    const tN2kAlertState &alert = this->alertState[i];
+    snprintf(buffer, sizeof(buffer), "%3u %-12s %4u %5lu  %s",
+             n2kAlerts[i].alertId, alertStateName(alert.state), alert.occurrence,
+             (unsigned long)alert.sentCount, n2kAlerts[i].text);
+    Serial.println(buffer);
+  }
+  snprintf(buffer, sizeof(buffer), "responses %lu  rejected %lu",
+           (unsigned long)this->responseCount, (unsigned long)this->rejectCount);
+  Serial.println(buffer);
+}
+
+//****************************************
+// Get the error flag of an alert
+ErrorFlag &N2kAlertManager::getFlag(uint8_t index)
+{
+  return this->data.currentEngineDiscreteStatus.*(n2kAlerts[index].flag);
+}
+
+//****************************************
+// Add the common header of the alert PGNs to a message
+void N2kAlertManager::addAlertHeader(tN2kMsg &msg, uint8_t index)
+{
+  const tN2kAlertDefinition &definition = n2kAlerts[index];
+
+  msg.AddByte((N2K_ALERT_CATEGORY_TECHNICAL << 4) | (definition.type & 0x0F));
+  msg.AddByte(N2K_ALERT_SYSTEM);
+  msg.AddByte(N2K_ALERT_SUBSYSTEM);
+  msg.Add2ByteUInt(definition.alertId);
+  msg.AddUInt64(NMEA2000.GetN2kName());
+  msg.AddByte(N2K_ENGINE_INSTANCE); // data source instance
+  msg.AddByte(0);                   // data source index
+  msg.AddByte(this->alertState[index].occurrence);
+}
+
+//****************************************
+// Send the alert (PGN 126983)
+void N2kAlertManager::sendAlert(uint8_t index)
+{
+  const tN2kAlertState &alert = this->alertState[index];
+  bool active = (alert.state != N2K_ALERT_STATE_NORMAL);
+  bool acknowledged = (alert.state == N2K_ALERT_STATE_ACKNOWLEDGED);
+  uint64_t ackName;
+  tN2kMsg msg;
+
+  portENTER_CRITICAL(&this->alertMux);
+  ackName = alert.ackName;
+  portEXIT_CRITICAL(&this->alertMux);
+
+  msg.SetPGN(126983L);
+  msg.Priority = N2K_ALERT_PRIORITY;
+  addAlertHeader(msg, index);
+  // silence status, ack status, escalation status, silence support, ack support, escalation support
+  msg.AddByte(0xC0 | (acknowledged ? 0x02 : 0x00) | 0x10);
+  msg.AddUInt64(acknowledged ? ackName : 0);
+  msg.AddByte(((active ? n2kAlerts[index].threshold : N2K_ALERT_THRESHOLD_NORMAL) << 4) |
+              N2K_ALERT_TRIGGER_AUTO);
+  msg.AddByte(n2kAlerts[index].priority);
+  msg.AddByte(alert.state);
+
+  // a failed message is repeated with the next period
+  this->alertState[index].lastSentMs = millis();
+  if (NMEA2000.SendMsg(msg))
+  {
+    this->alertState[index].sentCount++;
+  }
+}
+
+//****************************************
+// Send the alert text (PGN 126985)
+void N2kAlertManager::sendAlertText(uint8_t index)
+{
+  tN2kMsg msg;
+
+  msg.SetPGN(126985L);
+  msg.Priority = N2K_ALERT_PRIORITY;
+  addAlertHeader(msg, index);
+  msg.AddByte(N2K_ALERT_LANGUAGE);
+  msg.AddVarStr(n2kAlerts[index].text);
+  msg.AddVarStr("Engine");
+  NMEA2000.SendMsg(msg);
+}
@@ -0,0 +1,195 @@
+// Doxygen Documentation
+/*! \file 	n2k_bus_monitor.cpp
+ *  \brief  Monitoring of the NMEA2000 bus (load and errors)
+ *
+ * This File contains all the necessary methods to monitor the NMEA2000
+ * bus. It samples the error counters of the CAN controller and counts the
+ * received and sent frames to calculate the bus load.
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         ESP32-WROOM
+ * - Hardware:          az-delivery-devkit-v4
+ */
+
+#include <n2k_bus_monitor.h>
+
+//****************************************
+// Constructor
+N2kBusMonitor::N2kBusMonitor(N2kCanDriver &driver) : driver(driver)
+{
+}
+
+//****************************************
+// Sample the CAN controller and update the statistic
+void N2kBusMonitor::processTick()
+{
+  uint32_t now = millis();
+
+  // sample the error state of the CAN controller
+  uint8_t status = readRegister(TWAI_REG_SR);
+  uint8_t txErrors = readRegister(TWAI_REG_TXERR);
+  uint8_t rxErrors = readRegister(TWAI_REG_RXERR);
+  bool busOff = (status & TWAI_SR_BUS_OFF) != 0;
+  bool errorWarning = (status & TWAI_SR_ERROR_WARNING) != 0;
+
+  portENTER_CRITICAL(&muxStatistic);
+  // count the events on the rising edge only
+  if (busOff && !this->statistic.busOff)
+  {
+    this->statistic.busOffEvents++;
+  }
+  if (errorWarning && !this->statistic.errorWarning)
+  {
+    this->statistic.errorWarningEvents++;
+  }
+  this->statistic.busOff = busOff;
+  this->statistic.errorWarning = errorWarning;
+  this->statistic.txErrorCounter = txErrors;
+  this->statistic.rxErrorCounter = rxErrors;
+  if (txErrors > this->statistic.maxTxErrorCounter)
+  {
+    this->statistic.maxTxErrorCounter = txErrors;
+  }
+  if (rxErrors > this->statistic.maxRxErrorCounter)
+  {
+    this->statistic.maxRxErrorCounter = rxErrors;
+  }
+  portEXIT_CRITICAL(&muxStatistic);
+
+  // a bucket counts all frames only if the filter was open all the time
+  if (this->driver.isHardwareFilterClosed())
+  {
+    this->bucketFiltered = true;
+  }
+
+  // start the first bucket
+  if (!this->started)
+  {
+    this->lastCounter = this->driver.getFrameCounter();
+    this->bucketStartMs = now;
+    this->started = true;
+    return;
+  }
+
+  if ((now - this->bucketStartMs) < 1000)
+  {
+    return;
+  }
+  this->bucketStartMs += 1000;
+
+  // close the bucket of the last second
+  tN2kFrameCounter counter = this->driver.getFrameCounter();
+  tN2kBusBucket &bucket = this->history[this->historyIndex];
+  bucket.rxFrames = (uint16_t)(counter.rxFrames - this->lastCounter.rxFrames);
+  bucket.txFrames = (uint16_t)(counter.txFrames - this->lastCounter.txFrames);
+  bucket.bits = (counter.rxBits - this->lastCounter.rxBits) + (counter.txBits - this->lastCounter.txBits);
+  this->lastCounter = counter;
+  bool admittedOnly = this->bucketFiltered;
+  this->bucketFiltered = false;
+
+  this->historyIndex = (this->historyIndex + 1) % N2K_BUS_HISTORY_SIZE;
+  if (this->historyCount < N2K_BUS_HISTORY_SIZE)
+  {
+    this->historyCount++;
+  }
+
+  uint16_t load1s = calcBusLoad(1);
+  uint16_t load10s = calcBusLoad(10);
+  uint16_t load60s = calcBusLoad(60);
+
+  portENTER_CRITICAL(&muxStatistic);
+  this->statistic.rxFramesPerSecond = bucket.rxFrames;
+  this->statistic.txFramesPerSecond = bucket.txFrames;
+  this->statistic.busLoad1s = load1s;
+  this->statistic.busLoad10s = load10s;
+  this->statistic.busLoad60s = load60s;
+  this->statistic.admittedOnly = admittedOnly;
+  if (load1s > this->statistic.maxBusLoad1s)
+  {
+    this->statistic.maxBusLoad1s = load1s;
+  }
+  portEXIT_CRITICAL(&muxStatistic);
+}
+
+//****************************************
+// Get a copy of the bus statistic
+tN2kBusStatistic N2kBusMonitor::getStatistic()
+{
+  tN2kBusStatistic copy;
+
+  portENTER_CRITICAL(&muxStatistic);
+  copy = this->statistic;
+  portEXIT_CRITICAL(&muxStatistic);
+
+  return copy;
+}
+
+//****************************************
+// Print the bus statistic to the terminal
+void N2kBusMonitor::printStatistic()
+{
+  char buffer[80];
+  tN2kBusStatistic stat = getStatistic();
+
+  snprintf(buffer, sizeof(buffer), "Bus load [%%]   1s %3u.%u  10s %3u.%u  60s %3u.%u  max %3u.%u",
+           stat.busLoad1s / 10, stat.busLoad1s % 10,
+           stat.busLoad10s / 10, stat.busLoad10s % 10,
+           stat.busLoad60s / 10, stat.busLoad60s % 10,
+           stat.maxBusLoad1s / 10, stat.maxBusLoad1s % 10);
+  Serial.println(buffer);
+  if (stat.admittedOnly)
+  {
+    Serial.println("               admitted frames only, \"stats monitor on\" counts all");
+  }
+
+  snprintf(buffer, sizeof(buffer), "Frames [1/s]   rx %4u  tx %4u",
+           stat.rxFramesPerSecond, stat.txFramesPerSecond);
+  Serial.println(buffer);
+
+  snprintf(buffer, sizeof(buffer), "Errors         tec %3u (max %3u)  rec %3u (max %3u)",
+           stat.txErrorCounter, stat.maxTxErrorCounter,
+           stat.rxErrorCounter, stat.maxRxErrorCounter);
+  Serial.println(buffer);
+
+  snprintf(buffer, sizeof(buffer), "State          %s  warnings %lu  bus off %lu",
+           stat.busOff ? "BUS OFF" : (stat.errorWarning ? "WARNING" : "OK     "),
+           (unsigned long)stat.errorWarningEvents, (unsigned long)stat.busOffEvents);
+  Serial.println(buffer);
+}
+
+//****************************************
+// Calculate the bus load over the last seconds
+uint16_t N2kBusMonitor::calcBusLoad(uint8_t seconds) const
+{
+  uint64_t bits = 0;
+  uint8_t index = this->historyIndex;
+
+  if (seconds > this->historyCount)
+  {
+    seconds = this->historyCount;
+  }
+  if (seconds == 0)
+  {
+    return 0;
+  }
+
+  // sum up the buckets backwards from the newest one
+  for (uint8_t i = 0; i < seconds; i++)
+  {
+    index = (index + N2K_BUS_HISTORY_SIZE - 1) % N2K_BUS_HISTORY_SIZE;
+    bits += this->history[index].bits;
+  }
+
+  uint64_t load = (bits * 1000) / ((uint64_t)seconds * N2K_BUS_BITRATE);
+  return (load > 1000) ? 1000 : (uint16_t)load;
+}
+
+//****************************************
+// Read a register of the CAN controller
+uint8_t N2kBusMonitor::readRegister(uint32_t address)
+{
+  // the registers are 32 bit wide, only the lower byte is used
+  return (uint8_t)(*(volatile uint32_t *)(uintptr_t)address);
+}
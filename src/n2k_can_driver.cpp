@@ -0,0 +1,583 @@
+// Doxygen Documentation
+/*! \file 	n2k_can_driver.cpp
+ *  \brief  Event driven CAN driver for the NMEA2000 library
+ *
+ * This File contains the CAN driver for the ESP32. It extends the driver
+ * of the NMEA2000 library, so the N2K task can sleep until a frame has
+ * been received by the CAN interrupt.
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         ESP32-WROOM
+ * - Hardware:          az-delivery-devkit-v4
+ */
+
+#include <n2k_can_driver.h>
+#include <esp_intr_alloc.h>
+#include <soc/soc.h>
+
+//****************************************
+// Append the values admitted by a code and a mask as ranges (hex)
+static size_t appendRanges(char *buffer, size_t size, uint8_t code, uint8_t mask, uint8_t bits,
+                           uint8_t shift)
+{
+  size_t len = 0;
+  int16_t start = -1;
+
+  for (uint16_t v = 0; v <= (1U << bits); v++)
+  {
+    bool admitted = (v < (1U << bits)) && ((v & ~mask) == code);
+
+    if (admitted && start < 0)
+    {
+      start = v;
+    }
+    else if (!admitted && start >= 0 && len < size)
+    {
+      // a value of the filter stands for 1 << shift values of the field
+      unsigned first = (unsigned)start << shift;
+      unsigned last = ((unsigned)(v - 1) << shift) | ((1U << shift) - 1);
+      len += snprintf(buffer + len, size - len, (first == last) ? "%s%02X" : "%s%02X-%02X",
+                      (len > 0) ? "," : "", first, last);
+      start = -1;
+    }
+  }
+  return (len < size) ? len : size - 1;
+}
+
+//****************************************
+// Constructor
+N2kCanDriver::N2kCanDriver(gpio_num_t txPin, gpio_num_t rxPin, N2kGateway &gateway)
+    : tNMEA2000_esp32(txPin, rxPin), gateway(gateway)
+{
+}
+
+//****************************************
+// Wait until a frame has been received
+bool N2kCanDriver::waitForFrame(TickType_t timeout)
+{
+  tCANFrame frame;
+  uint32_t startUs = micros();
+
+  // the RX queue is created when the bus is opened
+  if (this->RxQueue != NULL)
+  {
+    // block until the interrupt has written a frame (it stays in the queue)
+    this->frameReceived = (xQueuePeek(this->RxQueue, &frame, timeout) == pdTRUE);
+  }
+  else
+  {
+    vTaskDelay(timeout);
+    this->frameReceived = false;
+  }
+
+  this->wakeUpUs = micros();
+  this->blockedUs = this->wakeUpUs - startUs;
+  this->windowIdleUs += this->blockedUs;
+
+  if (this->frameReceived)
+  {
+    this->rxStatistic.wakeUps++;
+  }
+  else
+  {
+    this->rxStatistic.timeouts++;
+  }
+
+  // calculate the idle time of the N2K task
+  uint32_t windowUs = this->wakeUpUs - this->windowStartUs;
+  if (windowUs >= (N2K_RX_STAT_WINDOW_MS * 1000UL))
+  {
+    uint32_t idle = (uint32_t)(((uint64_t)this->windowIdleUs * 100) / windowUs);
+    this->rxStatistic.idlePercent = (idle > 100) ? 100 : idle;
+    this->windowStartUs = this->wakeUpUs;
+    this->windowIdleUs = 0;
+  }
+
+  return this->frameReceived;
+}
+
+//****************************************
+// Handle all received frames
+void N2kCanDriver::processMessages()
+{
+  // the monitor mode and the gateway need all frames, so the filter is
+  // open while they run (the RX queue is created when the bus is opened)
+  bool open = isMonitorMode() || this->gateway.isEnabled();
+  if (this->RxQueue != NULL && this->filterActive && this->hardwareFilterClosed == open)
+  {
+    writeHardwareFilter(!open);
+  }
+
+  // time busy with other jobs since the last handling, without the wait
+  uint32_t busyUs = micros() - this->handledUs - this->blockedUs;
+  if (this->handledUs != 0 && busyUs > this->rxStatistic.maxBusyGapUs)
+  {
+    this->rxStatistic.maxBusyGapUs = busyUs;
+  }
+  this->blockedUs = 0;
+
+  // the interrupt drops the frames which find the queue full
+  if (this->RxQueue != NULL)
+  {
+    UBaseType_t depth = uxQueueMessagesWaiting(this->RxQueue);
+    UBaseType_t spaces = uxQueueSpacesAvailable(this->RxQueue);
+
+    this->rxStatistic.queueSize = depth + spaces;
+    if (depth > this->rxStatistic.maxQueueDepth)
+    {
+      this->rxStatistic.maxQueueDepth = depth;
+    }
+    if (spaces == 0)
+    {
+      this->rxStatistic.queueFull++;
+    }
+  }
+
+  ParseMessages();
+  this->handledUs = micros();
+
+  // a TX interrupt is lost when the filter is written during a transmission
+  if (this->interruptInstalled)
+  {
+    portENTER_CRITICAL(&this->muxTx);
+    sendNextFrame();
+    portEXIT_CRITICAL(&this->muxTx);
+  }
+
+  if (this->frameReceived)
+  {
+    uint32_t latencyUs = micros() - this->wakeUpUs;
+
+    this->rxStatistic.lastLatencyUs = latencyUs;
+    this->rxStatistic.sumLatencyUs += latencyUs;
+    if (latencyUs > this->rxStatistic.maxLatencyUs)
+    {
+      this->rxStatistic.maxLatencyUs = latencyUs;
+    }
+    this->frameReceived = false;
+  }
+}
+
+//****************************************
+// Print the receive statistic to the terminal
+void N2kCanDriver::printRxLog() const
+{
+  char buffer[80];
+  const tN2kRxStatistic &stat = this->rxStatistic;
+  unsigned long meanUs = 0;
+
+  if (stat.wakeUps > 0)
+  {
+    meanUs = (unsigned long)(stat.sumLatencyUs / stat.wakeUps);
+  }
+
+  Serial.println("  wakeups  timeouts  lat[us] mean[us]  max[us]  idle[%]");
+  snprintf(buffer, sizeof(buffer), "%9lu %9lu %8lu %8lu %8lu %8u",
+           (unsigned long)stat.wakeUps, (unsigned long)stat.timeouts,
+           (unsigned long)stat.lastLatencyUs, meanUs,
+           (unsigned long)stat.maxLatencyUs, stat.idlePercent);
+  Serial.println(buffer);
+  snprintf(buffer, sizeof(buffer), "RX busy gap max %lu us  queue max %u of %u  full %lu",
+           (unsigned long)stat.maxBusyGapUs, stat.maxQueueDepth, stat.queueSize,
+           (unsigned long)stat.queueFull);
+  Serial.println(buffer);
+
+  if (this->filterActive)
+  {
+    snprintf(buffer, sizeof(buffer), "Filter ID28..13  code %04X mask %04X | code %04X mask %04X  rejected %lu",
+             this->filterCode[0], this->filterMask[0], this->filterCode[1], this->filterMask[1],
+             (unsigned long)stat.rejectedFrames);
+    Serial.println(buffer);
+    Serial.println(this->hardwareFilterClosed ? "  CAN controller filters (rejected frames not counted)"
+                                              : "  CAN controller open, filtered by the driver");
+    printFilter(0);
+    printFilter(1);
+  }
+}
+
+//****************************************
+// Print the PGNs admitted by one acceptance filter
+void N2kCanDriver::printFilter(uint8_t index) const
+{
+  char buffer[120];
+  uint16_t code = this->filterCode[index];
+  uint16_t mask = this->filterMask[index];
+  size_t len;
+
+  // ID28..ID13: priority (3), EDP and DP (2), PF (8), upper 3 bits of PS
+  len = snprintf(buffer, sizeof(buffer), "  filter %u  DP ", index);
+  len += appendRanges(buffer + len, sizeof(buffer) - len, (code >> 11) & 0x03, (mask >> 11) & 0x03, 2, 0);
+  len += snprintf(buffer + len, sizeof(buffer) - len, "  PF ");
+  len += appendRanges(buffer + len, sizeof(buffer) - len, (code >> 3) & 0xFF, (mask >> 3) & 0xFF, 8, 0);
+  len += snprintf(buffer + len, sizeof(buffer) - len, "  PS ");
+  appendRanges(buffer + len, sizeof(buffer) - len, code & 0x07, mask & 0x07, 3, 5);
+  Serial.println(buffer);
+}
+
+//****************************************
+// Put a frame into the queue of its priority
+bool N2kCanDriver::CANSendFrame(unsigned long id, unsigned char len, const unsigned char *buf, bool wait_sent)
+{
+  uint8_t prio = (id >> 26) & 0x07;
+  tN2kTxFifo &fifo = this->txFifo[prio];
+  tN2kTxCounter &counter = getTxCounter(id);
+
+  portENTER_CRITICAL(&this->muxTx);
+  if (fifo.count >= N2K_TX_QUEUE_DEPTH)
+  {
+    // the library may buffer the frame and try again, each try is counted
+    counter.dropped++;
+    portEXIT_CRITICAL(&this->muxTx);
+    return false;
+  }
+
+  uint8_t idx = (fifo.head + fifo.count) % N2K_TX_QUEUE_DEPTH;
+  fifo.id[idx] = id;
+  fifo.len[idx] = (len > 8) ? 8 : len;
+  memcpy(fifo.buf[idx], buf, fifo.len[idx]);
+  fifo.counter[idx] = (uint8_t)(&counter - this->txCounter);
+  fifo.count++;
+  this->txQueueCount++;
+
+  counter.queued++;
+  if (this->txQueueCount > counter.maxDepth)
+  {
+    counter.maxDepth = this->txQueueCount;
+  }
+
+  // start the transmission at once if the transmit buffer is free
+  if (this->interruptInstalled)
+  {
+    sendNextFrame();
+  }
+  portEXIT_CRITICAL(&this->muxTx);
+
+  this->gateway.pushFrame(id, len, buf, true);
+  return true;
+}
+
+//****************************************
+// Get a received frame and count it
+bool N2kCanDriver::CANGetFrame(unsigned long &id, unsigned char &len, unsigned char *buf)
+{
+  while (tNMEA2000_esp32::CANGetFrame(id, len, buf))
+  {
+    // all frames count for the bus load and go to the gateway
+    this->frameCounter.rxFrames++;
+    this->frameCounter.rxBits += N2K_CAN_FRAME_OVERHEAD_BITS + 8 * len;
+    this->gateway.pushFrame(id, len, buf, false);
+
+    if (isAdmitted(id))
+    {
+      return true;
+    }
+    this->rxStatistic.rejectedFrames++;
+  }
+  return false;
+}
+
+//****************************************
+// Check if a frame is admitted by the acceptance filter
+bool N2kCanDriver::isAdmitted(unsigned long id) const
+{
+  uint16_t bits = (uint16_t)(id >> 13);
+
+  if (!this->filterActive)
+  {
+    return true;
+  }
+  return ((bits & ~this->filterMask[0]) == this->filterCode[0]) ||
+         ((bits & ~this->filterMask[1]) == this->filterCode[1]);
+}
+
+//****************************************
+// Open the CAN controller and set the acceptance filter
+bool N2kCanDriver::CANOpen()
+{
+  bool result = tNMEA2000_esp32::CANOpen();
+
+  writeHardwareFilter(!isMonitorMode() && !this->gateway.isEnabled());
+
+  // the CAN interrupt is routed to the own handler, the handler of the
+  // library is not called anymore
+  if (result && !this->interruptInstalled)
+  {
+    ESP_ERROR_CHECK(esp_intr_alloc(ETS_CAN_INTR_SOURCE, 0, interruptHandler, this, NULL));
+    this->interruptInstalled = true;
+  }
+
+  return result;
+}
+
+//****************************************
+// CAN interrupt, calls the handler of the driver
+void IRAM_ATTR N2kCanDriver::interruptHandler(void *arg)
+{
+  static_cast<N2kCanDriver *>(arg)->handleInterrupt();
+}
+
+//****************************************
+// Handle the CAN interrupt
+void IRAM_ATTR N2kCanDriver::handleInterrupt()
+{
+  uint8_t interrupt = readRegister(TWAI_REG_IR);
+
+  if (interrupt & TWAI_IR_RX)
+  {
+    // into the RX queue of the library, the N2K task waits for it
+    CAN_read_frame();
+  }
+  if (interrupt & TWAI_IR_TX)
+  {
+    portENTER_CRITICAL_ISR(&this->muxTx);
+    sendNextFrame();
+    portEXIT_CRITICAL_ISR(&this->muxTx);
+  }
+
+  // the N2K task may have been woken by the received frame
+  portYIELD_FROM_ISR();
+}
+
+//****************************************
+// Write the next frame of the highest priority to the CAN controller
+void IRAM_ATTR N2kCanDriver::sendNextFrame()
+{
+  if (this->txQueueCount == 0 || (readRegister(TWAI_REG_SR) & TWAI_SR_TBS) == 0)
+  {
+    return;
+  }
+
+  for (uint8_t prio = 0; prio < N2K_TX_PRIO_LEVELS; prio++)
+  {
+    tN2kTxFifo &fifo = this->txFifo[prio];
+    if (fifo.count == 0)
+    {
+      continue;
+    }
+
+    tCANFrame frame;
+    frame.id = fifo.id[fifo.head];
+    frame.len = fifo.len[fifo.head];
+    memcpy(frame.buf, fifo.buf[fifo.head], frame.len);
+    CAN_send_frame(frame);
+
+    this->txCounter[fifo.counter[fifo.head]].sent++;
+    this->frameCounter.txFrames++;
+    this->frameCounter.txBits += N2K_CAN_FRAME_OVERHEAD_BITS + 8 * frame.len;
+
+    fifo.head = (fifo.head + 1) % N2K_TX_QUEUE_DEPTH;
+    fifo.count--;
+    this->txQueueCount--;
+    return;
+  }
+}
+
+//****************************************
+// Get the frame counters for the bus load
+tN2kFrameCounter N2kCanDriver::getFrameCounter() const
+{
+  tN2kFrameCounter counter;
+
+  portENTER_CRITICAL(&this->muxTx);
+  counter = this->frameCounter;
+  portEXIT_CRITICAL(&this->muxTx);
+  return counter;
+}
+
+//****************************************
+// Write the acceptance filter to the CAN controller
+void N2kCanDriver::writeHardwareFilter(bool closed)
+{
+  if (!this->filterActive)
+  {
+    return;
+  }
+
+  // the filter can only be written in the reset mode
+  uint8_t mode = readRegister(TWAI_REG_MOD);
+  writeRegister(TWAI_REG_MOD, mode | TWAI_MOD_RESET);
+  for (uint8_t i = 0; i < 2; i++)
+  {
+    // an open filter admits all frames
+    uint16_t code = closed ? this->filterCode[i] : 0x0000;
+    uint16_t mask = closed ? this->filterMask[i] : 0xFFFF;
+
+    writeRegister(TWAI_REG_ACR0 + 8 * i, (uint8_t)(code >> 8));
+    writeRegister(TWAI_REG_ACR0 + 8 * i + 4, (uint8_t)code);
+    writeRegister(TWAI_REG_AMR0 + 8 * i, (uint8_t)(mask >> 8));
+    writeRegister(TWAI_REG_AMR0 + 8 * i + 4, (uint8_t)mask);
+  }
+  // dual filter mode and back to the operating mode
+  writeRegister(TWAI_REG_MOD, mode & ~(TWAI_MOD_AFM | TWAI_MOD_RESET));
+  this->hardwareFilterClosed = closed;
+}
+
+//****************************************
+// Calculate the acceptance filter for a list of PGNs
+void N2kCanDriver::setAcceptanceFilter(const unsigned long *pgns, uint8_t count)
+{
+  uint32_t bestCost = 0xFFFFFFFF;
+
+  if (count == 0)
+  {
+    return;
+  }
+  if (count > N2K_FILTER_MAX_PGNS)
+  {
+    count = N2K_FILTER_MAX_PGNS;
+  }
+
+  // try all splits into two groups, the first PGN is always in group 0
+  for (uint32_t split = 0; split < (1UL << (count - 1)); split++)
+  {
+    uint32_t group1 = split << 1;
+    uint32_t group0 = ((1UL << count) - 1) & ~group1;
+    uint16_t code[2], mask[2];
+    uint32_t cost;
+
+    mergeFilter(pgns, count, group0, code[0], mask[0]);
+    cost = 1UL << __builtin_popcount(mask[0] & ~N2K_FILTER_PRIO_MASK);
+    if (mergeFilter(pgns, count, group1, code[1], mask[1]))
+    {
+      cost += 1UL << __builtin_popcount(mask[1] & ~N2K_FILTER_PRIO_MASK);
+    }
+    else
+    {
+      // one group only, both filters are the same
+      code[1] = code[0];
+      mask[1] = mask[0];
+    }
+
+    // the number of admitted IDs (without priority) is the cost of the split
+    if (cost < bestCost)
+    {
+      bestCost = cost;
+      for (uint8_t i = 0; i < 2; i++)
+      {
+        this->filterCode[i] = code[i];
+        this->filterMask[i] = mask[i];
+      }
+    }
+  }
+  this->filterActive = true;
+}
+
+//****************************************
+// Print the TX queue counters to the terminal
+void N2kCanDriver::printTxLog() const
+{
+  char buffer[80];
+
+  Serial.println("   PGN   queued     sent  dropped  maxDepth");
+  for (uint8_t i = 0; i < N2K_TX_COUNTER_SIZE; i++)
+  {
+    const tN2kTxCounter &counter = this->txCounter[i];
+    if (counter.queued == 0 && counter.dropped == 0)
+    {
+      continue;
+    }
+    snprintf(buffer, sizeof(buffer), "%6lu %8lu %8lu %8lu %9u",
+             counter.pgn, (unsigned long)counter.queued,
+             (unsigned long)counter.sent, (unsigned long)counter.dropped,
+             counter.maxDepth);
+    Serial.println(buffer);
+  }
+}
+
+//****************************************
+// Get the TX counters of the PGN of a frame
+tN2kTxCounter &N2kCanDriver::getTxCounter(unsigned long id)
+{
+  unsigned long pgn = pgnFromCanId(id);
+  uint8_t i;
+
+  for (i = 0; i < N2K_TX_COUNTER_SIZE - 1; i++)
+  {
+    if (this->txCounter[i].pgn == pgn)
+    {
+      return this->txCounter[i];
+    }
+    if (this->txCounter[i].pgn == 0)
+    {
+      this->txCounter[i].pgn = pgn;
+      return this->txCounter[i];
+    }
+  }
+  // all other PGNs
+  return this->txCounter[N2K_TX_COUNTER_SIZE - 1];
+}
+
+//****************************************
+// Merge PGNs into the code and mask of one acceptance filter
+bool N2kCanDriver::mergeFilter(const unsigned long *pgns, uint8_t count, uint32_t group,
+                               uint16_t &code, uint16_t &mask)
+{
+  bool first = true;
+
+  for (uint8_t i = 0; i < count; i++)
+  {
+    if ((group & (1UL << i)) == 0)
+    {
+      continue;
+    }
+
+    // ID28..ID13 = priority, data page, PF and the upper 3 bits of PS
+    uint8_t dp = (uint8_t)(pgns[i] >> 16) & 0x03;
+    uint8_t pf = (uint8_t)(pgns[i] >> 8);
+    uint8_t ps = (uint8_t)pgns[i];
+    uint16_t pgnCode = ((uint16_t)dp << 11) | ((uint16_t)pf << 3) | (ps >> 5);
+    uint16_t pgnMask = N2K_FILTER_PRIO_MASK;
+
+    // PDU1 (addressed), the PS field is the destination
+    if (pf < 240)
+    {
+      pgnMask |= N2K_FILTER_PS_MASK;
+    }
+
+    if (first)
+    {
+      code = pgnCode;
+      mask = pgnMask;
+      first = false;
+    }
+    else
+    {
+      mask |= pgnMask | (code ^ pgnCode);
+    }
+    code &= ~mask;
+  }
+  return !first;
+}
+
+//****************************************
+// Get the PGN from a CAN id
+unsigned long N2kCanDriver::pgnFromCanId(unsigned long id)
+{
+  unsigned char pf = (unsigned char)(id >> 16);
+  unsigned char dp = (unsigned char)(id >> 24) & 0x03;
+
+  // PDU1 (addressed), the PS field is the destination
+  if (pf < 240)
+  {
+    return ((unsigned long)dp << 16) | ((unsigned long)pf << 8);
+  }
+  // PDU2 (broadcast), the PS field is part of the PGN
+  return ((unsigned long)dp << 16) | ((unsigned long)pf << 8) | ((id >> 8) & 0xFF);
+}
+
+//****************************************
+// Write a register of the CAN controller
+void N2kCanDriver::writeRegister(uint32_t address, uint8_t value)
+{
+  // the registers are 32 bit wide, only the lower byte is used
+  *(volatile uint32_t *)(uintptr_t)address = value;
+}
+
+//****************************************
+// Read a register of the CAN controller
+uint8_t IRAM_ATTR N2kCanDriver::readRegister(uint32_t address)
+{
+  return (uint8_t)(*(volatile uint32_t *)(uintptr_t)address);
+}
@@ -0,0 +1,146 @@
+// Doxygen Documentation
+/*! \file 	n2k_gateway.cpp
+ *  \brief  Stream of all N2K frames to the USB terminal
+ *
+ * This File contains all the necessary methods to stream all received
+ * and sent CAN frames in the Yacht Devices RAW format to the USB
+ * terminal, so the traffic of the bus can be logged and replayed on a
+ * laptop (tools/n2k_raw_decode.py).
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         ESP32-WROOM
+ * - Hardware:          az-delivery-devkit-v4
+ */
+
+#include <n2k_gateway.h>
+
+/// Hex digits for the RAW format
+static const char hexDigits[] = "0123456789ABCDEF";
+
+//****************************************
+// Start or stop the stream
+void N2kGateway::setEnabled(bool enabled)
+{
+  this->enabled.store(enabled, std::memory_order_relaxed);
+}
+
+//****************************************
+// Put a frame into the ring buffer (N2K task only)
+void N2kGateway::pushFrame(uint32_t id, uint8_t len, const uint8_t *buf, bool tx)
+{
+  if (!isEnabled())
+  {
+    return;
+  }
+
+  uint16_t head = this->head.load(std::memory_order_relaxed);
+  uint16_t tail = this->tail.load(std::memory_order_acquire);
+
+  // the consumer is too slow, never wait for it
+  if ((uint16_t)(head - tail) >= N2K_GATEWAY_RING_SIZE)
+  {
+    this->dropCount++;
+    return;
+  }
+
+  tN2kGatewayFrame &frame = this->ring[head % N2K_GATEWAY_RING_SIZE];
+  frame.timeMs = millis();
+  frame.id = id;
+  frame.len = (len > 8) ? 8 : len;
+  frame.tx = tx;
+  memcpy(frame.buf, buf, frame.len);
+
+  // publish the frame to the consumer
+  this->head.store(head + 1, std::memory_order_release);
+  this->frameCount++;
+}
+
+//****************************************
+// Write the frames of the ring buffer to the terminal
+void N2kGateway::processStream()
+{
+  char batch[N2K_GATEWAY_BATCH_SIZE];
+  uint16_t tail = this->tail.load(std::memory_order_relaxed);
+  uint16_t head = this->head.load(std::memory_order_acquire);
+
+  // only the frames of this moment, a bus faster than the UART never
+  // keeps the loop here
+  while (tail != head)
+  {
+    size_t len = 0;
+
+    // fill one batch with complete lines
+    while (tail != head && (len + N2K_GATEWAY_LINE_MAX) <= sizeof(batch))
+    {
+      len += formatFrame(this->ring[tail % N2K_GATEWAY_RING_SIZE], &batch[len]);
+      tail++;
+    }
+    // the slots are free for the producer again
+    this->tail.store(tail, std::memory_order_release);
+
+    Serial.write((const uint8_t *)batch, len);
+    this->byteCount += len;
+    this->batchCount++;
+  }
+}
+
+//****************************************
+// Print the counters of the stream to the terminal
+void N2kGateway::printLog() const
+{
+  char buffer[80];
+
+  snprintf(buffer, sizeof(buffer), "Gateway %s  frames %lu  dropped %lu  bytes %lu  batches %lu",
+           isEnabled() ? "on" : "off",
+           (unsigned long)this->frameCount, (unsigned long)this->dropCount,
+           (unsigned long)this->byteCount, (unsigned long)this->batchCount);
+  Serial.println(buffer);
+}
+
+//****************************************
+// Format a frame as one line of the RAW format
+uint8_t N2kGateway::formatFrame(const tN2kGatewayFrame &frame, char *line)
+{
+  uint32_t ms = frame.timeMs % 86400000UL;
+  uint32_t seconds = ms / 1000;
+  uint8_t len = 0;
+
+  // hh:mm:ss.ddd
+  line[len++] = '0' + (seconds / 36000);
+  line[len++] = '0' + ((seconds / 3600) % 10);
+  line[len++] = ':';
+  line[len++] = '0' + ((seconds / 600) % 6);
+  line[len++] = '0' + ((seconds / 60) % 10);
+  line[len++] = ':';
+  line[len++] = '0' + ((seconds / 10) % 6);
+  line[len++] = '0' + (seconds % 10);
+  line[len++] = '.';
+  line[len++] = '0' + ((ms / 100) % 10);
+  line[len++] = '0' + ((ms / 10) % 10);
+  line[len++] = '0' + (ms % 10);
+
+  // direction
+  line[len++] = ' ';
+  line[len++] = frame.tx ? 'T' : 'R';
+  line[len++] = ' ';
+
+  // CAN id with 29 bits
+  for (int8_t shift = 28; shift >= 0; shift -= 4)
+  {
+    line[len++] = hexDigits[(frame.id >> shift) & 0x0F];
+  }
+
+  // data bytes
+  for (uint8_t i = 0; i < frame.len; i++)
+  {
+    line[len++] = ' ';
+    line[len++] = hexDigits[frame.buf[i] >> 4];
+    line[len++] = hexDigits[frame.buf[i] & 0x0F];
+  }
+
+  line[len++] = '\r';
+  line[len++] = '\n';
+  return len;
+}
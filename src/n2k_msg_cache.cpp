@@ -0,0 +1,82 @@
+// Doxygen Documentation
+/*! \file 	n2k_msg_cache.cpp
+ *  \brief  Cache of encoded N2K messages
+ *
+ * This File contains all the necessary methods to keep an encoded N2K
+ * message per PGN and instance. The message is only encoded again when
+ * one of its source values (in N2K resolution) has changed.
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         ESP32-WROOM
+ * - Hardware:          az-delivery-devkit-v4
+ */
+
+#include <n2k_msg_cache.h>
+
+/// NMEA2000 Object with the event driven CAN driver (main.cpp)
+extern tNMEA2000 &NMEA2000;
+
+//****************************************
+// Constructor
+N2kMsgCache::N2kMsgCache(unsigned long pgn, uint8_t instance)
+    : pgn(pgn), instance(instance)
+{
+  for (uint8_t i = 0; i < N2K_CACHE_MAX_VALUES; i++)
+  {
+    keys[i] = N2kInt32NA;
+  }
+}
+
+//****************************************
+// Check if the cached message matches the source values
+bool N2kMsgCache::isUpToDate(const int32_t *values, uint8_t count)
+{
+  bool upToDate = this->valid;
+
+  if (count > N2K_CACHE_MAX_VALUES)
+  {
+    count = N2K_CACHE_MAX_VALUES;
+  }
+
+  for (uint8_t i = 0; i < count; i++)
+  {
+    if (values[i] != this->keys[i])
+    {
+      this->keys[i] = values[i];
+      upToDate = false;
+    }
+  }
+
+  if (upToDate)
+  {
+    this->hitCount++;
+  }
+  else
+  {
+    // the caller encodes the message now
+    this->valid = true;
+    this->encodeCount++;
+  }
+  return upToDate;
+}
+
+//****************************************
+// Send the cached message to the NMEA2000 bus
+bool N2kMsgCache::send()
+{
+  return NMEA2000.SendMsg(this->msg);
+}
+
+//****************************************
+// Print the cache statistic to the terminal
+void N2kMsgCache::printLog() const
+{
+  char buffer[60];
+
+  snprintf(buffer, sizeof(buffer), "%6lu %4u %8lu %8lu",
+           this->pgn, this->instance,
+           (unsigned long)this->encodeCount, (unsigned long)this->hitCount);
+  Serial.println(buffer);
+}
@@ -0,0 +1,135 @@
+// Doxygen Documentation
+/*! \file 	n2k_rate_control.cpp
+ *  \brief  Adaptive transmit rate of the N2K messages
+ *
+ * This File contains all the necessary methods to adapt the transmit
+ * rate of the low priority PGNs to the load of the NMEA2000 bus and to
+ * the backlog of the own TX queue.
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         ESP32-WROOM
+ * - Hardware:          az-delivery-devkit-v4
+ */
+
+#include <n2k_rate_control.h>
+
+//****************************************
+// Constructor
+N2kRateController::N2kRateController(N2kCanDriver &driver, N2kBusMonitor &busMonitor)
+    : driver(driver), busMonitor(busMonitor)
+{
+}
+
+//****************************************
+// Sample the backlog and update the stretch once per second
+void N2kRateController::processTick()
+{
+  uint32_t now = millis();
+
+  if (!this->started)
+  {
+    this->secondStartMs = now;
+    this->started = true;
+  }
+
+  // backlog of the own TX queue
+  uint16_t backlog = this->driver.getTxQueueCount();
+  if (backlog > this->maxBacklog)
+  {
+    this->maxBacklog = backlog;
+  }
+
+  if ((now - this->secondStartMs) < 1000)
+  {
+    return;
+  }
+  this->secondStartMs += 1000;
+
+  tN2kBusStatistic busStat = this->busMonitor.getStatistic();
+  uint16_t target;
+
+  // stretch depending on the bus load
+  if (busStat.busLoad10s <= N2K_RATE_LOAD_LOW)
+  {
+    target = 0;
+  }
+  else if (busStat.busLoad10s >= N2K_RATE_LOAD_HIGH)
+  {
+    target = N2K_RATE_STRETCH_MAX;
+  }
+  else
+  {
+    target = (uint16_t)(((uint32_t)(busStat.busLoad10s - N2K_RATE_LOAD_LOW) * N2K_RATE_STRETCH_MAX) /
+                        (N2K_RATE_LOAD_HIGH - N2K_RATE_LOAD_LOW));
+  }
+
+  // the own frames do not get onto the bus
+  if (this->maxBacklog >= N2K_RATE_BACKLOG_HIGH)
+  {
+    target = N2K_RATE_STRETCH_MAX;
+  }
+
+  // follow a rising load at once, a falling load slowly
+  if (target >= this->stretch)
+  {
+    this->stretch = target;
+  }
+  else if ((this->stretch - target) > N2K_RATE_STRETCH_DECAY)
+  {
+    this->stretch -= N2K_RATE_STRETCH_DECAY;
+  }
+  else
+  {
+    this->stretch = target;
+  }
+
+  // log the second
+  portENTER_CRITICAL(&muxLog);
+  tN2kRateLogEntry &entry = this->log[this->logIndex];
+  entry.busLoad = busStat.busLoad1s;
+  entry.maxBacklog = this->maxBacklog;
+  entry.stretch = this->stretch;
+  this->logIndex = (this->logIndex + 1) % N2K_RATE_LOG_SIZE;
+  if (this->logCount < N2K_RATE_LOG_SIZE)
+  {
+    this->logCount++;
+  }
+  portEXIT_CRITICAL(&muxLog);
+
+  this->maxBacklog = 0;
+}
+
+//****************************************
+// Print the log of bus load, backlog and stretch to the terminal
+void N2kRateController::printLog()
+{
+  char buffer[60];
+  tN2kRateLogEntry entries[N2K_RATE_LOG_SIZE];
+  uint8_t count;
+  uint8_t index;
+
+  // copy the log, so the terminal output does not block the N2K task
+  portENTER_CRITICAL(&muxLog);
+  memcpy(entries, this->log, sizeof(entries));
+  count = this->logCount;
+  index = this->logIndex;
+  portEXIT_CRITICAL(&muxLog);
+
+  snprintf(buffer, sizeof(buffer), "Stretch %u.%u%% (0%% nominal .. 100%% max period)",
+           this->stretch / 10, this->stretch % 10);
+  Serial.println(buffer);
+  Serial.println("  age[s]  load[%]  backlog  stretch[%]");
+
+  // oldest entry first
+  index = (index + N2K_RATE_LOG_SIZE - count) % N2K_RATE_LOG_SIZE;
+  for (uint8_t i = 0; i < count; i++)
+  {
+    const tN2kRateLogEntry &entry = entries[(index + i) % N2K_RATE_LOG_SIZE];
+    snprintf(buffer, sizeof(buffer), "%8d %6u.%u %8u %9u.%u",
+             -(int)(count - i), entry.busLoad / 10, entry.busLoad % 10,
+             entry.maxBacklog, entry.stretch / 10, entry.stretch % 10);
+    Serial.println(buffer);
+  }
+}
@@ -0,0 +1,284 @@
+// Doxygen Documentation
+/*! \file 	n2k_receive.cpp
+ *  \brief  Receiving of N2K messages from other devices
+ *
+ * This File contains all the necessary methods to receive the PGNs of
+ * other devices (system time, other engines, alert responses). Only the
+ * PGNs of the dispatch table are admitted by the acceptance filter of the
+ * CAN controller, they are handled in their own RX task.
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         ESP32-WROOM
+ * - Hardware:          az-delivery-devkit-v4
+ */
+
+#include <n2k_receive.h>
+#include <n2k_alert.h>
+
+/// Network management PGNs the library needs (ISO, transport protocol, commanded
+/// address, group function)
+static const unsigned long n2kSystemPgns[] = {59392L, 59904L, 60160L, 60416L, 60928L, 65240L, 126208L};
+
+/// Commanded address, 9 bytes, so it is always carried by the transport
+/// protocol (60416, 60160) and its own CAN id never appears on the bus
+#define N2K_PGN_COMMANDED_ADDRESS 65240L
+
+/// Received PGNs for the library, built from the dispatch table (0 terminated)
+static unsigned long n2kReceiveMessages[N2K_RX_DISPATCH_SIZE + 1];
+
+//****************************************
+// Decode the system time (PGN 126992)
+static void receiveSystemTime(const tN2kMsg &msg, tN2kReceivedData &data)
+{
+  unsigned char sid;
+  uint16_t systemDate;
+  double systemTime;
+  tN2kTimeSource timeSource;
+
+  if (!ParseN2kSystemTime(msg, sid, systemDate, systemTime, timeSource))
+  {
+    return;
+  }
+  data.systemDate = systemDate;
+  data.systemTime = systemTime;
+  data.systemTimeMs = millis();
+}
+
+//****************************************
+// Decode the engine parameters rapid update of other engines (PGN 127488)
+static void receiveEngineRapid(const tN2kMsg &msg, tN2kReceivedData &data)
+{
+  unsigned char instance;
+  double speed;
+  double boostPressure;
+  int8_t tiltTrim;
+
+  if (!ParseN2kEngineParamRapid(msg, instance, speed, boostPressure, tiltTrim) ||
+      instance >= N2K_RX_ENGINE_INSTANCES)
+  {
+    return;
+  }
+  tN2kRemoteEngine &engine = data.engine[instance];
+  engine.source = msg.Source;
+  engine.speed = speed;
+  engine.lastMs = millis();
+}
+
+//****************************************
+// Decode the engine parameters dynamic of other engines (PGN 127489)
+static void receiveEngineDynamic(const tN2kMsg &msg, tN2kReceivedData &data)
+{
+  unsigned char instance;
+  double oilPressure, oilTemp, coolantTemp, voltage, fuelRate, hours, coolantPressure, fuelPressure;
+  int8_t load, torque;
+  tN2kEngineDiscreteStatus1 status1;
+  tN2kEngineDiscreteStatus2 status2;
+
+  if (!ParseN2kEngineDynamicParam(msg, instance, oilPressure, oilTemp, coolantTemp, voltage, fuelRate,
+                                  hours, coolantPressure, fuelPressure, load, torque, status1, status2) ||
+      instance >= N2K_RX_ENGINE_INSTANCES)
+  {
+    return;
+  }
+  tN2kRemoteEngine &engine = data.engine[instance];
+  engine.source = msg.Source;
+  engine.coolantTemp = coolantTemp;
+  engine.oilPressure = oilPressure;
+  engine.lastMs = millis();
+}
+
+//****************************************
+// Hand over the alert response of an MFD (PGN 126984)
+static void receiveAlertResponse(const tN2kMsg &msg, tN2kReceivedData &data)
+{
+  n2kAlertManager.processResponse(msg);
+}
+
+//*************************************************************
+// Dispatch table of all received PGNs
+//
+// To receive a new PGN add a row with its decode function, the
+// acceptance filter of the CAN controller is calculated from this table.
+const tN2kDispatchEntry n2kDispatch[N2K_RX_DISPATCH_SIZE] = {
+    // PGN    decode function
+    {126992L, receiveSystemTime},
+    {127488L, receiveEngineRapid},
+    {127489L, receiveEngineDynamic},
+    {126984L, receiveAlertResponse},
+};
+
+/// receiver the library callbacks are forwarded to
+N2kReceiver *N2kReceiver::receiver = NULL;
+
+//****************************************
+// Constructor
+N2kReceiver::N2kReceiver(N2kCanDriver &driver, N2kScheduler &scheduler)
+    : driver(driver), scheduler(scheduler)
+{
+}
+
+//****************************************
+// Set the acceptance filter and register the handlers
+void N2kReceiver::begin()
+{
+  unsigned long pgns[sizeof(n2kSystemPgns) / sizeof(n2kSystemPgns[0]) + N2K_RX_DISPATCH_SIZE];
+  uint8_t count = 0;
+  uint8_t i;
+
+  this->msgQueue = xQueueCreate(N2K_RX_QUEUE_SIZE, sizeof(tN2kMsg));
+  this->xMutexData = xSemaphoreCreateMutex();
+
+  // admit the network management and the dispatched PGNs only
+  for (i = 0; i < sizeof(n2kSystemPgns) / sizeof(n2kSystemPgns[0]); i++)
+  {
+    // the frames of the transport protocol are admitted, an own entry
+    // would open the second filter for the whole PF range F0-FE
+    if (n2kSystemPgns[i] == N2K_PGN_COMMANDED_ADDRESS)
+    {
+      continue;
+    }
+    pgns[count++] = n2kSystemPgns[i];
+  }
+  for (i = 0; i < N2K_RX_DISPATCH_SIZE; i++)
+  {
+    pgns[count++] = n2kDispatch[i].pgn;
+    n2kReceiveMessages[i] = n2kDispatch[i].pgn;
+  }
+  n2kReceiveMessages[N2K_RX_DISPATCH_SIZE] = 0;
+  this->driver.setAcceptanceFilter(pgns, count);
+
+  // the library calls the handlers in the N2K task
+  receiver = this;
+  NMEA2000.ExtendReceiveMessages(n2kReceiveMessages);
+  NMEA2000.SetMsgHandler(handleMsg);
+  NMEA2000.SetISORqstHandler(handleIsoRequest);
+}
+
+//****************************************
+// Wait for a received message and decode it (RX task only)
+void N2kReceiver::processQueue(TickType_t timeout)
+{
+  // static, so the message does not need space on the stack of the RX task
+  static tN2kMsg msg;
+
+  if (this->msgQueue == NULL || xQueueReceive(this->msgQueue, &msg, timeout) != pdTRUE)
+  {
+    return;
+  }
+
+  for (uint8_t i = 0; i < N2K_RX_DISPATCH_SIZE; i++)
+  {
+    if (n2kDispatch[i].pgn != msg.PGN)
+    {
+      continue;
+    }
+    if (xSemaphoreTake(this->xMutexData, (TickType_t)10) == pdTRUE)
+    {
+      n2kDispatch[i].receive(msg, this->data);
+      xSemaphoreGive(this->xMutexData);
+    }
+    return;
+  }
+}
+
+//****************************************
+// Get a copy of the received data
+tN2kReceivedData N2kReceiver::getData()
+{
+  tN2kReceivedData copy;
+
+  if (this->xMutexData != NULL && xSemaphoreTake(this->xMutexData, (TickType_t)10) == pdTRUE)
+  {
+    copy = this->data;
+    xSemaphoreGive(this->xMutexData);
+  }
+  return copy;
+}
+
+//****************************************
+// Print the received data and the dispatch counters to the terminal
+void N2kReceiver::printLog()
+{
+  char buffer[80];
+  tN2kReceivedData rxData = getData();
+  uint32_t now = millis();
+
+  Serial.println("   PGN dispatched");
+  for (uint8_t i = 0; i < N2K_RX_DISPATCH_SIZE; i++)
+  {
+    snprintf(buffer, sizeof(buffer), "%6lu %10lu", n2kDispatch[i].pgn, (unsigned long)this->dispatchCount[i]);
+    Serial.println(buffer);
+  }
+  snprintf(buffer, sizeof(buffer), "dropped %lu  ISO requests %lu",
+           (unsigned long)this->dropCount, (unsigned long)this->requestCount);
+  Serial.println(buffer);
+
+  if (rxData.systemTime != N2kDoubleNA)
+  {
+    uint32_t seconds = (uint32_t)rxData.systemTime;
+    snprintf(buffer, sizeof(buffer), "System time  day %u  %02lu:%02lu:%02lu UTC  (age %lu ms)",
+             rxData.systemDate, (unsigned long)(seconds / 3600), (unsigned long)((seconds / 60) % 60),
+             (unsigned long)(seconds % 60), (unsigned long)(now - rxData.systemTimeMs));
+    Serial.println(buffer);
+  }
+
+  Serial.println("inst  src   speed  coolant  oil[bar]  age[ms]");
+  for (uint8_t i = 0; i < N2K_RX_ENGINE_INSTANCES; i++)
+  {
+    const tN2kRemoteEngine &engine = rxData.engine[i];
+    if (engine.source == 0xFF)
+    {
+      continue;
+    }
+    snprintf(buffer, sizeof(buffer), "%4u %4u %7.0f %8.1f %9.2f %8lu",
+             i, engine.source,
+             (engine.speed != N2kDoubleNA) ? engine.speed : 0.0,
+             (engine.coolantTemp != N2kDoubleNA) ? engine.coolantTemp - 273.15 : 0.0,
+             (engine.oilPressure != N2kDoubleNA) ? engine.oilPressure / 100000 : 0.0,
+             (unsigned long)(now - engine.lastMs));
+    Serial.println(buffer);
+  }
+}
+
+//****************************************
+// Message handler of the library (N2K task)
+void N2kReceiver::handleMsg(const tN2kMsg &msg)
+{
+  if (receiver == NULL || receiver->msgQueue == NULL)
+  {
+    return;
+  }
+
+  for (uint8_t i = 0; i < N2K_RX_DISPATCH_SIZE; i++)
+  {
+    if (n2kDispatch[i].pgn != msg.PGN)
+    {
+      continue;
+    }
+    // never block the N2K task, a full queue drops the message
+    if (xQueueSend(receiver->msgQueue, &msg, 0) == pdTRUE)
+    {
+      receiver->dispatchCount[i]++;
+    }
+    else
+    {
+      receiver->dropCount++;
+    }
+    return;
+  }
+}
+
+//****************************************
+// ISO request handler of the library (N2K task)
+bool N2kReceiver::handleIsoRequest(unsigned long pgn, unsigned char, int)
+{
+  if (receiver == NULL ||
+      (!receiver->scheduler.requestSend(pgn) && !n2kAlertManager.requestSend(pgn)))
+  {
+    return false;
+  }
+  receiver->requestCount++;
+  return true;
+}
@@ -0,0 +1,490 @@
+// Doxygen Documentation
+/*! \file 	oled_ssd1306.cpp
+ *  \brief  128x64 OLED with SSD1306 or SH1106 controller on I2C
+ *
+ * This File contains all the necessary methods to draw bitmaps and the
+ * character grid of the LCD Panel on a 128x64 OLED. Everything is drawn
+ * into a frame buffer, only the changed tiles of 8x8 pixels are sent.
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         ESP32-WROOM
+ * - Hardware:          az-delivery-devkit-v4
+ */
+
+#include <oled_ssd1306.h>
+
+/// First character of the font
+#define OLED_FONT_FIRST 0x20
+/// Last character of the font
+#define OLED_FONT_LAST 0x7E
+/// Character of the full block (HD44780 ROM)
+#define OLED_FULL_BLOCK 0xFF
+
+// the tile budget of a run (OLED_RUN_TILES) expects the cells at even columns
+static_assert(OLED_GRID_X % 2 == 0 && OLED_CHAR_WIDTH % 2 == 0, "cells have to start at even columns");
+
+//*************************************************************
+// Font 5x7 of the characters 0x20..0x7E
+//
+// One byte per column, LSB = top row
+static const uint8_t oledFont[OLED_FONT_LAST - OLED_FONT_FIRST + 1][OLED_FONT_WIDTH] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00}, // ' '
+    {0x00, 0x00, 0x5F, 0x00, 0x00}, // !
+    {0x00, 0x07, 0x00, 0x07, 0x00}, // "
+    {0x14, 0x7F, 0x14, 0x7F, 0x14}, // #
+    {0x24, 0x2A, 0x7F, 0x2A, 0x12}, // $
+    {0x23, 0x13, 0x08, 0x64, 0x62}, // %
+    {0x36, 0x49, 0x55, 0x22, 0x50}, // &
+    {0x00, 0x05, 0x03, 0x00, 0x00}, // '
+    {0x00, 0x1C, 0x22, 0x41, 0x00}, // (
+    {0x00, 0x41, 0x22, 0x1C, 0x00}, // )
+    {0x14, 0x08, 0x3E, 0x08, 0x14}, // *
+    {0x08, 0x08, 0x3E, 0x08, 0x08}, // +
+    {0x00, 0x50, 0x30, 0x00, 0x00}, // ,
+    {0x08, 0x08, 0x08, 0x08, 0x08}, // -
+    {0x00, 0x60, 0x60, 0x00, 0x00}, // .
+    {0x20, 0x10, 0x08, 0x04, 0x02}, // /
+    {0x3E, 0x51, 0x49, 0x45, 0x3E}, // 0
+    {0x00, 0x42, 0x7F, 0x40, 0x00}, // 1
+    {0x42, 0x61, 0x51, 0x49, 0x46}, // 2
+    {0x21, 0x41, 0x45, 0x4B, 0x31}, // 3
+    {0x18, 0x14, 0x12, 0x7F, 0x10}, // 4
+    {0x27, 0x45, 0x45, 0x45, 0x39}, // 5
+    {0x3C, 0x4A, 0x49, 0x49, 0x30}, // 6
+    {0x01, 0x71, 0x09, 0x05, 0x03}, // 7
+    {0x36, 0x49, 0x49, 0x49, 0x36}, // 8
+    {0x06, 0x49, 0x49, 0x29, 0x1E}, // 9
+    {0x00, 0x36, 0x36, 0x00, 0x00}, // :
+    {0x00, 0x56, 0x36, 0x00, 0x00}, // ;
+    {0x08, 0x14, 0x22, 0x41, 0x00}, // <
+    {0x14, 0x14, 0x14, 0x14, 0x14}, // =
+    {0x00, 0x41, 0x22, 0x14, 0x08}, // >
+    {0x02, 0x01, 0x51, 0x09, 0x06}, // ?
+    {0x32, 0x49, 0x79, 0x41, 0x3E}, // @
+    {0x7E, 0x11, 0x11, 0x11, 0x7E}, // A
+    {0x7F, 0x49, 0x49, 0x49, 0x36}, // B
+    {0x3E, 0x41, 0x41, 0x41, 0x22}, // C
+    {0x7F, 0x41, 0x41, 0x22, 0x1C}, // D
+    {0x7F, 0x49, 0x49, 0x49, 0x41}, // E
+    {0x7F, 0x09, 0x09, 0x09, 0x01}, // F
+    {0x3E, 0x41, 0x49, 0x49, 0x7A}, // G
+    {0x7F, 0x08, 0x08, 0x08, 0x7F}, // H
+    {0x00, 0x41, 0x7F, 0x41, 0x00}, // I
+    {0x20, 0x40, 0x41, 0x3F, 0x01}, // J
+    {0x7F, 0x08, 0x14, 0x22, 0x41}, // K
+    {0x7F, 0x40, 0x40, 0x40, 0x40}, // L
+    {0x7F, 0x02, 0x0C, 0x02, 0x7F}, // M
+    {0x7F, 0x04, 0x08, 0x10, 0x7F}, // N
+    {0x3E, 0x41, 0x41, 0x41, 0x3E}, // O
+    {0x7F, 0x09, 0x09, 0x09, 0x06}, // P
+    {0x3E, 0x41, 0x51, 0x21, 0x5E}, // Q
+    {0x7F, 0x09, 0x19, 0x29, 0x46}, // R
+    {0x46, 0x49, 0x49, 0x49, 0x31}, // S
+    {0x01, 0x01, 0x7F, 0x01, 0x01}, // T
+    {0x3F, 0x40, 0x40, 0x40, 0x3F}, // U
+    {0x1F, 0x20, 0x40, 0x20, 0x1F}, // V
+    {0x3F, 0x40, 0x38, 0x40, 0x3F}, // W
+    {0x63, 0x14, 0x08, 0x14, 0x63}, // X
+    {0x07, 0x08, 0x70, 0x08, 0x07}, // Y
+    {0x61, 0x51, 0x49, 0x45, 0x43}, // Z
+    {0x00, 0x7F, 0x41, 0x41, 0x00}, // [
+    {0x02, 0x04, 0x08, 0x10, 0x20}, // backslash
+    {0x00, 0x41, 0x41, 0x7F, 0x00}, // ]
+    {0x04, 0x02, 0x01, 0x02, 0x04}, // ^
+    {0x40, 0x40, 0x40, 0x40, 0x40}, // _
+    {0x00, 0x01, 0x02, 0x04, 0x00}, // `
+    {0x20, 0x54, 0x54, 0x54, 0x78}, // a
+    {0x7F, 0x48, 0x44, 0x44, 0x38}, // b
+    {0x38, 0x44, 0x44, 0x44, 0x20}, // c
+    {0x38, 0x44, 0x44, 0x48, 0x7F}, // d
+    {0x38, 0x54, 0x54, 0x54, 0x18}, // e
+    {0x08, 0x7E, 0x09, 0x01, 0x02}, // f
+    {0x0C, 0x52, 0x52, 0x52, 0x3E}, // g
+    {0x7F, 0x08, 0x04, 0x04, 0x78}, // h
+    {0x00, 0x44, 0x7D, 0x40, 0x00}, // i
+    {0x20, 0x40, 0x44, 0x3D, 0x00}, // j
+    {0x7F, 0x10, 0x28, 0x44, 0x00}, // k
+    {0x00, 0x41, 0x7F, 0x40, 0x00}, // l
+    {0x7C, 0x04, 0x18, 0x04, 0x78}, // m
+    {0x7C, 0x08, 0x04, 0x04, 0x78}, // n
+    {0x38, 0x44, 0x44, 0x44, 0x38}, // o
+    {0x7C, 0x14, 0x14, 0x14, 0x08}, // p
+    {0x08, 0x14, 0x14, 0x18, 0x7C}, // q
+    {0x7C, 0x08, 0x04, 0x04, 0x08}, // r
+    {0x48, 0x54, 0x54, 0x54, 0x20}, // s
+    {0x04, 0x3F, 0x44, 0x40, 0x20}, // t
+    {0x3C, 0x40, 0x40, 0x20, 0x7C}, // u
+    {0x1C, 0x20, 0x40, 0x20, 0x1C}, // v
+    {0x3C, 0x40, 0x30, 0x40, 0x3C}, // w
+    {0x44, 0x28, 0x10, 0x28, 0x44}, // x
+    {0x0C, 0x50, 0x50, 0x50, 0x3C}, // y
+    {0x44, 0x64, 0x54, 0x4C, 0x44}, // z
+    {0x00, 0x08, 0x36, 0x41, 0x00}, // {
+    {0x00, 0x00, 0x7F, 0x00, 0x00}, // |
+    {0x00, 0x41, 0x36, 0x08, 0x00}, // }
+    {0x08, 0x04, 0x08, 0x10, 0x08}, // ~
+};
+
+//*************************************************************
+// Initialisation of the controllers (page addressing mode)
+//
+// display off, clock, multiplex 64, offset 0, start line 0, charge pump,
+// segment remap, COM scan down, COM pins, contrast, precharge, VCOMH,
+// output follows RAM, not inverted
+static const uint8_t oledInitSsd1306[] = {
+    0xAE, 0xD5, 0x80, 0xA8, 0x3F, 0xD3, 0x00, 0x40, 0x8D, 0x14, 0x20, 0x02,
+    0xA1, 0xC8, 0xDA, 0x12, 0x81, 0xCF, 0xD9, 0xF1, 0xDB, 0x40, 0xA4, 0xA6};
+
+static const uint8_t oledInitSh1106[] = {
+    0xAE, 0xD5, 0x80, 0xA8, 0x3F, 0xD3, 0x00, 0x40, 0xAD, 0x8B,
+    0xA1, 0xC8, 0xDA, 0x12, 0x81, 0xCF, 0xD9, 0x22, 0xDB, 0x40, 0xA4, 0xA6};
+
+/// Row which continues the end of a row (HD44780 20x4: 1 -> 3 -> 2 -> 4 -> 1)
+static const uint8_t oledNextRow[OLED_ROWS] = {2, 3, 1, 0};
+
+//****************************************
+// Constructor
+OledSsd1306::OledSsd1306(uint8_t address, uint16_t controller)
+    : address(address), controller(controller)
+{
+  memset(cells, ' ', sizeof(cells));
+  memset(glyphs, 0, sizeof(glyphs));
+  memset(frame, 0, sizeof(frame));
+  memset(dirtyTiles, 0, sizeof(dirtyTiles));
+}
+
+//****************************************
+// Initialise the controller and clear the OLED
+void OledSsd1306::begin(uint8_t cols, uint8_t rows, TwoWire &wire)
+{
+  this->wire = &wire;
+  this->cols = (cols > OLED_COLS) ? OLED_COLS : cols;
+  this->rows = (rows > OLED_ROWS) ? OLED_ROWS : rows;
+
+  // wait for the controller after power on
+  delay(50);
+  if (this->controller == OLED_SH1106)
+  {
+    sendCommands(oledInitSh1106, sizeof(oledInitSh1106));
+  }
+  else
+  {
+    sendCommands(oledInitSsd1306, sizeof(oledInitSsd1306));
+  }
+
+  // the RAM is undefined after power on, send the whole frame buffer
+  memset(this->cells, ' ', sizeof(this->cells));
+  memset(this->frame, 0, sizeof(this->frame));
+  for (uint8_t page = 0; page < OLED_PAGES; page++)
+  {
+    this->dirtyTiles[page] = 0xFFFF;
+  }
+  endUpdate();
+  this->cursorCol = 0;
+  this->cursorRow = 0;
+
+  uint8_t on = OLED_CMD_DISPLAY_ON;
+  sendCommands(&on, 1);
+}
+
+//****************************************
+// Set the contrast
+void OledSsd1306::setBacklight(uint8_t brightness)
+{
+  uint8_t commands[3];
+
+  if (brightness == 0)
+  {
+    commands[0] = OLED_CMD_DISPLAY_OFF;
+    sendCommands(commands, 1);
+    return;
+  }
+  commands[0] = OLED_CMD_CONTRAST;
+  commands[1] = brightness;
+  commands[2] = OLED_CMD_DISPLAY_ON;
+  sendCommands(commands, sizeof(commands));
+}
+
+//****************************************
+// Draw characters at the cursor position
+void OledSsd1306::write(const uint8_t *buf, size_t len)
+{
+  for (size_t i = 0; i < len; i++)
+  {
+    this->cells[this->cursorRow][this->cursorCol] = buf[i];
+    drawCell(this->cursorCol, this->cursorRow);
+
+    // the cursor moves on like in the DDRAM of the HD44780
+    if (++this->cursorCol >= this->cols)
+    {
+      this->cursorCol = 0;
+      this->cursorRow = oledNextRow[this->cursorRow];
+      if (this->cursorRow >= this->rows)
+      {
+        this->cursorRow = 0;
+      }
+    }
+  }
+}
+
+//****************************************
+// Move the cursor and draw characters
+void OledSsd1306::writeAt(uint8_t col, uint8_t row, const uint8_t *buf, size_t len)
+{
+  this->cursorRow = (row >= this->rows) ? this->rows - 1 : row;
+  this->cursorCol = (col >= this->cols) ? this->cols - 1 : col;
+  write(buf, len);
+}
+
+//****************************************
+// Define a user glyph and draw the characters which show it again
+void OledSsd1306::createChar(uint8_t location, const uint8_t charmap[8])
+{
+  location &= 0x07;
+  memcpy(this->glyphs[location], charmap, 8);
+
+  // characters 0..7 and 8..15 show the same glyph
+  for (uint8_t row = 0; row < this->rows; row++)
+  {
+    for (uint8_t col = 0; col < this->cols; col++)
+    {
+      uint8_t c = this->cells[row][col];
+      if (c < 16 && (c & 0x07) == location)
+      {
+        drawCell(col, row);
+      }
+    }
+  }
+}
+
+//****************************************
+// Draw a bitmap into the frame buffer
+void OledSsd1306::drawBitmap(uint8_t x, uint8_t y, uint8_t width, uint8_t height, const uint8_t *bitmap)
+{
+  uint8_t shift = y % 8;
+
+  for (uint8_t band = 0; band < (height + 7) / 8; band++)
+  {
+    uint8_t page = y / 8 + band;
+    if (page >= OLED_PAGES)
+    {
+      break;
+    }
+
+    // the rows below the bitmap are not drawn
+    uint8_t bandRows = height - band * 8;
+    uint8_t mask = (bandRows >= 8) ? 0xFF : (uint8_t)((1 << bandRows) - 1);
+    for (uint8_t i = 0; i < width && x + i < OLED_WIDTH; i++)
+    {
+      uint8_t bits = bitmap[band * width + i];
+
+      // a band which does not start at a page covers two pages
+      mergeFrameByte(page, x + i, (uint8_t)(mask << shift), (uint8_t)(bits << shift));
+      if (shift != 0 && page + 1 < OLED_PAGES)
+      {
+        mergeFrameByte(page + 1, x + i, mask >> (8 - shift), bits >> (8 - shift));
+      }
+    }
+  }
+}
+
+//****************************************
+// Set or clear the pixels of a rectangle in the frame buffer
+void OledSsd1306::fillRect(uint8_t x, uint8_t y, uint8_t width, uint8_t height, bool on)
+{
+  uint16_t right = (x + width > OLED_WIDTH) ? OLED_WIDTH : x + width;
+  uint16_t bottom = (y + height > OLED_PAGES * 8) ? OLED_PAGES * 8 : y + height;
+
+  for (uint16_t top = y; top < bottom; top = (top / 8 + 1) * 8)
+  {
+    // rows of the rectangle in this page
+    uint8_t page = top / 8;
+    uint8_t end = (bottom >= (page + 1) * 8) ? 8 : bottom - page * 8;
+    uint8_t mask = (uint8_t)((0xFF << (top % 8)) & (0xFF >> (8 - end)));
+
+    for (uint16_t column = x; column < right; column++)
+    {
+      mergeFrameByte(page, column, mask, on ? 0xFF : 0x00);
+    }
+  }
+}
+
+//****************************************
+// Send the dirty tiles of the frame buffer
+void OledSsd1306::endUpdate()
+{
+  uint32_t errors = this->i2cErrorCount;
+
+  for (uint8_t page = 0; page < OLED_PAGES; page++)
+  {
+    uint16_t dirty = this->dirtyTiles[page];
+    uint8_t tile = 0;
+    while (dirty != 0 && tile < OLED_TILES)
+    {
+      if ((dirty & (1 << tile)) == 0)
+      {
+        tile++;
+        continue;
+      }
+
+      // a run of dirty tiles is sent with one position command
+      uint8_t end = tile + 1;
+      while (end < OLED_TILES && (dirty & (1 << end)))
+      {
+        end++;
+      }
+      sendData(page, tile * OLED_TILE_WIDTH, (end - tile) * OLED_TILE_WIDTH);
+      tile = end;
+    }
+    this->dirtyTiles[page] = 0;
+  }
+
+  // the position of a run may have been lost, send the whole frame again
+  if (this->i2cErrorCount != errors)
+  {
+    memset(this->dirtyTiles, 0xFF, sizeof(this->dirtyTiles));
+  }
+}
+
+//****************************************
+// Draw a character cell into the frame buffer
+void OledSsd1306::drawCell(uint8_t col, uint8_t row)
+{
+  uint8_t columns[OLED_FONT_WIDTH];
+  uint8_t bitmap[OLED_PAGES_PER_ROW][OLED_CHAR_WIDTH];
+
+  getCharColumns(this->cells[row][col], columns);
+  for (uint8_t i = 0; i < OLED_CHAR_WIDTH; i++)
+  {
+    uint8_t bits = (i < OLED_FONT_WIDTH) ? columns[i] : 0;
+
+    // each pixel row is drawn twice
+    uint16_t tall = 0;
+    for (uint8_t y = 0; y < 8; y++)
+    {
+      if (bits & (1 << y))
+      {
+        tall |= 3 << (2 * y);
+      }
+    }
+    bitmap[0][i] = tall & 0xFF;
+    bitmap[1][i] = tall >> 8;
+  }
+  drawBitmap(OLED_GRID_X + col * OLED_CHAR_WIDTH, row * OLED_PAGES_PER_ROW * 8,
+             OLED_CHAR_WIDTH, OLED_PAGES_PER_ROW * 8, &bitmap[0][0]);
+}
+
+//****************************************
+// Get the pixel columns of a character
+void OledSsd1306::getCharColumns(uint8_t c, uint8_t columns[OLED_FONT_WIDTH]) const
+{
+  if (c < 16)
+  {
+    // user glyph, rows to columns (bit 4 of a row is the left column)
+    const uint8_t *glyph = this->glyphs[c & 0x07];
+    for (uint8_t i = 0; i < OLED_FONT_WIDTH; i++)
+    {
+      uint8_t bits = 0;
+      for (uint8_t y = 0; y < 8; y++)
+      {
+        if (glyph[y] & (0x10 >> i))
+        {
+          bits |= 1 << y;
+        }
+      }
+      columns[i] = bits;
+    }
+  }
+  else if (c >= OLED_FONT_FIRST && c <= OLED_FONT_LAST)
+  {
+    memcpy(columns, oledFont[c - OLED_FONT_FIRST], OLED_FONT_WIDTH);
+  }
+  else if (c == OLED_FULL_BLOCK)
+  {
+    memset(columns, 0xFF, OLED_FONT_WIDTH);
+  }
+  else
+  {
+    // characters of the HD44780 ROM which are not used
+    memset(columns, 0, OLED_FONT_WIDTH);
+  }
+}
+
+//****************************************
+// Set a byte of the frame buffer and mark its tile if it has changed
+void OledSsd1306::setFrameByte(uint8_t page, uint8_t x, uint8_t value)
+{
+  if (this->frame[page][x] != value)
+  {
+    this->frame[page][x] = value;
+    this->dirtyTiles[page] |= 1 << (x / OLED_TILE_WIDTH);
+  }
+}
+
+//****************************************
+// Set some pixels of a byte of the frame buffer
+void OledSsd1306::mergeFrameByte(uint8_t page, uint8_t x, uint8_t mask, uint8_t bits)
+{
+  setFrameByte(page, x, (this->frame[page][x] & ~mask) | (bits & mask));
+}
+
+//****************************************
+// Send commands with one I2C transaction
+void OledSsd1306::sendCommands(const uint8_t *commands, size_t len)
+{
+  if (this->wire == NULL)
+  {
+    return;
+  }
+  this->wire->beginTransmission(this->address);
+  this->wire->write((uint8_t)OLED_CONTROL_COMMAND);
+  this->wire->write(commands, len);
+  if (this->wire->endTransmission() != 0)
+  {
+    this->i2cErrorCount++;
+  }
+
+  // address byte, control byte and the commands
+  this->i2cByteCount += 2 + len;
+  this->i2cTransactionCount++;
+}
+
+//****************************************
+// Send a run of the frame buffer of one page
+void OledSsd1306::sendData(uint8_t page, uint8_t x, uint8_t len)
+{
+  if (this->wire == NULL)
+  {
+    return;
+  }
+
+  uint8_t column = x;
+  if (this->controller == OLED_SH1106)
+  {
+    column += OLED_SH1106_COLUMN_OFFSET;
+  }
+  uint8_t position[3] = {(uint8_t)(OLED_CMD_PAGE | page),
+                         (uint8_t)(OLED_CMD_COLUMN_LOW | (column & 0x0F)),
+                         (uint8_t)(OLED_CMD_COLUMN_HIGH | (column >> 4))};
+  sendCommands(position, sizeof(position));
+
+  // the column address is increased by the controller
+  while (len > 0)
+  {
+    uint8_t chunk = (len > OLED_I2C_DATA_CHUNK) ? OLED_I2C_DATA_CHUNK : len;
+    this->wire->beginTransmission(this->address);
+    this->wire->write((uint8_t)OLED_CONTROL_DATA);
+    this->wire->write(&this->frame[page][x], chunk);
+    if (this->wire->endTransmission() != 0)
+    {
+      this->i2cErrorCount++;
+    }
+
+    this->i2cByteCount += 2 + chunk;
+    this->i2cTransactionCount++;
+    x += chunk;
+    len -= chunk;
+  }
+}
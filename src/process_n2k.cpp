@@ -11,6 +11,9 @@
 
 #include <process_n2k.h>
 
+/// Cache of the encoded messages of the channels in \ref n2kChannels
+static N2kMsgCache n2kChannelCache[N2K_CHANNEL_COUNT];
+
 //****************************************
 // Setup for the Nk2 Module
 void setupN2K()
@@ -51,108 +54,790 @@ void setupN2K()
   //  If you want to use simple ascii monitor like Arduino Serial Monitor, uncomment next line
   // NMEA2000.SetForwardType(tNMEA2000::fwdt_Text); // Show in clear text. Leave uncommented for default Actisense format.
 
-  // If you also want to see all traffic on the bus use N2km_ListenAndNode instead of N2km_NodeOnly below
-  NMEA2000.SetMode(tNMEA2000::N2km_NodeOnly, 0xAA);
+  // Listen to the PGNs of other devices, the acceptance filter of the CAN
+  // controller only admits the PGNs of the dispatch table (N2kReceiver)
+  NMEA2000.SetMode(tNMEA2000::N2km_ListenAndNode, 0xAA);
   // NMEA2000.SetDebugMode(tNMEA2000::dm_Actisense); // Uncomment this, so you can test code without CAN bus chips on Arduino Mega
-  // NMEA2000.EnableForward(false); // Disable all msg forwarding to USB (=Serial)
+  NMEA2000.EnableForward(false); // Disable all msg forwarding to USB (=Serial), it is used by the terminal
   //  Here we tell library, which PGNs we transmit
   NMEA2000.ExtendTransmitMessages(TransmitMessages);
 
+  // PGN and instance of the cached channels for the log
+  for (uint8_t i = 0; i < N2K_CHANNEL_COUNT; i++)
+  {
+    n2kChannelCache[i].setId(n2kChannels[i].pgn, n2kChannels[i].instance);
+  }
+
   NMEA2000.Open();
 }
 
 //*************************************************************
-// Sends out all the messages in a fast timeframe
-void SendN2kEngineParmFast(VolvoPentaData *n2kVolvoData)
+// Cache of the encoded messages, one entry per PGN and instance
+static N2kMsgCache n2kMsgCache[n2kCache_count] = {
+    N2kMsgCache(127489L, N2K_ENGINE_INSTANCE),
+    N2kMsgCache(127489L, N2K_ALTERNATOR1_INSTANCE),
+    N2kMsgCache(127493L, N2K_ENGINE_INSTANCE),
+};
+
+//*************************************************************
+// Mapping of the acquired values to the PGNs
+//
+// Every row is sent as its own message by SendN2kChannels. To send a
+// new value add it to tVolvoPentaData (in the type of its PGN), fill it
+// in AcquireData::convertDataToN2k and add a row here.
+const tN2kChannel n2kChannels[N2K_CHANNEL_COUNT] = {
+    // PGN    instance  param  value in tVolvoPentaData
+    {127488L, N2K_ENGINE_INSTANCE, 0, offsetof(tVolvoPentaData, engine_speed)},
+    {127488L, N2K_ALTERNATOR1_INSTANCE, 0, offsetof(tVolvoPentaData, alternator1_speed)},
+    {127488L, N2K_SHAFT_INSTANCE, 0, offsetof(tVolvoPentaData, shaft_speed)},
+    {127488L, N2K_ALTERNATOR2_INSTANCE, 0, offsetof(tVolvoPentaData, alternator2_speed)},
+    {127501L, N2K_SWITCH_BANK_INSTANCE, N2K_SWITCH_BANK_SIZE, offsetof(tVolvoPentaData, contacts)},
+    {127751L, N2K_DC_BATTERY_INSTANCE, 0, offsetof(tVolvoPentaData, battery_dc_voltage)},
+    {127751L, N2K_DC_MCP3204_INSTANCE, 0, offsetof(tVolvoPentaData, mcp3204_ch1_voltage)},
+    {127751L, N2K_DC_MCP3204_INSTANCE + 1, 0, offsetof(tVolvoPentaData, mcp3204_ch2_voltage)},
+    {127751L, N2K_DC_MCP3204_INSTANCE + 2, 0, offsetof(tVolvoPentaData, mcp3204_ch3_voltage)},
+    {127751L, N2K_DC_MCP3204_INSTANCE + 3, 0, offsetof(tVolvoPentaData, mcp3204_ch4_voltage)},
+    {130316L, 0, N2kts_ExhaustGasTemperature, offsetof(tVolvoPentaData, exhaust_temperature)},
+    {130316L, 0, N2kts_HeatIndexTemperature, offsetof(tVolvoPentaData, engine_coolant_temperature_wall)},
+};
+
+//*************************************************************
+// Transmit schedule for all PGNs
+//
+// The periods are the nominal rates of the PGNs, the phases spread the
+// transmissions over the 100ms raster of the engine rapid update. The
+// engine data and the contacts keep their rate, transmission, voltages
+// and temperatures are slowed down on a busy bus.
+const tN2kScheduleEntry n2kSchedule[N2K_SCHEDULE_SIZE] = {
+    // PGN    period  max  phase  send function (NULL = n2kChannels)
+    {127488L, 100, 100, 0, NULL},
+    {127489L, 500, 500, 30, SendN2kEngineDynamic},
+    {127493L, 500, 2000, 280, SendN2kTransmission},
+    {127501L, 2000, 2000, 90, NULL},
+    {127751L, 1500, 6000, 70, NULL},
+    {130316L, 2000, 10000, 60, NULL},
+};
+
+//*************************************************************
+// Create the writer mutex
+void N2kDataExchange::begin()
+{
+  this->xMutexWriter = xSemaphoreCreateMutex();
+}
+
+//*************************************************************
+// Get the back buffer to fill it
+tVolvoPentaData *N2kDataExchange::beginWrite()
+{
+  // Check if the semaphore used for the producers is initialized
+  if (this->xMutexWriter == NULL)
+  {
+    return NULL;
+  }
+  // Attempt to obtain the semaphore. If unavailable, wait 5ms to see if it becomes free.
+  if (xSemaphoreTake(this->xMutexWriter, (TickType_t)5) != pdTRUE)
+  {
+    return NULL;
+  }
+  return &this->slot[this->backIndex].data;
+}
+
+//*************************************************************
+// Publish the back buffer and give back the writer mutex
+void N2kDataExchange::publish()
 {
-  tN2kMsg N2kMsg;
+  tN2kDataSlot &back = this->slot[this->backIndex];
+
+  back.sequence = ++this->publishCount;
+  back.publishMs = millis();
 
-  static unsigned char EngineInstance = 0;
-  static unsigned char EngineInstanceAlt1 = 1;
+  // copy for the readers besides the N2K task
+  portENTER_CRITICAL(&this->muxSnapshot);
+  this->snapshot = back;
+  portEXIT_CRITICAL(&this->muxSnapshot);
 
-  // Data not measured now
-  double EngineOilTemp = N2kDoubleNA;
+  // the back buffer becomes ready, the old ready buffer the new back buffer
+  uint32_t old = this->readyIndex.exchange(this->backIndex | N2K_DATA_FRESH);
+  this->backIndex = old & N2K_DATA_INDEX_MASK;
+
+  // unlock the producers again
+  xSemaphoreGive(this->xMutexWriter);
+}
+
+//*************************************************************
+// Get the latest published data (N2K task only)
+const tVolvoPentaData &N2kDataExchange::consume()
+{
+  if ((this->readyIndex.load() & N2K_DATA_FRESH) != 0)
+  {
+    // the ready buffer becomes the front buffer, the old front buffer ready
+    uint32_t old = this->readyIndex.exchange(this->frontIndex);
+    this->frontIndex = old & N2K_DATA_INDEX_MASK;
+
+    const tN2kDataSlot &front = this->slot[this->frontIndex];
+    this->consumeCount++;
+    if (front.sequence > this->lastSequence + 1)
+    {
+      this->overwriteCount += front.sequence - this->lastSequence - 1;
+    }
+    this->lastSequence = front.sequence;
+  }
+  else
+  {
+    this->reuseCount++;
+  }
 
-  // Check if the semaphore used for data protection is initialized
-  if (xMutexVolvoN2kData != NULL)
+  // check the age of the data
+  const tN2kDataSlot &front = this->slot[this->frontIndex];
+  if (front.sequence > 0)
   {
-    // Attempt to obtain the semaphore. If unavailable, wait 5ms to see if it becomes free.
-    if (xSemaphoreTake(xMutexVolvoN2kData, (TickType_t)5) == pdTRUE)
+    uint32_t ageMs = millis() - front.publishMs;
+    if (ageMs > this->maxAgeMs)
     {
-      // Send exhaust temperature
-      SetN2kTemperatureExt(N2kMsg, 0, 0, N2kts_ExhaustGasTemperature, (n2kVolvoData->exhaust_temperature));
-      NMEA2000.SendMsg(N2kMsg);
+      this->maxAgeMs = ageMs;
+    }
+    if (ageMs > N2K_DATA_MAX_AGE_MS)
+    {
+      this->staleCount++;
+    }
+  }
+  return front.data;
+}
+
+//*************************************************************
+// Copy the last published data (any task except the producers)
+bool N2kDataExchange::getSnapshot(tVolvoPentaData &data) const
+{
+  portENTER_CRITICAL(&this->muxSnapshot);
+  data = this->snapshot.data;
+  bool published = this->snapshot.sequence > 0;
+  portEXIT_CRITICAL(&this->muxSnapshot);
+  return published;
+}
 
-      // Send engine speed
-      SetN2kEngineParamRapid(N2kMsg, EngineInstance, n2kVolvoData->engine_speed, 0, 0);
-      NMEA2000.SendMsg(N2kMsg);
+//*************************************************************
+// Print the publish and consume counters to the terminal
+void N2kDataExchange::printLog() const
+{
+  char buffer[80];
 
-      // send engine dynamic data
-      SetN2kEngineDynamicParam(N2kMsg, EngineInstance,
-                               n2kVolvoData->engine_oel_pressure,
-                               EngineOilTemp,
-                               n2kVolvoData->engine_coolant_temperature,
-                               n2kVolvoData->battery_voltage,
-                               N2kDoubleNA,
-                               n2kVolvoData->engine_seconds,
-                               N2kDoubleNA,
-                               N2kDoubleNA,
-                               N2kInt8NA,
-                               N2kInt8NA,
-                               n2kVolvoData->engineDiscreteStatus1,
-                               n2kVolvoData->engineDiscreteStatus2);
-      NMEA2000.SendMsg(N2kMsg);
+  Serial.println("published consumed overwritten   reused    stale maxAge[ms]");
+  snprintf(buffer, sizeof(buffer), "%9lu %8lu %11lu %8lu %8lu %10lu",
+           (unsigned long)this->publishCount, (unsigned long)this->consumeCount,
+           (unsigned long)this->overwriteCount, (unsigned long)this->reuseCount,
+           (unsigned long)this->staleCount, (unsigned long)this->maxAgeMs);
+  Serial.println(buffer);
+}
 
-      // send Balmar Alternator Speed (rapid) as "Instance 1"
-      SetN2kEngineParamRapid(N2kMsg, EngineInstanceAlt1,
-                             n2kVolvoData->alternator1_speed,
-                             0,
-                             0);
-      NMEA2000.SendMsg(N2kMsg);
+//*************************************************************
+// Constructor for the N2kScheduler
+N2kScheduler::N2kScheduler(N2kDataExchange &exchange) : exchange(exchange)
+{
+  for (uint8_t i = 0; i < N2K_SCHEDULE_SIZE; i++)
+  {
+    nextDueMs[i] = 0;
+  }
+}
 
-      // send Balmar Alternator Data (dynamic) as "Instance 1"
-      SetN2kEngineDynamicParam(N2kMsg, EngineInstanceAlt1,
-                               N2kDoubleNA,
-                               N2kDoubleNA,
-                               n2kVolvoData->alternator1_temperature,
-                               N2kDoubleNA,
-                               N2kDoubleNA,
-                               N2kDoubleNA,
-                               N2kDoubleNA,
-                               N2kDoubleNA,
-                               N2kInt8NA,
-                               N2kInt8NA,
-                               n2kVolvoData->alternatorDiscreteStatus1,
-                               0);
-      NMEA2000.SendMsg(N2kMsg);
+//*************************************************************
+// Process one tick of the scheduler
+void N2kScheduler::processTick()
+{
+  uint32_t now = millis();
+  const tVolvoPentaData *n2kData = NULL;
+  uint8_t i;
 
-      // send gearbox data
-      SetN2kPGN127493(N2kMsg, EngineInstance, N2kTG_Unknown, N2kDoubleNA, n2kVolvoData->gearbox_temperature, 0);
-      NMEA2000.SendMsg(N2kMsg);
+  // initialize the due times with the phase of each PGN
+  if (!this->started)
+  {
+    for (i = 0; i < N2K_SCHEDULE_SIZE; i++)
+    {
+      this->nextDueMs[i] = now + n2kSchedule[i].phaseMs;
+    }
+    this->started = true;
+  }
+
+  for (i = 0; i < N2K_SCHEDULE_SIZE; i++)
+  {
+    // check if the PGN is due (rollover safe)
+    if ((int32_t)(now - this->nextDueMs[i]) < 0)
+    {
+      continue;
+    }
+
+    // take the latest data once per tick
+    if (n2kData == NULL)
+    {
+      n2kData = &this->exchange.consume();
+    }
+
+    uint32_t startUs = micros();
+    if (n2kSchedule[i].send != NULL)
+    {
+      n2kSchedule[i].send(*n2kData);
+    }
+    else
+    {
+      SendN2kChannels(n2kSchedule[i].pgn, *n2kData);
+    }
+    uint32_t durationUs = micros() - startUs;
+
+    // log the timing of the transmission
+    tN2kTxTiming &log = this->timing[i];
+    if (log.count > 0)
+    {
+      log.lastIntervalMs = now - log.lastSendMs;
+      if (log.lastIntervalMs < log.minIntervalMs)
+      {
+        log.minIntervalMs = log.lastIntervalMs;
+      }
+      if (log.lastIntervalMs > log.maxIntervalMs)
+      {
+        log.maxIntervalMs = log.lastIntervalMs;
+      }
+    }
+    if (durationUs > log.maxDurationUs)
+    {
+      log.maxDurationUs = durationUs;
+    }
+    log.lastSendMs = now;
+    log.count++;
+
+    // keep the raster, but skip missed periods instead of bursting
+    uint16_t period = getPeriod(i);
+    this->nextDueMs[i] += period;
+    if ((int32_t)(now - this->nextDueMs[i]) >= 0)
+    {
+      this->nextDueMs[i] = now + period;
     }
-    // unlock the resource again
-    xSemaphoreGive(xMutexVolvoN2kData);
   }
 }
 
 //*************************************************************
-// Sends out all the messages in a fast timeframe
-void SendN2kEngineParmSlow(VolvoPentaData *n2kVolvoData)
+// Print the transmit timing log to the terminal
+void N2kScheduler::printTimingLog()
 {
-  tN2kMsg N2kMsg;
-  // Attempt to obtain the semaphore. If unavailable, wait 5ms to see if it becomes free.
-  if (xMutexVolvoN2kData != NULL)
+  char buffer[80];
+
+  Serial.println("   PGN  period  count   last    min    max  maxDur[us]");
+  for (uint8_t i = 0; i < N2K_SCHEDULE_SIZE; i++)
   {
-    // See if we can obtain the semaphore. If the semaphore is not
-    // available wait 5ms to see if it becomes free.
-    if (xSemaphoreTake(xMutexVolvoN2kData, (TickType_t)5) == pdTRUE)
+    const tN2kTxTiming &log = this->timing[i];
+    snprintf(buffer, sizeof(buffer), "%6lu %7u %6lu %6lu %6lu %6lu %11lu",
+             n2kSchedule[i].pgn, getPeriod(i),
+             (unsigned long)log.count, (unsigned long)log.lastIntervalMs,
+             (unsigned long)(log.count > 1 ? log.minIntervalMs : 0),
+             (unsigned long)log.maxIntervalMs, (unsigned long)log.maxDurationUs);
+    Serial.println(buffer);
+  }
+
+  Serial.println("   PGN inst  encoded   cached");
+  for (uint8_t i = 0; i < n2kCache_count; i++)
+  {
+    n2kMsgCache[i].printLog();
+  }
+  for (uint8_t i = 0; i < N2K_CHANNEL_COUNT; i++)
+  {
+    n2kChannelCache[i].printLog();
+  }
+
+  this->exchange.printLog();
+}
+
+//*************************************************************
+// Send a PGN of the schedule with the next tick (ISO request)
+bool N2kScheduler::requestSend(unsigned long pgn)
+{
+  for (uint8_t i = 0; i < N2K_SCHEDULE_SIZE; i++)
+  {
+    if (n2kSchedule[i].pgn == pgn)
     {
-      // Send Temperature of Seewater Cool Pipe
-      SetN2kTemperatureExt(N2kMsg, 0, 0, N2kts_HeatIndexTemperature, (n2kVolvoData->engine_coolant_temperature_wall));
-      NMEA2000.SendMsg(N2kMsg);
+      // the raster of the PGN starts again from now
+      this->nextDueMs[i] = millis();
+      return true;
+    }
+  }
+  return false;
+}
 
-      // unlock the resource again
-      xSemaphoreGive(xMutexVolvoN2kData);
+//*************************************************************
+// Get the current period of a PGN of the schedule
+uint16_t N2kScheduler::getPeriod(uint8_t index) const
+{
+  const tN2kScheduleEntry &entry = n2kSchedule[index];
+
+  if (entry.maxPeriodMs <= entry.periodMs)
+  {
+    return entry.periodMs;
+  }
+  return entry.periodMs + (uint16_t)(((uint32_t)(entry.maxPeriodMs - entry.periodMs) * this->stretch) /
+                                     N2K_RATE_STRETCH_MAX);
+}
+
+//*************************************************************
+// Check if a physical value is not available (NaN or the NA of the library)
+static bool N2kScaleIsNA(double value)
+{
+  return isnan(value) || (value == N2kDoubleNA);
+}
+
+//*************************************************************
+// Scale a value to an unsigned 16 bit N2K field
+uint16_t N2kScaleUInt16(double value, double resolution)
+{
+  if (N2kScaleIsNA(value))
+  {
+    return N2kUInt16NA;
+  }
+
+  double scaled = round(value / resolution);
+
+  // the same range as Add2ByteUDouble of the library
+  if (scaled >= 0 && scaled < N2K_UINT16_OR)
+  {
+    return (uint16_t)scaled;
+  }
+  return N2K_UINT16_OR;
+}
+
+//*************************************************************
+// Scale a value to a signed 16 bit N2K field
+int16_t N2kScaleInt16(double value, double resolution)
+{
+  if (N2kScaleIsNA(value))
+  {
+    return N2kInt16NA;
+  }
+
+  double scaled = round(value / resolution);
+
+  // the same range as Add2ByteDouble of the library
+  if (scaled >= -0x8000 && scaled < N2K_INT16_OR)
+  {
+    return (int16_t)scaled;
+  }
+  return N2K_INT16_OR;
+}
+
+//*************************************************************
+// Scale a value to an unsigned 32 bit N2K field
+uint32_t N2kScaleUInt32(double value, double resolution)
+{
+  if (N2kScaleIsNA(value))
+  {
+    return N2kUInt32NA;
+  }
+
+  double scaled = round(value / resolution);
+
+  // the same range as Add4ByteUDouble of the library
+  if (scaled >= 0 && scaled < N2K_UINT32_OR)
+  {
+    return (uint32_t)scaled;
+  }
+  return N2K_UINT32_OR;
+}
+
+//*************************************************************
+// Scale a value to an unsigned 24 bit N2K field
+uint32_t N2kScaleUInt24(double value, double resolution)
+{
+  if (N2kScaleIsNA(value))
+  {
+    return N2K_UINT24_NA;
+  }
+
+  double scaled = round(value / resolution);
+
+  // the same range as Add3ByteUDouble of the library
+  if (scaled >= 0 && scaled < N2K_UINT24_OR)
+  {
+    return (uint32_t)scaled;
+  }
+  return N2K_UINT24_OR;
+}
+
+//*************************************************************
+// Encode the engine parameters rapid update (PGN 127488)
+void SetN2kEngineRapidScaled(tN2kMsg &N2kMsg, uint8_t instance, uint16_t speed)
+{
+  N2kMsg.SetPGN(127488L);
+  N2kMsg.Priority = 2;
+  N2kMsg.AddByte(instance);
+  N2kMsg.Add2ByteUInt(speed);
+  N2kMsg.Add2ByteUInt(0); // boost pressure
+  N2kMsg.AddByte(0);      // tilt/trim
+  N2kMsg.AddByte(0xff);   // reserved
+  N2kMsg.AddByte(0xff);   // reserved
+}
+
+//*************************************************************
+// Encode the engine parameters dynamic (PGN 127489)
+void SetN2kEngineDynamicScaled(tN2kMsg &N2kMsg, uint8_t instance, uint16_t oilPressure,
+                               uint16_t coolantTemp, int16_t voltage, uint32_t seconds,
+                               uint16_t status1, uint16_t status2)
+{
+  N2kMsg.SetPGN(127489L);
+  N2kMsg.Priority = 2;
+  N2kMsg.AddByte(instance);
+  N2kMsg.Add2ByteUInt(oilPressure);
+  N2kMsg.Add2ByteUInt(N2kUInt16NA); // oil temperature
+  N2kMsg.Add2ByteUInt(coolantTemp);
+  N2kMsg.Add2ByteInt(voltage);
+  N2kMsg.Add2ByteInt(N2kInt16NA);   // fuel rate
+  N2kMsg.Add4ByteUInt(seconds);
+  N2kMsg.Add2ByteUInt(N2kUInt16NA); // coolant pressure
+  N2kMsg.Add2ByteUInt(N2kUInt16NA); // fuel pressure
+  N2kMsg.AddByte(0xff);             // reserved
+  N2kMsg.Add2ByteUInt(status1);
+  N2kMsg.Add2ByteUInt(status2);
+  N2kMsg.AddByte(N2kInt8NA);        // engine load
+  N2kMsg.AddByte(N2kInt8NA);        // engine torque
+}
+
+//*************************************************************
+// Encode the transmission parameters dynamic (PGN 127493)
+void SetN2kTransmissionScaled(tN2kMsg &N2kMsg, uint8_t instance, uint16_t oilTemp)
+{
+  N2kMsg.SetPGN(127493L);
+  N2kMsg.Priority = 2;
+  N2kMsg.AddByte(instance);
+  N2kMsg.AddByte((N2kTG_Unknown & 0x03) | 0xfc);
+  N2kMsg.Add2ByteUInt(N2kUInt16NA); // oil pressure
+  N2kMsg.Add2ByteUInt(oilTemp);
+  N2kMsg.AddByte(0);                // discrete status
+  N2kMsg.AddByte(0xff);             // reserved
+}
+
+//*************************************************************
+// Encode the temperature extended range (PGN 130316)
+void SetN2kTemperatureExtScaled(tN2kMsg &N2kMsg, uint8_t sid, uint8_t instance,
+                                tN2kTempSource source, uint32_t temperature)
+{
+  N2kMsg.SetPGN(130316L);
+  N2kMsg.Priority = 5;
+  N2kMsg.AddByte(sid);
+  N2kMsg.AddByte(instance);
+  N2kMsg.AddByte((uint8_t)source);
+  N2kMsg.Add3ByteInt((int32_t)temperature); // 3 bytes of the unsigned value
+  N2kMsg.Add2ByteUInt(N2kUInt16NA);           // set temperature
+}
+
+//*************************************************************
+// Encode the DC voltage (PGN 127751)
+void SetN2kDCVoltageScaled(tN2kMsg &N2kMsg, uint8_t sid, uint8_t connection, uint16_t voltage)
+{
+  N2kMsg.SetPGN(127751L);
+  N2kMsg.Priority = 6;
+  N2kMsg.AddByte(sid);
+  N2kMsg.AddByte(connection);
+  N2kMsg.Add2ByteUInt(voltage);
+  N2kMsg.Add3ByteInt(N2K_INT24_NA); // DC current
+  N2kMsg.AddByte(0xff);         // reserved
+}
+
+//*************************************************************
+// Encode the binary switch bank status (PGN 127501)
+void SetN2kSwitchBankScaled(tN2kMsg &N2kMsg, uint8_t instance, uint8_t states, uint8_t count)
+{
+  // 28 switches with 2 bits each, 3 = unavailable
+  uint64_t bankStatus = 0x00FFFFFFFFFFFFFFULL;
+
+  for (uint8_t i = 0; i < count && i < 8; i++)
+  {
+    bankStatus &= ~(0x03ULL << (2 * i));
+    bankStatus |= (uint64_t)((states >> i) & 0x01) << (2 * i);
+  }
+
+  N2kMsg.SetPGN(127501L);
+  N2kMsg.Priority = 3;
+  N2kMsg.AddByte(instance);
+  for (uint8_t i = 0; i < 7; i++)
+  {
+    N2kMsg.AddByte((uint8_t)(bankStatus >> (8 * i)));
+  }
+}
+
+//*************************************************************
+// Compare two encoded messages and print the result
+static bool compareN2kMsg(const char *name, const tN2kMsg &scaled, const tN2kMsg &library)
+{
+  char buffer[60];
+  bool equal = (scaled.PGN == library.PGN) &&
+               (scaled.Priority == library.Priority) &&
+               (scaled.DataLen == library.DataLen) &&
+               (memcmp(scaled.Data, library.Data, scaled.DataLen) == 0);
+
+  snprintf(buffer, sizeof(buffer), "  %-28s %s", name, equal ? "ok" : "DIFFERENT");
+  Serial.println(buffer);
+  if (!equal)
+  {
+    for (int i = 0; i < scaled.DataLen || i < library.DataLen; i++)
+    {
+      snprintf(buffer, sizeof(buffer), "    %2d  %02X  %02X", i,
+               (i < scaled.DataLen) ? scaled.Data[i] : 0,
+               (i < library.DataLen) ? library.Data[i] : 0);
+      Serial.println(buffer);
+    }
+  }
+  return equal;
+}
+
+/// test values for the comparison of the encoders (physical units)
+typedef struct tN2kCheckValues
+{
+  double speed;       ///< speed in rpm
+  double pressure;    ///< oil pressure in Pa
+  double coolantTemp; ///< coolant temperature in K
+  double oilTemp;     ///< gearbox temperature in K
+  double extTemp;     ///< temperature extended range in K
+  double voltage;     ///< battery voltage in V
+  double seconds;     ///< engine hours in s
+  uint16_t status1;   ///< discrete status 1
+  uint16_t status2;   ///< discrete status 2
+  uint8_t contacts;   ///< state of the contacts
+} tN2kCheckValues;
+
+static const tN2kCheckValues n2kCheckValues[] = {
+    {0, 0, 273.15, 273.15, 273.15, 0, 0, 0x0000, 0x0000, 0x00},
+    {850.3, 345000, 358.52, 331.87, 311.123, 12.61, 3600, 0x0020, 0x0000, 0x01},
+    {2400.13, 412345, 366.155, 348.04, 654.3215, 14.249, 4444444, 0x0004, 0x0040, 0x06},
+    {3999.87, 9999, 393.149, 372.96, 800.0004, 28.004, 86399.5, 0xFFFF, 0xFFFF, 0x07},
+    // not available
+    {N2kDoubleNA, N2kDoubleNA, N2kDoubleNA, N2kDoubleNA, N2kDoubleNA, N2kDoubleNA, N2kDoubleNA, 0x0000, 0x0000, 0x00},
+    // out of range below and above
+    {-1.0, -100.0, -0.5, -10.0, -9000.0, -400.0, -1.0, 0x0000, 0x0000, 0x00},
+    {20000.0, 7000000.0, 700.0, 7000.0, 9000.0, 400.0, 5e9, 0x0000, 0x0000, 0x00},
+};
+
+//*************************************************************
+// Compare the scaled encoders with the encoders of the library
+bool CheckN2kScaledEncoders()
+{
+  tN2kMsg scaled;
+  tN2kMsg library;
+  bool result = true;
+
+  for (uint8_t i = 0; i < sizeof(n2kCheckValues) / sizeof(n2kCheckValues[0]); i++)
+  {
+    const tN2kCheckValues &v = n2kCheckValues[i];
+    tN2kEngineDiscreteStatus1 status1 = v.status1;
+    tN2kEngineDiscreteStatus2 status2 = v.status2;
+
+    Serial.printf("Values %u\n", i);
+
+    scaled.Clear();
+    library.Clear();
+    SetN2kEngineRapidScaled(scaled, N2K_ENGINE_INSTANCE, N2kScaleUInt16(v.speed, N2K_RES_SPEED));
+    SetN2kEngineParamRapid(library, N2K_ENGINE_INSTANCE, v.speed, 0, 0);
+    result &= compareN2kMsg("127488 engine rapid", scaled, library);
+
+    scaled.Clear();
+    library.Clear();
+    SetN2kEngineDynamicScaled(scaled, N2K_ENGINE_INSTANCE,
+                              N2kScaleUInt16(v.pressure, N2K_RES_PRESSURE),
+                              N2kScaleUInt16(v.coolantTemp, N2K_RES_COOLANT_TEMP),
+                              N2kScaleInt16(v.voltage, N2K_RES_VOLTAGE),
+                              N2kScaleUInt32(v.seconds, N2K_RES_SECONDS),
+                              v.status1, v.status2);
+    SetN2kEngineDynamicParam(library, N2K_ENGINE_INSTANCE, v.pressure, N2kDoubleNA, v.coolantTemp,
+                             v.voltage, N2kDoubleNA, v.seconds, N2kDoubleNA, N2kDoubleNA,
+                             N2kInt8NA, N2kInt8NA, status1, status2);
+    result &= compareN2kMsg("127489 engine dynamic", scaled, library);
+
+    scaled.Clear();
+    library.Clear();
+    SetN2kEngineDynamicScaled(scaled, N2K_ALTERNATOR1_INSTANCE, N2kUInt16NA,
+                              N2kScaleUInt16(v.coolantTemp, N2K_RES_COOLANT_TEMP),
+                              N2kInt16NA, N2kUInt32NA, v.status1, 0);
+    SetN2kEngineDynamicParam(library, N2K_ALTERNATOR1_INSTANCE, N2kDoubleNA, N2kDoubleNA,
+                             v.coolantTemp, N2kDoubleNA, N2kDoubleNA, N2kDoubleNA, N2kDoubleNA,
+                             N2kDoubleNA, N2kInt8NA, N2kInt8NA, status1, 0);
+    result &= compareN2kMsg("127489 alternator dynamic", scaled, library);
+
+    scaled.Clear();
+    library.Clear();
+    SetN2kTransmissionScaled(scaled, N2K_ENGINE_INSTANCE, N2kScaleUInt16(v.oilTemp, N2K_RES_OIL_TEMP));
+    SetN2kPGN127493(library, N2K_ENGINE_INSTANCE, N2kTG_Unknown, N2kDoubleNA, v.oilTemp, 0);
+    result &= compareN2kMsg("127493 transmission", scaled, library);
+
+    scaled.Clear();
+    library.Clear();
+    SetN2kTemperatureExtScaled(scaled, 0, 0, N2kts_ExhaustGasTemperature,
+                               N2kScaleUInt24(v.extTemp, N2K_RES_TEMP_EXT));
+    SetN2kTemperatureExt(library, 0, 0, N2kts_ExhaustGasTemperature, v.extTemp);
+    result &= compareN2kMsg("130316 temperature", scaled, library);
+
+    scaled.Clear();
+    library.Clear();
+    SetN2kDCVoltageScaled(scaled, 0, N2K_DC_BATTERY_INSTANCE, N2kScaleUInt16(v.voltage, N2K_RES_DC_VOLTAGE));
+    SetN2kDCVoltageCurrent(library, 0, N2K_DC_BATTERY_INSTANCE, v.voltage, N2kDoubleNA);
+    result &= compareN2kMsg("127751 DC voltage", scaled, library);
+
+    tN2kBinaryStatus bankStatus;
+    N2kResetBinaryStatus(bankStatus);
+    for (uint8_t c = 0; c < N2K_SWITCH_BANK_SIZE; c++)
+    {
+      N2kSetStatusBinaryOnStatus(bankStatus, ((v.contacts >> c) & 0x01) ? N2kOnOff_On : N2kOnOff_Off, c + 1);
     }
+    scaled.Clear();
+    library.Clear();
+    SetN2kSwitchBankScaled(scaled, N2K_SWITCH_BANK_INSTANCE, v.contacts, N2K_SWITCH_BANK_SIZE);
+    SetN2kBinaryStatus(library, N2K_SWITCH_BANK_INSTANCE, bankStatus);
+    result &= compareN2kMsg("127501 switch bank", scaled, library);
+  }
+
+  Serial.println(result ? "Scaled encoders ok" : "Scaled encoders DIFFERENT");
+  return result;
+}
+
+//*************************************************************
+// Read a scaled value of tVolvoPentaData
+bool ReadN2kField(const tVolvoPentaData &data, uint16_t offset, tN2kFieldType type, int32_t &value)
+{
+  const uint8_t *field = (const uint8_t *)&data + offset;
+
+  switch (type)
+  {
+  case n2kField_UInt8:
+    value = *field;
+    return true;
+  case n2kField_UInt16:
+    value = *(const uint16_t *)field;
+    return value < N2K_UINT16_OR;
+  case n2kField_Int16:
+    value = *(const int16_t *)field;
+    return value < N2K_INT16_OR;
+  case n2kField_UInt32:
+    value = (int32_t) * (const uint32_t *)field;
+    return (uint32_t)value < N2K_UINT32_OR;
+  case n2kField_UInt24:
+  default:
+    value = (int32_t) * (const uint32_t *)field;
+    return (uint32_t)value < N2K_UINT24_OR;
+  }
+}
+
+//*************************************************************
+// Get the type of the value of a channel from its PGN
+static tN2kFieldType n2kChannelField(const tN2kChannel &channel)
+{
+  switch (channel.pgn)
+  {
+  case 127501L:
+    return n2kField_UInt8;
+  case 130316L:
+    return n2kField_UInt24;
+  case 127488L:
+  case 127751L:
+  default:
+    return n2kField_UInt16;
+  }
+}
+
+//*************************************************************
+// Encode the message of a channel
+static void encodeN2kChannel(tN2kMsg &N2kMsg, const tN2kChannel &channel, int32_t value)
+{
+  switch (channel.pgn)
+  {
+  case 127488L:
+    SetN2kEngineRapidScaled(N2kMsg, channel.instance, (uint16_t)value);
+    break;
+  case 127501L:
+    SetN2kSwitchBankScaled(N2kMsg, channel.instance, (uint8_t)value, channel.param);
+    break;
+  case 127751L:
+    SetN2kDCVoltageScaled(N2kMsg, 0, channel.instance, (uint16_t)value);
+    break;
+  case 130316L:
+    SetN2kTemperatureExtScaled(N2kMsg, 0, channel.instance, (tN2kTempSource)channel.param, (uint32_t)value);
+    break;
+  default:
+    break;
   }
-}
\ No newline at end of file
+}
+
+//*************************************************************
+// Sends all channels of a PGN of the table n2kChannels
+void SendN2kChannels(unsigned long pgn, const tVolvoPentaData &n2kVolvoData)
+{
+  for (uint8_t i = 0; i < N2K_CHANNEL_COUNT; i++)
+  {
+    const tN2kChannel &channel = n2kChannels[i];
+    if (channel.pgn != pgn)
+    {
+      continue;
+    }
+
+    N2kMsgCache &cache = n2kChannelCache[i];
+    int32_t value;
+
+    // not available and out of range are sent with their codes
+    ReadN2kField(n2kVolvoData, channel.offset, n2kChannelField(channel), value);
+
+    if (!cache.isUpToDate(&value, 1))
+    {
+      encodeN2kChannel(cache.getMsg(), channel, value);
+    }
+    cache.send();
+  }
+}
+
+//*************************************************************
+// Sends the engine parameters dynamic (PGN 127489)
+void SendN2kEngineDynamic(const tVolvoPentaData &n2kVolvoData)
+{
+  N2kMsgCache &engine = n2kMsgCache[n2kCache_engineDynamic];
+  const int32_t engineValues[] = {n2kVolvoData.engine_oel_pressure,
+                                  n2kVolvoData.engine_coolant_temperature,
+                                  n2kVolvoData.battery_voltage,
+                                  (int32_t)n2kVolvoData.engine_seconds,
+                                  n2kVolvoData.engineDiscreteStatus1.Status,
+                                  n2kVolvoData.engineDiscreteStatus2.Status};
+
+  // send engine dynamic data
+  if (!engine.isUpToDate(engineValues, 6))
+  {
+    SetN2kEngineDynamicScaled(engine.getMsg(), N2K_ENGINE_INSTANCE,
+                              n2kVolvoData.engine_oel_pressure,
+                              n2kVolvoData.engine_coolant_temperature,
+                              n2kVolvoData.battery_voltage,
+                              n2kVolvoData.engine_seconds,
+                              n2kVolvoData.engineDiscreteStatus1.Status,
+                              n2kVolvoData.engineDiscreteStatus2.Status);
+  }
+  engine.send();
+
+  N2kMsgCache &alternator = n2kMsgCache[n2kCache_alternator1Dynamic];
+  const int32_t alternatorValues[] = {n2kVolvoData.alternator1_temperature,
+                                      n2kVolvoData.alternatorDiscreteStatus1.Status};
+
+  // send Balmar Alternator Data (dynamic) as "Instance 1"
+  if (!alternator.isUpToDate(alternatorValues, 2))
+  {
+    SetN2kEngineDynamicScaled(alternator.getMsg(), N2K_ALTERNATOR1_INSTANCE,
+                              N2kUInt16NA,
+                              n2kVolvoData.alternator1_temperature,
+                              N2kInt16NA,
+                              N2kUInt32NA,
+                              n2kVolvoData.alternatorDiscreteStatus1.Status,
+                              0);
+  }
+  alternator.send();
+}
+
+//*************************************************************
+// Sends the transmission parameters dynamic (PGN 127493)
+void SendN2kTransmission(const tVolvoPentaData &n2kVolvoData)
+{
+  N2kMsgCache &gearbox = n2kMsgCache[n2kCache_transmission];
+  const int32_t values[] = {n2kVolvoData.gearbox_temperature};
+
+  // send gearbox data
+  if (!gearbox.isUpToDate(values, 1))
+  {
+    SetN2kTransmissionScaled(gearbox.getMsg(), N2K_ENGINE_INSTANCE, n2kVolvoData.gearbox_temperature);
+  }
+  gearbox.send();
+}
@@ -0,0 +1,238 @@
+// Doxygen Documentation
+/*! \file 	signalk_delta.cpp
+ *  \brief  Signal K deltas of the measured engine data
+ *
+ * This File contains all the necessary methods to serialise the measured
+ * engine data into Signal K delta messages (JSON) in a fixed buffer
+ * without any heap allocation. Only the changed paths are sent to the
+ * serial terminal and, when enabled, as UDP broadcast.
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         ESP32-WROOM
+ * - Hardware:          az-delivery-devkit-v4
+ */
+
+#include <signalk_delta.h>
+
+/// Powers of ten for the fixed point values
+static const int32_t powersOfTen[] = {1, 10, 100, 1000, 10000};
+
+//*************************************************************
+// Mapping of the acquired values to the Signal K paths
+//
+// To send a new value add a row with its Signal K path, the resolution
+// converts the scaled integer of tVolvoPentaData into the SI unit.
+const tSignalKPath signalKPaths[SIGNALK_PATH_COUNT] = {
+    // path                                          offset in tVolvoPentaData                               type            resolution             decimals
+    {"propulsion.port.revolutions", offsetof(tVolvoPentaData, engine_speed), n2kField_UInt16, N2K_RES_SPEED / 60, 2},
+    {"propulsion.port.temperature", offsetof(tVolvoPentaData, engine_coolant_temperature), n2kField_UInt16, N2K_RES_COOLANT_TEMP, 1},
+    {"propulsion.port.oilPressure", offsetof(tVolvoPentaData, engine_oel_pressure), n2kField_UInt16, N2K_RES_PRESSURE, 0},
+    {"propulsion.port.exhaustTemperature", offsetof(tVolvoPentaData, exhaust_temperature), n2kField_UInt24, N2K_RES_TEMP_EXT, 0},
+    {"propulsion.port.runTime", offsetof(tVolvoPentaData, engine_seconds), n2kField_UInt32, N2K_RES_SECONDS, 0},
+    {"propulsion.port.transmission.oilTemperature", offsetof(tVolvoPentaData, gearbox_temperature), n2kField_UInt16, N2K_RES_OIL_TEMP, 1},
+    {"electrical.alternators.1.revolutions", offsetof(tVolvoPentaData, alternator1_speed), n2kField_UInt16, N2K_RES_SPEED / 60, 1},
+    {"electrical.alternators.1.temperature", offsetof(tVolvoPentaData, alternator1_temperature), n2kField_UInt16, N2K_RES_COOLANT_TEMP, 1},
+    {"electrical.alternators.2.revolutions", offsetof(tVolvoPentaData, alternator2_speed), n2kField_UInt16, N2K_RES_SPEED / 60, 1},
+    {"electrical.batteries.0.voltage", offsetof(tVolvoPentaData, battery_voltage), n2kField_Int16, N2K_RES_VOLTAGE, 2},
+};
+
+//****************************************
+// Start a new delta message
+void SignalKWriter::begin()
+{
+  this->len = 0;
+  this->valueCount = 0;
+  this->overflow = false;
+  append("{\"updates\":[{\"source\":{\"label\":\"" SIGNALK_SOURCE_LABEL "\"},\"values\":[");
+}
+
+//****************************************
+// Add one value to the delta message
+void SignalKWriter::addValue(const char *path, int32_t value, uint8_t decimals)
+{
+  if (this->valueCount > 0)
+  {
+    append(",");
+  }
+  append("{\"path\":\"");
+  append(path);
+  append("\",\"value\":");
+  appendFixed(value, decimals);
+  append("}");
+  this->valueCount++;
+}
+
+//****************************************
+// Add a value which is not available to the delta message
+void SignalKWriter::addNull(const char *path)
+{
+  if (this->valueCount > 0)
+  {
+    append(",");
+  }
+  append("{\"path\":\"");
+  append(path);
+  append("\",\"value\":null}");
+  this->valueCount++;
+}
+
+//****************************************
+// Finish the delta message with a line end
+size_t SignalKWriter::end()
+{
+  append("]}]}\n");
+  return this->overflow ? 0 : this->len;
+}
+
+//****************************************
+// Append a string to the message
+void SignalKWriter::append(const char *text)
+{
+  while (*text != '\0')
+  {
+    // keep one byte for the terminating zero
+    if (this->len + 1 >= this->size)
+    {
+      this->overflow = true;
+      return;
+    }
+    this->buffer[this->len++] = *text++;
+  }
+  this->buffer[this->len] = '\0';
+}
+
+//****************************************
+// Append a fixed point number to the message
+void SignalKWriter::appendFixed(int32_t value, uint8_t decimals)
+{
+  char text[FIXED_FORMAT_BUFFER_SIZE];
+
+  formatFixed(text, 0, value, decimals);
+  append(text);
+}
+
+//****************************************
+// Constructor
+SignalKDelta::SignalKDelta(N2kDataExchange &exchange) : exchange(exchange)
+{
+}
+
+//****************************************
+// Start or stop the delta messages
+void SignalKDelta::setEnabled(bool enabled)
+{
+  // a new receiver gets all paths with the first message
+  this->fullRequested = true;
+  this->enabled = enabled;
+}
+
+//****************************************
+// Set the period of the delta messages
+void SignalKDelta::setPeriod(uint32_t periodMs)
+{
+  this->periodMs = (periodMs < SIGNALK_MIN_PERIOD_MS) ? SIGNALK_MIN_PERIOD_MS : periodMs;
+}
+
+//****************************************
+// Send a delta message if the period has elapsed
+void SignalKDelta::process()
+{
+  tVolvoPentaData snapshot;
+  uint32_t now = millis();
+
+  if (!this->enabled || (now - this->lastMs) < this->periodMs)
+  {
+    return;
+  }
+  this->lastMs = now;
+
+  // nothing has been measured yet
+  if (!this->exchange.getSnapshot(snapshot))
+  {
+    return;
+  }
+
+  bool full = this->fullRequested || (now - this->lastFullMs) >= SIGNALK_FULL_PERIOD_MS;
+  if (full)
+  {
+    this->lastFullMs = now;
+    this->fullRequested = false;
+  }
+
+  SignalKWriter writer(this->buffer, sizeof(this->buffer));
+  writer.begin();
+  for (uint8_t i = 0; i < SIGNALK_PATH_COUNT; i++)
+  {
+    int32_t value = readValue(signalKPaths[i], snapshot);
+    if (!full && value == this->lastValue[i])
+    {
+      continue;
+    }
+    this->lastValue[i] = value;
+    if (value == SIGNALK_VALUE_NULL)
+    {
+      writer.addNull(signalKPaths[i].path);
+    }
+    else
+    {
+      writer.addValue(signalKPaths[i].path, value, signalKPaths[i].decimals);
+    }
+  }
+
+  // nothing has changed
+  if (writer.getValueCount() == 0)
+  {
+    return;
+  }
+
+  size_t len = writer.end();
+  if (len == 0)
+  {
+    this->overflowCount++;
+    this->fullRequested = true;
+    return;
+  }
+
+  Serial.write((const uint8_t *)this->buffer, len);
+#ifdef SIGNALK_UDP_PORT
+  if (WiFi.status() == WL_CONNECTED)
+  {
+    this->udp.beginPacket(IPAddress(255, 255, 255, 255), SIGNALK_UDP_PORT);
+    this->udp.write((const uint8_t *)this->buffer, len);
+    this->udp.endPacket();
+  }
+#endif // SIGNALK_UDP_PORT
+
+  this->messageCount++;
+  this->valueCount += writer.getValueCount();
+  this->byteCount += len;
+}
+
+//****************************************
+// Print the counters of the delta messages to the terminal
+void SignalKDelta::printLog() const
+{
+  char buffer[96];
+
+  snprintf(buffer, sizeof(buffer), "Signal K %s  period %lu ms  messages %lu  values %lu  bytes %lu  overflow %lu",
+           this->enabled ? "on" : "off", (unsigned long)this->periodMs,
+           (unsigned long)this->messageCount, (unsigned long)this->valueCount,
+           (unsigned long)this->byteCount, (unsigned long)this->overflowCount);
+  Serial.println(buffer);
+}
+
+//****************************************
+// Read a value of the snapshot as fixed point integer
+int32_t SignalKDelta::readValue(const tSignalKPath &path, const tVolvoPentaData &snapshot)
+{
+  int32_t value;
+
+  if (!ReadN2kField(snapshot, path.offset, path.type, value))
+  {
+    return SIGNALK_VALUE_NULL;
+  }
+  double raw = (path.type == n2kField_UInt32) ? (double)(uint32_t)value : (double)value;
+  return (int32_t)lround(raw * path.resolution * powersOfTen[path.decimals]);
+}
@@ -0,0 +1,234 @@
+// Doxygen Documentation
+/*! \file 	terminal_command.cpp
+ *  \brief  Interpretation of commands from the serial terminal
+ *
+ * This File contains all the necessary methods to read commands from
+ * the serial terminal (USB) and to dispatch them to the modules.
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         ESP32-WROOM
+ * - Hardware:          az-delivery-devkit-v4
+ */
+
+#include <terminal_command.h>
+
+//****************************************
+// Constructor
+TerminalCommand::TerminalCommand(CalibrationStore &calibration, N2kScheduler &n2kScheduler,
+                                 N2kCanDriver &n2kCanDriver, N2kBusMonitor &n2kBusMonitor,
+                                 N2kRateController &n2kRateController, N2kReceiver &n2kReceiver,
+                                 N2kGateway &n2kGateway, N2kAlertManager &n2kAlertManager,
+                                 SignalKDelta &signalKDelta, DisplayData &displayData)
+    : calibration(calibration), n2kScheduler(n2kScheduler), n2kCanDriver(n2kCanDriver),
+      n2kBusMonitor(n2kBusMonitor), n2kRateController(n2kRateController), n2kReceiver(n2kReceiver),
+      n2kGateway(n2kGateway), n2kAlertManager(n2kAlertManager), signalKDelta(signalKDelta),
+      displayData(displayData)
+{
+  lineBuffer[0] = '\0';
+}
+
+//****************************************
+// Process all characters available at the serial terminal
+bool TerminalCommand::processSerialInput()
+{
+  int c;
+
+  while (Serial.available() > 0)
+  {
+    c = Serial.read();
+
+    if ((c == '\n') || (c == '\r'))
+    {
+      // ignore empty lines (eg. "\r\n")
+      if (lineLength == 0 && !lineOverflow)
+      {
+        continue;
+      }
+
+      lineBuffer[lineLength] = '\0';
+      bool execute = !lineOverflow;
+      lineLength = 0;
+      lineOverflow = false;
+
+      if (execute)
+      {
+        executeCommand(lineBuffer);
+        return true;
+      }
+      if (!n2kGateway.isEnabled())
+      {
+        Serial.println("Command line too long");
+      }
+    }
+    else if (lineLength < TERMINAL_CMD_MAX_LEN)
+    {
+      lineBuffer[lineLength++] = (char)c;
+    }
+    else
+    {
+      lineOverflow = true;
+    }
+  }
+  return false;
+}
+
+//****************************************
+// Execute a complete command line
+void TerminalCommand::executeCommand(char *line)
+{
+  char *savePtr = NULL;
+  char *cmd = strtok_r(line, " ", &savePtr);
+
+  if (cmd == NULL)
+  {
+    return;
+  }
+
+  // the stream carries only RAW lines, the other commands wait for "gw off"
+  if (n2kGateway.isEnabled() && strcmp(cmd, "gw") != 0)
+  {
+    return;
+  }
+
+  if (strcmp(cmd, "cal") == 0)
+  {
+    // calibration data
+    calibration.processCommand(savePtr);
+  }
+  else if (strcmp(cmd, "n2k") == 0)
+  {
+    char *arg = strtok_r(NULL, " ", &savePtr);
+    if (arg != NULL && strcmp(arg, "check") == 0)
+    {
+      // compare the scaled encoders with the library
+      CheckN2kScaledEncoders();
+      return;
+    }
+    if (arg != NULL && strcmp(arg, "rx") == 0)
+    {
+      // data received from other devices
+      n2kReceiver.printLog();
+      return;
+    }
+
+    // transmit timing of all PGNs and receive statistic
+    n2kScheduler.printTimingLog();
+    n2kCanDriver.printRxLog();
+    n2kCanDriver.printTxLog();
+  }
+  else if (strcmp(cmd, "stats") == 0)
+  {
+    char *arg = strtok_r(NULL, " ", &savePtr);
+    if (arg != NULL && strcmp(arg, "monitor") == 0)
+    {
+      // open the filter of the CAN controller to count all frames
+      char *state = strtok_r(NULL, " ", &savePtr);
+      if (state != NULL && strcmp(state, "on") == 0)
+      {
+        n2kCanDriver.setMonitorMode(true);
+      }
+      else if (state != NULL && strcmp(state, "off") == 0)
+      {
+        n2kCanDriver.setMonitorMode(false);
+      }
+      Serial.println(n2kCanDriver.isMonitorMode() ? "Monitor mode on" : "Monitor mode off");
+      return;
+    }
+
+    // load and errors of the NMEA2000 bus
+    n2kBusMonitor.printStatistic();
+  }
+  else if (strcmp(cmd, "rate") == 0)
+  {
+    // log of the adaptive transmit rate
+    n2kRateController.printLog();
+  }
+  else if (strcmp(cmd, "gw") == 0)
+  {
+    // stream of all N2K frames in the RAW format
+    char *arg = strtok_r(NULL, " ", &savePtr);
+    if (arg != NULL && strcmp(arg, "on") == 0)
+    {
+      // only one stream at the terminal
+      signalKDelta.setEnabled(false);
+      n2kGateway.setEnabled(true);
+    }
+    else if (arg != NULL && strcmp(arg, "off") == 0)
+    {
+      n2kGateway.setEnabled(false);
+      n2kGateway.printLog();
+    }
+    else if (!n2kGateway.isEnabled())
+    {
+      n2kGateway.printLog();
+    }
+  }
+  else if (strcmp(cmd, "sk") == 0)
+  {
+    // Signal K deltas of the measured data
+    char *arg = strtok_r(NULL, " ", &savePtr);
+    if (arg != NULL && strcmp(arg, "on") == 0)
+    {
+      // only one stream at the terminal
+      n2kGateway.setEnabled(false);
+      signalKDelta.setEnabled(true);
+    }
+    else if (arg != NULL && strcmp(arg, "off") == 0)
+    {
+      signalKDelta.setEnabled(false);
+      signalKDelta.printLog();
+    }
+    else if (arg != NULL && strcmp(arg, "rate") == 0)
+    {
+      char *period = strtok_r(NULL, " ", &savePtr);
+      if (period != NULL)
+      {
+        signalKDelta.setPeriod(strtoul(period, NULL, 10));
+      }
+      signalKDelta.printLog();
+    }
+    else
+    {
+      signalKDelta.printLog();
+    }
+  }
+  else if (strcmp(cmd, "lcd") == 0)
+  {
+    char *arg = strtok_r(NULL, " ", &savePtr);
+
+#ifdef FIXED_FORMAT_BENCHMARK
+    if (arg != NULL && strcmp(arg, "bench") == 0)
+    {
+      // formatting time of the numbers
+      printFixedFormatBenchmark();
+    }
+    else
+#endif // FIXED_FORMAT_BENCHMARK
+    if (arg != NULL && strcmp(arg, "check") == 0)
+    {
+      // the LCD task renders all pages with its next cycle
+      displayData.requestSelfCheck();
+      for (uint8_t i = 0; i < TERMINAL_LCD_CHECK_TIMEOUT_MS / 10 && !displayData.isSelfCheckDone(); i++)
+      {
+        vTaskDelay(pdMS_TO_TICKS(10));
+      }
+      displayData.printSelfCheck();
+    }
+    else
+    {
+      // I2C traffic of the LCD Panel
+      displayData.printLcdStatistic();
+    }
+  }
+  else if (strcmp(cmd, "alert") == 0)
+  {
+    // state of the N2K alerts
+    n2kAlertManager.printLog();
+  }
+  else
+  {
+    Serial.println("Commands: cal | n2k [check|rx] | stats [monitor on|off] | rate | gw [on|off] | sk [on|off|rate <ms>] | alert | lcd [" TERMINAL_LCD_ARGS "]");
+  }
+}
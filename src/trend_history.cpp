@@ -0,0 +1,78 @@
+// Doxygen Documentation
+/*! \file 	trend_history.cpp
+ *  \brief  Downsampled history of a measured value
+ *
+ * This File contains all the necessary methods to keep the trend of a
+ * measured value for the last minutes. The samples are averaged into
+ * buckets incrementally, the history holds the bucket means only.
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         ESP32-WROOM
+ * - Hardware:          az-delivery-devkit-v4
+ */
+
+#include <trend_history.h>
+
+//****************************************
+// Add a sample to the open bucket
+void TrendHistory::addSample(float value, uint32_t nowMs)
+{
+  if (this->samples == 0)
+  {
+    this->startMs = nowMs;
+  }
+  this->sum += value;
+  this->samples++;
+
+  // close the bucket
+  if ((nowMs - this->startMs) >= TREND_BUCKET_MS)
+  {
+    this->bucket[this->head] = this->sum / this->samples;
+    this->head = (this->head + 1) % TREND_BUCKET_COUNT;
+    if (this->count < TREND_BUCKET_COUNT)
+    {
+      this->count++;
+    }
+    this->sum = 0;
+    this->samples = 0;
+    this->version++;
+  }
+}
+
+//****************************************
+// Get the mean of a closed bucket
+float TrendHistory::getBucket(uint8_t age) const
+{
+  if (age >= this->count)
+  {
+    return 0;
+  }
+  return this->bucket[(this->head + TREND_BUCKET_COUNT - 1 - age) % TREND_BUCKET_COUNT];
+}
+
+//****************************************
+// Get the min and max of all closed buckets
+bool TrendHistory::getRange(float &min, float &max) const
+{
+  if (this->count == 0)
+  {
+    return false;
+  }
+  min = getBucket(0);
+  max = min;
+  for (uint8_t age = 1; age < this->count; age++)
+  {
+    float value = getBucket(age);
+    if (value < min)
+    {
+      min = value;
+    }
+    if (value > max)
+    {
+      max = value;
+    }
+  }
+  return true;
+}
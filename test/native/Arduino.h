@@ -0,0 +1,212 @@
+// Doxygen Documentation
+/*! \file 	Arduino.h
+ *  \brief  Host stand-in of the Arduino core and FreeRTOS for the native tests
+ *
+ * This File contains the part of the Arduino core of the ESP32 and of
+ * FreeRTOS which the modules under test use. The time is set by the
+ * tests, the tasks, semaphores and interrupts do nothing and Serial
+ * writes to stdout. Only the environment native of platformio.ini uses
+ * this directory.
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         host (native)
+ * - Hardware:          none
+ */
+
+#ifndef NATIVE_ARDUINO_H
+#define NATIVE_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <string>
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define IRAM_ATTR
+#define PROGMEM
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+#define RISING 0x01
+#define FALLING 0x02
+#define CHANGE 0x03
+
+#define DEC 10
+#define HEX 16
+
+//****************************************
+// Time (set by the tests, see nativeSetMillis)
+
+/// the NMEA2000 library declares the time functions with C linkage
+extern "C"
+{
+  uint32_t millis();
+  uint32_t micros();
+  void delay(uint32_t ms);
+}
+void delayMicroseconds(uint32_t us);
+
+/*! ************************************************************************
+ * \brief Set the time of millis() and micros()
+ * \param ms   time in milliseconds
+ */
+void nativeSetMillis(uint32_t ms);
+
+/*! ************************************************************************
+ * \brief Advance the time of millis() and micros()
+ * \param us   time in microseconds
+ */
+void nativeAdvanceMicros(uint32_t us);
+
+//****************************************
+// GPIO, ADC and timers (no hardware)
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+uint16_t analogRead(uint8_t pin);
+int digitalPinToInterrupt(int pin);
+void attachInterrupt(int interrupt, void (*handler)(), int mode);
+
+typedef struct hw_timer_s hw_timer_t;
+hw_timer_t *timerBegin(uint8_t num, uint16_t divider, bool countUp);
+void timerStart(hw_timer_t *timer);
+uint64_t timerRead(hw_timer_t *timer);
+
+//****************************************
+// FreeRTOS (one thread, everything succeeds at once)
+typedef int portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED 0
+#define portENTER_CRITICAL(mux) (void)(mux)
+#define portEXIT_CRITICAL(mux) (void)(mux)
+#define portENTER_CRITICAL_ISR(mux) (void)(mux)
+#define portEXIT_CRITICAL_ISR(mux) (void)(mux)
+#define taskENTER_CRITICAL(mux) (void)(mux)
+#define taskEXIT_CRITICAL(mux) (void)(mux)
+#define taskENTER_CRITICAL_ISR(mux) (void)(mux)
+#define taskEXIT_CRITICAL_ISR(mux) (void)(mux)
+#define portYIELD_FROM_ISR(...) ((void)0)
+
+typedef void *SemaphoreHandle_t;
+typedef void *QueueHandle_t;
+typedef void *TaskHandle_t;
+typedef uint32_t TickType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS 1
+#define portMAX_DELAY 0xFFFFFFFFUL
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+
+SemaphoreHandle_t xSemaphoreCreateMutex();
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t timeout);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore);
+void vTaskDelay(TickType_t ticks);
+TickType_t xTaskGetTickCount();
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task);
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t timeout);
+BaseType_t xQueuePeek(QueueHandle_t queue, void *item, TickType_t timeout);
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue);
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t queue);
+
+//****************************************
+// Print, String and Serial
+
+/*! ************************************************************************
+ * \class String
+ * \brief Arduino String on top of std::string
+ */
+class String : public std::string
+{
+public:
+  String(const char *text = "") : std::string(text) {}
+  String(const std::string &text) : std::string(text) {}
+  String(int value) : std::string(std::to_string(value)) {}
+  String(unsigned int value) : std::string(std::to_string(value)) {}
+  String(long value) : std::string(std::to_string(value)) {}
+  String(unsigned long value) : std::string(std::to_string(value)) {}
+  String(double value, unsigned int decimals = 2);
+};
+
+/*! ************************************************************************
+ * \class Print
+ * \brief Formatted output of the Arduino core
+ */
+class Print
+{
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t *buf, size_t len);
+  size_t write(const char *buf, size_t len) { return write((const uint8_t *)buf, len); }
+
+  size_t print(const char *text);
+  size_t print(const String &text) { return print(text.c_str()); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(int value, int base = DEC) { return print((long)value, base); }
+  size_t print(unsigned int value, int base = DEC) { return print((unsigned long)value, base); }
+  size_t print(long value, int base = DEC);
+  size_t print(unsigned long value, int base = DEC);
+  size_t print(double value, int decimals = 2);
+
+  size_t println() { return print("\r\n"); }
+  template <typename T>
+  size_t println(T value) { return print(value) + println(); }
+  template <typename T>
+  size_t println(T value, int format) { return print(value, format) + println(); }
+
+  size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+};
+
+/// Stream of the Arduino core
+class Stream : public Print
+{
+public:
+  virtual int available() { return 0; }
+  virtual int read() { return -1; }
+  virtual int peek() { return -1; }
+};
+
+/*! ************************************************************************
+ * \class HardwareSerial
+ * \brief UART which writes to stdout and never receives
+ */
+class HardwareSerial : public Stream
+{
+public:
+  /*! ************************************************************************
+   * \brief Append the output to a string instead of stdout
+   * \param capture   string for the output, NULL for stdout
+   */
+  void nativeCapture(std::string *capture) { this->capture = capture; }
+
+  void begin(unsigned long baud) { (void)baud; }
+  using Print::write;
+  size_t write(uint8_t c) override;
+  size_t write(const uint8_t *buf, size_t len) override;
+  int availableForWrite() { return 4096; }
+  void flush() { fflush(stdout); }
+  operator bool() const { return true; }
+
+private:
+  /// output of the tests, NULL for stdout
+  std::string *capture = NULL;
+};
+
+/// UART of the terminal
+extern HardwareSerial Serial;
+
+#endif // NATIVE_ARDUINO_H
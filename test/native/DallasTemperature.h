@@ -0,0 +1,64 @@
+// Doxygen Documentation
+/*! \file 	DallasTemperature.h
+ *  \brief  Host stand-in of the DS18B20 library for the native tests
+ *
+ * The sensors on the bus are set by the tests with \ref nativeSetDevices.
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         host (native)
+ * - Hardware:          none
+ */
+
+#ifndef NATIVE_DALLAS_TEMPERATURE_H
+#define NATIVE_DALLAS_TEMPERATURE_H
+
+#include <OneWire.h>
+
+/// Max number of sensors of the stand-in
+#define NATIVE_ONEWIRE_MAX_DEVICES 4
+
+/// ROM code of a sensor
+typedef uint8_t DeviceAddress[8];
+
+/// DS18B20 sensors with fixed addresses and temperatures
+class DallasTemperature
+{
+public:
+  DallasTemperature(OneWire *wire) { (void)wire; }
+  void begin() {}
+  uint8_t getDeviceCount() { return deviceCount; }
+  uint8_t getDS18Count() { return deviceCount; }
+  bool getAddress(uint8_t *address, uint8_t index)
+  {
+    if (index >= deviceCount)
+    {
+      return false;
+    }
+    memcpy(address, addresses[index], sizeof(DeviceAddress));
+    return true;
+  }
+  bool requestTemperaturesByAddress(const uint8_t *address) { (void)address; return true; }
+  float getTempC(const uint8_t *address) { (void)address; return temperature; }
+
+  /*! ************************************************************************
+   * \brief Set the sensors on the bus
+   * \param count       number of sensors (max \ref NATIVE_ONEWIRE_MAX_DEVICES)
+   * \param addresses   ROM codes of the sensors
+   */
+  void nativeSetDevices(uint8_t count, const DeviceAddress *addresses)
+  {
+    deviceCount = (count > NATIVE_ONEWIRE_MAX_DEVICES) ? NATIVE_ONEWIRE_MAX_DEVICES : count;
+    memcpy(this->addresses, addresses, deviceCount * sizeof(DeviceAddress));
+  }
+
+  /// temperature of all sensors in GrdC
+  float temperature = 20.0f;
+
+private:
+  uint8_t deviceCount = 0;
+  DeviceAddress addresses[NATIVE_ONEWIRE_MAX_DEVICES];
+};
+
+#endif // NATIVE_DALLAS_TEMPERATURE_H
@@ -0,0 +1,29 @@
+// Doxygen Documentation
+/*! \file 	MCP_ADC.h
+ *  \brief  Host stand-in of the MCP3204 ADC for the native tests
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         host (native)
+ * - Hardware:          none
+ */
+
+#ifndef NATIVE_MCP_ADC_H
+#define NATIVE_MCP_ADC_H
+
+#include <Arduino.h>
+
+/// 12 bit ADC with 4 channels which reads 0
+class MCP3204
+{
+public:
+  MCP3204(uint8_t miso, uint8_t mosi, uint8_t clk) { (void)miso; (void)mosi; (void)clk; }
+  void selectVSPI() {}
+  void begin(uint8_t select) { (void)select; }
+  void setSPIspeed(uint32_t speed) { (void)speed; }
+  int16_t maxValue() { return 4095; }
+  int16_t analogRead(uint8_t channel) { (void)channel; return 0; }
+};
+
+#endif // NATIVE_MCP_ADC_H
@@ -0,0 +1,89 @@
+// Doxygen Documentation
+/*! \file 	NMEA2000_esp32.h
+ *  \brief  Host stand-in of the ESP32 CAN driver for the native tests
+ *
+ * The NMEA2000 library itself is built for the host, only the CAN
+ * controller is replaced: nothing is received, every frame is sent. The
+ * methods of the interrupt are never called, no interrupt is installed.
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         host (native)
+ * - Hardware:          none
+ */
+
+#ifndef NATIVE_NMEA2000_ESP32_H
+#define NATIVE_NMEA2000_ESP32_H
+
+#include <Arduino.h>
+#include <NMEA2000.h>
+#include <deque>
+
+/// GPIO number of the ESP-IDF
+typedef int gpio_num_t;
+
+/// CAN driver without a bus, the tests put the received frames
+class tNMEA2000_esp32 : public tNMEA2000
+{
+public:
+  tNMEA2000_esp32(gpio_num_t txPin = (gpio_num_t)16, gpio_num_t rxPin = (gpio_num_t)4)
+      : TxPin(txPin), RxPin(rxPin) {}
+
+  /*! ************************************************************************
+   * \brief Put a frame into the RX queue like the CAN interrupt
+   * \param id    CAN id of the frame
+   * \param len   length of the frame
+   * \param buf   data of the frame
+   */
+  void nativeReceiveFrame(unsigned long id, unsigned char len, const unsigned char *buf)
+  {
+    tCANFrame frame;
+    frame.id = id;
+    frame.len = (len > 8) ? 8 : len;
+    memcpy(frame.buf, buf, frame.len);
+    nativeRxFrames.push_back(frame);
+  }
+
+protected:
+  /// frame of the RX and TX queue of the driver
+  struct tCANFrame
+  {
+    uint32_t id;
+    uint8_t len;
+    uint8_t buf[8];
+  };
+
+  gpio_num_t TxPin;
+  gpio_num_t RxPin;
+  QueueHandle_t RxQueue = NULL;
+  QueueHandle_t TxQueue = NULL;
+
+  bool CANSendFrame(unsigned long id, unsigned char len, const unsigned char *buf, bool wait_sent = true) override
+  {
+    (void)id; (void)len; (void)buf; (void)wait_sent;
+    return true;
+  }
+  bool CANOpen() override { return true; }
+  bool CANGetFrame(unsigned long &id, unsigned char &len, unsigned char *buf) override
+  {
+    if (nativeRxFrames.empty())
+    {
+      return false;
+    }
+    id = nativeRxFrames.front().id;
+    len = nativeRxFrames.front().len;
+    memcpy(buf, nativeRxFrames.front().buf, len);
+    nativeRxFrames.pop_front();
+    return true;
+  }
+  void InitCANFrameBuffers() override { tNMEA2000::InitCANFrameBuffers(); }
+  void CAN_read_frame() {}
+  void CAN_send_frame(tCANFrame &frame) { (void)frame; }
+
+private:
+  /// frames received by \ref nativeReceiveFrame
+  std::deque<tCANFrame> nativeRxFrames;
+};
+
+#endif // NATIVE_NMEA2000_ESP32_H
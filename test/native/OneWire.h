@@ -0,0 +1,24 @@
+// Doxygen Documentation
+/*! \file 	OneWire.h
+ *  \brief  Host stand-in of the 1-Wire bus for the native tests
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         host (native)
+ * - Hardware:          none
+ */
+
+#ifndef NATIVE_ONEWIRE_H
+#define NATIVE_ONEWIRE_H
+
+#include <Arduino.h>
+
+/// 1-Wire bus without devices
+class OneWire
+{
+public:
+  OneWire(uint8_t pin) { (void)pin; }
+};
+
+#endif // NATIVE_ONEWIRE_H
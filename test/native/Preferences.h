@@ -0,0 +1,33 @@
+// Doxygen Documentation
+/*! \file 	Preferences.h
+ *  \brief  Host stand-in of the NVS preferences for the native tests
+ *
+ * Nothing is stored, every key reads its default.
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         host (native)
+ * - Hardware:          none
+ */
+
+#ifndef NATIVE_PREFERENCES_H
+#define NATIVE_PREFERENCES_H
+
+#include <Arduino.h>
+
+/// Empty NVS namespace
+class Preferences
+{
+public:
+  bool begin(const char *name, bool readOnly = false) { (void)name; (void)readOnly; return true; }
+  void end() {}
+  size_t putDouble(const char *key, double value) { (void)key; (void)value; return sizeof(double); }
+  double getDouble(const char *key, double defaultValue = NAN) { (void)key; return defaultValue; }
+  size_t putBytes(const char *key, const void *value, size_t len) { (void)key; (void)value; return len; }
+  size_t getBytes(const char *key, void *buf, size_t maxLen) { (void)key; (void)buf; (void)maxLen; return 0; }
+  size_t getBytesLength(const char *key) { (void)key; return 0; }
+  bool remove(const char *key) { (void)key; return true; }
+};
+
+#endif // NATIVE_PREFERENCES_H
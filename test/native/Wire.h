@@ -0,0 +1,61 @@
+// Doxygen Documentation
+/*! \file 	Wire.h
+ *  \brief  Host stand-in of the I2C bus for the native tests
+ *
+ * The bytes are dropped. A test can let the next transactions fail with
+ * \ref nativeSetError to check the error handling of the panels.
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         host (native)
+ * - Hardware:          none
+ */
+
+#ifndef NATIVE_WIRE_H
+#define NATIVE_WIRE_H
+
+#include <Arduino.h>
+
+/// Size of the transmit buffer like the ESP32 core
+#define I2C_BUFFER_LENGTH 128
+
+/// I2C bus without devices
+class TwoWire
+{
+public:
+  TwoWire(uint8_t bus) { (void)bus; }
+  bool begin(int sda, int scl) { (void)sda; (void)scl; return true; }
+  bool setClock(uint32_t frequency) { clock = frequency; return true; }
+  void beginTransmission(uint8_t address) { (void)address; length = 0; }
+  size_t write(uint8_t value) { (void)value; length++; return 1; }
+  size_t write(const uint8_t *buf, size_t len) { (void)buf; length += len; return len; }
+  uint8_t endTransmission(bool sendStop = true)
+  {
+    (void)sendStop;
+    transactions++;
+    if (errorCount > 0)
+    {
+      errorCount--;
+      return 2; // address not acknowledged
+    }
+    return (length > I2C_BUFFER_LENGTH) ? 1 : 0;
+  }
+
+  /*! ************************************************************************
+   * \brief Let the next transactions fail
+   * \param count   number of failing transactions
+   */
+  void nativeSetError(uint32_t count) { errorCount = count; }
+
+  /// I2C clock in Hz
+  uint32_t clock = 100000;
+  /// number of transactions
+  uint32_t transactions = 0;
+
+private:
+  size_t length = 0;
+  uint32_t errorCount = 0;
+};
+
+#endif // NATIVE_WIRE_H
@@ -0,0 +1,40 @@
+// Doxygen Documentation
+/*! \file 	esp_intr_alloc.h
+ *  \brief  Host stand-in of the interrupt allocation for the native tests
+ *
+ * No interrupt is installed, the handler is never called.
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         host (native)
+ * - Hardware:          none
+ */
+
+#ifndef NATIVE_ESP_INTR_ALLOC_H
+#define NATIVE_ESP_INTR_ALLOC_H
+
+#include <Arduino.h>
+
+/// Error code of the ESP-IDF
+typedef int esp_err_t;
+/// Handle of an allocated interrupt
+typedef void *intr_handle_t;
+/// Handler of an interrupt
+typedef void (*intr_handler_t)(void *arg);
+
+#define ESP_OK 0
+#define ESP_ERROR_CHECK(x) (void)(x)
+
+/// Allocate an interrupt, nothing is installed
+inline esp_err_t esp_intr_alloc(int source, int flags, intr_handler_t handler, void *arg, intr_handle_t *handle)
+{
+  (void)source; (void)flags; (void)handler; (void)arg;
+  if (handle != NULL)
+  {
+    *handle = NULL;
+  }
+  return ESP_OK;
+}
+
+#endif // NATIVE_ESP_INTR_ALLOC_H
@@ -0,0 +1,28 @@
+// Doxygen Documentation
+/*! \file 	max6675.h
+ *  \brief  Host stand-in of the MAX6675 thermocouple for the native tests
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         host (native)
+ * - Hardware:          none
+ */
+
+#ifndef NATIVE_MAX6675_H
+#define NATIVE_MAX6675_H
+
+#include <Arduino.h>
+
+/// Thermocouple which reads a fixed temperature
+class MAX6675
+{
+public:
+  MAX6675(int8_t sclk, int8_t cs, int8_t miso) { (void)sclk; (void)cs; (void)miso; }
+  float readCelsius() { return temperature; }
+
+  /// temperature in GrdC
+  float temperature = 20.0f;
+};
+
+#endif // NATIVE_MAX6675_H
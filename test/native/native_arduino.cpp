@@ -0,0 +1,132 @@
+// Doxygen Documentation
+/*! \file 	native_arduino.cpp
+ *  \brief  Host stand-in of the Arduino core and FreeRTOS for the native tests
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         host (native)
+ * - Hardware:          none
+ */
+
+#include <Arduino.h>
+#include <stdarg.h>
+
+/// UART of the terminal
+HardwareSerial Serial;
+
+/// time of millis() and micros() in microseconds
+static uint64_t nativeTimeUs = 0;
+
+/// handle of the one mutex, never NULL
+static int nativeMutex;
+
+//****************************************
+// Time
+uint32_t millis() { return (uint32_t)(nativeTimeUs / 1000); }
+uint32_t micros() { return (uint32_t)nativeTimeUs; }
+void delay(uint32_t ms) { nativeTimeUs += (uint64_t)ms * 1000; }
+void delayMicroseconds(uint32_t us) { nativeTimeUs += us; }
+void nativeSetMillis(uint32_t ms) { nativeTimeUs = (uint64_t)ms * 1000; }
+void nativeAdvanceMicros(uint32_t us) { nativeTimeUs += us; }
+
+//****************************************
+// GPIO, ADC and timers
+void pinMode(uint8_t, uint8_t) {}
+void digitalWrite(uint8_t, uint8_t) {}
+int digitalRead(uint8_t) { return HIGH; }
+uint16_t analogRead(uint8_t) { return 0; }
+int digitalPinToInterrupt(int pin) { return pin; }
+void attachInterrupt(int, void (*)(), int) {}
+hw_timer_t *timerBegin(uint8_t, uint16_t, bool) { return NULL; }
+void timerStart(hw_timer_t *) {}
+uint64_t timerRead(hw_timer_t *) { return nativeTimeUs; }
+
+//****************************************
+// FreeRTOS
+SemaphoreHandle_t xSemaphoreCreateMutex() { return &nativeMutex; }
+BaseType_t xSemaphoreTake(SemaphoreHandle_t, TickType_t) { return pdTRUE; }
+BaseType_t xSemaphoreGive(SemaphoreHandle_t) { return pdTRUE; }
+void vTaskDelay(TickType_t ticks) { delay(ticks); }
+TickType_t xTaskGetTickCount() { return millis(); }
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t) { return 0; }
+BaseType_t xTaskNotifyGive(TaskHandle_t) { return pdPASS; }
+uint32_t ulTaskNotifyTake(BaseType_t, TickType_t) { return 0; }
+BaseType_t xQueuePeek(QueueHandle_t, void *, TickType_t) { return pdFALSE; }
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t) { return 0; }
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t) { return 0; }
+
+//****************************************
+// String
+String::String(double value, unsigned int decimals)
+{
+  char buffer[32];
+  snprintf(buffer, sizeof(buffer), "%.*f", (int)decimals, value);
+  assign(buffer);
+}
+
+//****************************************
+// Print
+size_t Print::write(const uint8_t *buf, size_t len)
+{
+  size_t n = 0;
+  while (len-- > 0)
+  {
+    n += write(*buf++);
+  }
+  return n;
+}
+
+size_t Print::print(const char *text)
+{
+  return write((const uint8_t *)text, strlen(text));
+}
+
+size_t Print::print(long value, int base)
+{
+  char buffer[24];
+  snprintf(buffer, sizeof(buffer), (base == HEX) ? "%lX" : "%ld", value);
+  return print(buffer);
+}
+
+size_t Print::print(unsigned long value, int base)
+{
+  char buffer[24];
+  snprintf(buffer, sizeof(buffer), (base == HEX) ? "%lX" : "%lu", value);
+  return print(buffer);
+}
+
+size_t Print::print(double value, int decimals)
+{
+  char buffer[32];
+  snprintf(buffer, sizeof(buffer), "%.*f", decimals, value);
+  return print(buffer);
+}
+
+size_t Print::printf(const char *format, ...)
+{
+  char buffer[256];
+  va_list args;
+
+  va_start(args, format);
+  vsnprintf(buffer, sizeof(buffer), format, args);
+  va_end(args);
+  return print(buffer);
+}
+
+//****************************************
+// Serial
+size_t HardwareSerial::write(uint8_t c)
+{
+  return write(&c, 1);
+}
+
+size_t HardwareSerial::write(const uint8_t *buf, size_t len)
+{
+  if (this->capture != NULL)
+  {
+    this->capture->append((const char *)buf, len);
+    return len;
+  }
+  return fwrite(buf, 1, len, stdout);
+}
@@ -0,0 +1,21 @@
+// Doxygen Documentation
+/*! \file 	native_globals.cpp
+ *  \brief  Objects of main.cpp for the native tests
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         host (native)
+ * - Hardware:          none
+ */
+
+#include <native_globals.h>
+
+LookUpTable1D mapTCO(AXIS_TCO_MES, MAP_TCO_MES, TCO_AXIS_LEN, TCO_MAP_PREC, lutInterp_pchip);
+LookUpTable1D mapPOIL(AXIS_POIL_MES, MAP_POIL_MES, POIL_AXIS_LEN, POIL_MAP_PREC, lutInterp_pchip);
+CalibrationStore calibration;
+AcquireData data;
+N2kGateway n2kGateway;
+N2kCanDriver n2kCanDriver(ESP32_CAN_TX_PIN, ESP32_CAN_RX_PIN, n2kGateway);
+tNMEA2000 &NMEA2000 = n2kCanDriver;
+N2kBusMonitor n2kBusMonitor(n2kCanDriver);
@@ -0,0 +1,40 @@
+// Doxygen Documentation
+/*! \file 	native_globals.h
+ *  \brief  Objects of main.cpp for the native tests
+ *
+ * The modules under test use the global objects of main.cpp, which is
+ * not built for the host. The same objects are created here.
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         host (native)
+ * - Hardware:          none
+ */
+
+#ifndef NATIVE_GLOBALS_H
+#define NATIVE_GLOBALS_H
+
+#include <acquire_data.h>
+#include <calibration_store.h>
+#include <lookUpTable.h>
+#include <n2k_can_driver.h>
+#include <n2k_bus_monitor.h>
+#include <n2k_gateway.h>
+
+/// map to convert the measured voltage into tEngine
+extern LookUpTable1D mapTCO;
+/// map to convert the measured voltage into pOil
+extern LookUpTable1D mapPOIL;
+/// calibration data for maps and ADC factors
+extern CalibrationStore calibration;
+/// all measured data, set by the tests with DataPoint::updateValue
+extern AcquireData data;
+/// stream of all N2K frames
+extern N2kGateway n2kGateway;
+/// CAN driver without a bus
+extern N2kCanDriver n2kCanDriver;
+/// monitor of the NMEA2000 bus, no frames on the host
+extern N2kBusMonitor n2kBusMonitor;
+
+#endif // NATIVE_GLOBALS_H
@@ -0,0 +1,165 @@
+// Doxygen Documentation
+/*! \file 	recording_backend.h
+ *  \brief  Recording panel for the native tests of the LCD pages
+ *
+ * This File contains a panel which keeps the DDRAM and the CGRAM of a
+ * HD44780 20x4 instead of sending them. The tests read the grid shown
+ * and the I2C bytes the LcdPcf8574 would have sent for the same calls.
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         host (native)
+ * - Hardware:          none
+ */
+
+#ifndef RECORDING_BACKEND_H
+#define RECORDING_BACKEND_H
+
+#include <Arduino.h>
+#include <display_backend.h>
+#include <lcd_pcf8574.h>
+
+/// Size of the DDRAM of the HD44780
+#define RECORDING_DDRAM_SIZE 0x68
+
+/*! ************************************************************************
+ * \class RecordingBackend
+ * \brief HD44780 20x4 without a bus
+ *
+ * The cursor moves like on the HD44780 (end of row 1 continues in row 3,
+ * end of row 3 in row 2, end of row 2 in row 4). The I2C bytes are
+ * counted like \ref LcdPcf8574 sends them: 4 expander bytes per LCD
+ * byte, one address byte per transaction of max 31 LCD bytes.
+ */
+class RecordingBackend : public DisplayBackend
+{
+public:
+  void begin(uint8_t cols, uint8_t rows, TwoWire &wire) override
+  {
+    (void)cols;
+    (void)rows;
+    (void)wire;
+    memset(ddram, ' ', sizeof(ddram));
+    memset(cgram, 0, sizeof(cgram));
+    cursor = 0;
+    backlight = 0;
+  }
+
+  void setBacklight(uint8_t brightness) override
+  {
+    backlight = brightness;
+    i2cByteCount += 2;
+    i2cTransactionCount++;
+  }
+
+  void write(const uint8_t *buf, size_t len) override
+  {
+    for (size_t i = 0; i < len; i++)
+    {
+      putChar(buf[i]);
+    }
+    countLcdBytes(len);
+  }
+
+  void writeAt(uint8_t col, uint8_t row, const uint8_t *buf, size_t len) override
+  {
+    static const uint8_t rowAddress[4] = {0x00, 0x40, 0x14, 0x54};
+
+    cursor = rowAddress[row & 0x03] + col;
+    for (size_t i = 0; i < len; i++)
+    {
+      putChar(buf[i]);
+    }
+    countLcdBytes(1 + len);
+  }
+
+  void createChar(uint8_t location, const uint8_t charmap[8]) override
+  {
+    memcpy(cgram[location & 0x07], charmap, 8);
+    countLcdBytes(9);
+  }
+
+  uint32_t getI2cClock() const override { return LCD_I2C_CLOCK; }
+  uint32_t getI2cByteCount() const override { return i2cByteCount; }
+  uint32_t getI2cTransactionCount() const override { return i2cTransactionCount; }
+  uint32_t getI2cErrorCount() const override { return i2cErrorCount; }
+
+  /*! ************************************************************************
+   * \brief Count a failed I2C transaction, the grid is kept
+   */
+  void nativeAddError() { i2cErrorCount++; }
+
+  /*! ************************************************************************
+   * \brief Get a row as shown, glyphs as '0'..'7' and the full block as '#'
+   * \param row   row 0..3
+   * \return 20 characters
+   */
+  std::string getRow(uint8_t row) const
+  {
+    static const uint8_t rowAddress[4] = {0x00, 0x40, 0x14, 0x54};
+    std::string text;
+
+    for (uint8_t col = 0; col < 20; col++)
+    {
+      uint8_t c = ddram[rowAddress[row] + col];
+      if (c < 16)
+      {
+        c = '0' + (c & 0x07);
+      }
+      else if (c == 0xFF)
+      {
+        c = '#';
+      }
+      text += (char)c;
+    }
+    return text;
+  }
+
+  /*! ************************************************************************
+   * \brief Get a glyph of the CGRAM
+   * \param location   number of the glyph (0..7)
+   * \return 8 rows of the glyph
+   */
+  const uint8_t *getGlyph(uint8_t location) const { return cgram[location & 0x07]; }
+
+  /// brightness of the last setBacklight
+  uint8_t backlight = 0;
+
+private:
+  uint8_t ddram[RECORDING_DDRAM_SIZE];
+  uint8_t cgram[8][8];
+  uint8_t cursor = 0;
+  uint32_t i2cByteCount = 0;
+  uint32_t i2cTransactionCount = 0;
+  uint32_t i2cErrorCount = 0;
+
+  void putChar(uint8_t c)
+  {
+    if (cursor < RECORDING_DDRAM_SIZE)
+    {
+      ddram[cursor] = c;
+    }
+    cursor++;
+    // row 3 continues in row 2, row 4 continues in row 1
+    if (cursor == 0x28)
+    {
+      cursor = 0x40;
+    }
+    else if (cursor == 0x68)
+    {
+      cursor = 0x00;
+    }
+  }
+
+  void countLcdBytes(size_t lcdBytes)
+  {
+    const size_t perTransaction = LCD_I2C_BATCH_SIZE / LCD_EXPANDER_BYTES_PER_LCD_BYTE;
+    size_t transactions = (lcdBytes + perTransaction - 1) / perTransaction;
+
+    i2cByteCount += lcdBytes * LCD_EXPANDER_BYTES_PER_LCD_BYTE + transactions;
+    i2cTransactionCount += transactions;
+  }
+};
+
+#endif // RECORDING_BACKEND_H
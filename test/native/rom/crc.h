@@ -0,0 +1,38 @@
+// Doxygen Documentation
+/*! \file 	crc.h
+ *  \brief  Host stand-in of the CRC functions of the ESP32 ROM for the native tests
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         host (native)
+ * - Hardware:          none
+ */
+
+#ifndef NATIVE_ROM_CRC_H
+#define NATIVE_ROM_CRC_H
+
+#include <stdint.h>
+
+/*! ************************************************************************
+ * \brief CRC32 (little endian, polynomial 0xEDB88320) like the ROM
+ * \param crc   CRC of the previous data, 0 at the start
+ * \param buf   data
+ * \param len   number of bytes
+ * \return CRC32
+ */
+static inline uint32_t crc32_le(uint32_t crc, uint8_t const *buf, uint32_t len)
+{
+  crc = ~crc;
+  while (len-- > 0)
+  {
+    crc ^= *buf++;
+    for (uint8_t i = 0; i < 8; i++)
+    {
+      crc = (crc >> 1) ^ (0xEDB88320UL & (0 - (crc & 1)));
+    }
+  }
+  return ~crc;
+}
+
+#endif // NATIVE_ROM_CRC_H
@@ -0,0 +1,18 @@
+// Doxygen Documentation
+/*! \file 	soc.h
+ *  \brief  Host stand-in of the interrupt sources of the ESP32
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         host (native)
+ * - Hardware:          none
+ */
+
+#ifndef NATIVE_SOC_H
+#define NATIVE_SOC_H
+
+/// Interrupt source of the CAN controller
+#define ETS_CAN_INTR_SOURCE 37
+
+#endif // NATIVE_SOC_H
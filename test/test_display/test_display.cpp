@@ -0,0 +1,306 @@
+// Doxygen Documentation
+/*! \file 	test_display.cpp
+ *  \brief  Native tests of the LCD pages
+ *
+ * Every page of \ref lcdPages is rendered from fixed values into the
+ * recording panel and compared with the expected grid. A refresh of the
+ * data of every page is driven with a second set of values, its I2C
+ * bytes must stay within the budget of the page. After an I2C error the
+ * whole LCD has to be written again.
+ *
+ * Run with "pio test -e native".
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         host (native)
+ * - Hardware:          none
+ */
+
+#include <unity.h>
+#include <display_data.h>
+#include <native_globals.h>
+#include <recording_backend.h>
+#include <versionInfo.h>
+
+/// Time of the first render in milliseconds
+#define TEST_START_MS 1000000UL
+
+/*! ************************************************************************
+ * \struct  tTestValue
+ * \brief   A measured value in both sets of test values
+ *
+ * All digits of set B differ from set A, so a refresh rewrites every
+ * field of a page.
+ */
+typedef struct tTestValue
+{
+  /// measured value
+  DataPoint AcquireData::*point;
+  /// value of set A
+  double a;
+  /// value of set B
+  double b;
+} tTestValue;
+
+static const tTestValue testValues[] = {
+    // value                     set A     set B
+    {&AcquireData::tEngine, 82.4, 97.6},
+    {&AcquireData::tSeaOutletWall, 31.27, 48.81},
+    {&AcquireData::tAlternator, 65.3, 78.9},
+    {&AcquireData::tGearbox, 54.2, 61.7},
+    {&AcquireData::tExhaust, 312.0, 487.0},
+    {&AcquireData::nMot, 1850.0, 2407.0},
+    {&AcquireData::nShaft, 912.0, 1236.0},
+    {&AcquireData::nAlternator1, 5432.0, 6789.0},
+    {&AcquireData::nAlternator2, 4321.0, 5678.0},
+    {&AcquireData::uBat, 13.82, 12.47},
+    {&AcquireData::pOil, 3.46, 4.71},
+    {&AcquireData::uMcp3204Ch1, 1.23, 4.56},
+    {&AcquireData::uMcp3204Ch2, 2.34, 5.67},
+    {&AcquireData::uMcp3204Ch3, 3.45, 6.78},
+    {&AcquireData::uMcp3204Ch4, 4.56, 7.89},
+    {&AcquireData::engSecond, 4567890.0, 5678901.0},
+};
+
+/// 1-Wire sensors on the bus
+static const DeviceAddress testSensors[3] = {
+    {0x28, 0xFF, 0x64, 0x1E, 0x0F, 0x9C, 0x3A, 0x11},
+    {0x28, 0xFF, 0x12, 0x34, 0x56, 0x78, 0x9A, 0x22},
+    {0x28, 0x61, 0x64, 0x12, 0x3C, 0x7B, 0xC5, 0x33},
+};
+
+/// Version in the last row of the welcome page
+#define TEST_STR(x) TEST_STR_(x)
+/// Helper of \ref TEST_STR
+#define TEST_STR_(x) #x
+
+/// Expected grid of every page with the values of set A (order of lcdPages)
+static const char *const expectedGrids[][LCD_ROWS] = {
+    {"VolvoPenta Connect  ",
+     "---  Tatooine  ---  ",
+     "by Matthias Werner  ",
+     "      Version " TEST_STR(SW_VERSION_MAJOR) "." TEST_STR(SW_VERSION_MINOR) "." TEST_STR(SW_VERSION_PATCH) " "},
+    {"Engine Data  1268.9h",
+     "--------------------",
+     "  rpm GrdC  bar GrdC",
+     " 1850   82  3.5  312"},
+    {"Temperature   [GrdC]",
+     "--------------------",
+     "  Eng Gear  Sea  Exh",
+     "   82   54 31.3  312"},
+    {"Speed        [U/min]",
+     "--------------------",
+     "  Eng Gear Alt1 Alt2",
+     " 1850  912 5432 4321"},
+    {"Alternator  Data    ",
+     "--------------------",
+     "  rpm GrdC  rpm    V",
+     " 5432   65 4321 13.8"},
+    {"MCP3204       13.82V",
+     "--------------------",
+     "    V    V    V    V",
+     "  1.2  2.3  3.5  4.6"},
+    {"1 Alarm             ",
+     "W!Exhaust temp 01:23",
+     "                    ",
+     "                    "},
+    // big digits, '0'..'7' are the glyphs of the CGRAM, '#' the full block
+    {"12  062 366 012     ",
+     "4#4 345 445 345  rpm",
+     "        062 662     ",
+     "        345 344 GrdC"},
+    {"Found 2 DS18S20.    ",
+     "> 0x28ff641e0f9c3a11",
+     "> 0x28ff123456789a22",
+     "                    "},
+    {"N2K Bus  Load   0.0%",
+     "10s  0.0% 60s  0.0% ",
+     "Rx    0/s  Tx    0/s",
+     "TEC  0 REC  0 Off  0"},
+    {"Cool GrdC           ",
+     "                    ",
+     "  collecting data   ",
+     "                    "},
+};
+static_assert(sizeof(expectedGrids) / sizeof(expectedGrids[0]) == LCD_PAGE_COUNT, "one expected grid per page");
+
+/// recording panel of the tests
+static RecordingBackend panel;
+/// pages under test, created for each test
+static DisplayData *display = NULL;
+
+//****************************************
+// Set all measured values to one set
+static void setTestValues(bool setB)
+{
+  for (uint8_t i = 0; i < sizeof(testValues) / sizeof(testValues[0]); i++)
+  {
+    (data.*testValues[i].point).updateValue(setB ? testValues[i].b : testValues[i].a, millis());
+  }
+}
+
+//****************************************
+// Show a page and render it
+static void showPage(uint8_t page)
+{
+  display->setLcdCurrentPage(page);
+  display->render();
+}
+
+//****************************************
+// Compare the panel with an expected grid
+static void assertGrid(const char *const expected[LCD_ROWS], uint8_t page)
+{
+  char message[32];
+
+  for (uint8_t row = 0; row < LCD_ROWS; row++)
+  {
+    snprintf(message, sizeof(message), "page %u row %u", page, row);
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(expected[row], panel.getRow(row).c_str(), message);
+  }
+}
+
+void setUp(void)
+{
+  nativeSetMillis(TEST_START_MS);
+  oneWireSensors.nativeSetDevices(2, testSensors);
+  data.currentEngineDiscreteStatus.flgLowOilPressure.resetFlag();
+  data.currentEngineDiscreteStatus.flgHighCoolantTemp.resetFlag();
+  data.currentEngineDiscreteStatus.flgHighExhaustTemp.resetFlag();
+  data.currentEngineDiscreteStatus.flgHighGearboxTemp.resetFlag();
+  data.currentEngineDiscreteStatus.flgHighAlternatorTemp.resetFlag();
+  data.currentEngineDiscreteStatus.flgHighSeaWaterTemp.resetFlag();
+  setTestValues(false);
+
+  display = new DisplayData(data, n2kBusMonitor, panel);
+  display->setupLCDPanel();
+}
+
+void tearDown(void)
+{
+  delete display;
+  display = NULL;
+}
+
+//****************************************
+// Every page shows the expected grid
+void test_pages_match_expected_grids(void)
+{
+  // an alarm with a known age for the alarm page
+  nativeSetMillis(TEST_START_MS - 83000);
+  data.currentEngineDiscreteStatus.flgHighExhaustTemp.setFlag();
+  nativeSetMillis(TEST_START_MS);
+
+  for (uint8_t i = 0; i < LCD_PAGE_COUNT; i++)
+  {
+    showPage(lcdPages[i].page);
+    assertGrid(expectedGrids[i], lcdPages[i].page);
+  }
+}
+
+//****************************************
+// A refresh of the data of every page stays within its I2C budget
+void test_data_refresh_within_budget(void)
+{
+  char message[48];
+
+  for (uint8_t i = 0; i < LCD_PAGE_COUNT; i++)
+  {
+    const tLcdPage &page = lcdPages[i];
+
+    setTestValues(false);
+    oneWireSensors.nativeSetDevices(2, testSensors);
+    data.currentEngineDiscreteStatus.flgHighGearboxTemp.resetFlag();
+    showPage(page.page);
+
+    // all values, the sensor list and the alarm list change
+    setTestValues(true);
+    oneWireSensors.nativeSetDevices(3, testSensors);
+    data.currentEngineDiscreteStatus.flgHighGearboxTemp.setFlag();
+    // a new bucket of the trends
+    nativeAdvanceMicros(TREND_BUCKET_MS * 1000UL);
+
+    uint32_t bytes = panel.getI2cByteCount();
+    uint32_t transactions = panel.getI2cTransactionCount();
+    display->render();
+    bytes = panel.getI2cByteCount() - bytes;
+    transactions = panel.getI2cTransactionCount() - transactions;
+
+    snprintf(message, sizeof(message), "page %u refresh %lu bytes %lu transactions", page.page,
+             (unsigned long)bytes, (unsigned long)transactions);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32_MESSAGE(page.refreshBytesBudget, bytes, message);
+  }
+}
+
+//****************************************
+// A refresh without a change sends nothing
+void test_unchanged_refresh_is_idle(void)
+{
+  for (uint8_t i = 0; i < LCD_PAGE_COUNT; i++)
+  {
+    showPage(lcdPages[i].page);
+
+    uint32_t bytes = panel.getI2cByteCount();
+    display->render();
+    TEST_ASSERT_EQUAL_UINT32(bytes, panel.getI2cByteCount());
+  }
+}
+
+//****************************************
+// A page request does not write to the LCD, the LCD task renders it
+void test_page_request_sends_nothing(void)
+{
+  showPage(lcdPages[1].page);
+
+  uint32_t bytes = panel.getI2cByteCount();
+  display->setLcdCurrentPage(lcdPages[2].page);
+  TEST_ASSERT_EQUAL_UINT32(bytes, panel.getI2cByteCount());
+
+  display->render();
+  assertGrid(expectedGrids[2], lcdPages[2].page);
+}
+
+//****************************************
+// After an I2C error the whole LCD is written again
+void test_i2c_error_writes_whole_lcd(void)
+{
+  showPage(lcdPages[1].page);
+
+  panel.nativeAddError();
+  uint32_t bytes = panel.getI2cByteCount();
+  display->render();
+  bytes = panel.getI2cByteCount() - bytes;
+
+  // all rows, the grid is unchanged
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT32(LCD_ROWS * LCD_RUN_BYTES(LCD_COLS), bytes);
+  assertGrid(expectedGrids[1], lcdPages[1].page);
+
+  // the shadow is valid again
+  bytes = panel.getI2cByteCount();
+  display->render();
+  TEST_ASSERT_EQUAL_UINT32(bytes, panel.getI2cByteCount());
+}
+
+//****************************************
+// The self check finds no text cut at the end of a row
+void test_self_check_passes(void)
+{
+  display->requestSelfCheck();
+  display->render();
+  TEST_ASSERT_TRUE(display->isSelfCheckDone());
+  TEST_ASSERT_TRUE(display->printSelfCheck());
+}
+
+int main(int argc, char **argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_pages_match_expected_grids);
+  RUN_TEST(test_data_refresh_within_budget);
+  RUN_TEST(test_unchanged_refresh_is_idle);
+  RUN_TEST(test_page_request_sends_nothing);
+  RUN_TEST(test_i2c_error_writes_whole_lcd);
+  RUN_TEST(test_self_check_passes);
+  return UNITY_END();
+}
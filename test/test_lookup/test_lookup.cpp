@@ -0,0 +1,175 @@
+// Doxygen Documentation
+/*! \file 	test_lookup.cpp
+ *  \brief  Native tests of the monotone cubic interpolation of LookUpTable1D
+ *
+ * Each table of \ref lookupCases is looked up at every fixed point value
+ * of its axis and a bit beyond. The curve has to hit the points of the
+ * table, stay in between the values of a segment, follow the direction of
+ * the segment and hold the end values outside of the axis.
+ *
+ * Run with "pio test -e native".
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         host (native)
+ * - Hardware:          none
+ */
+
+#include <unity.h>
+#include <lookUpTable.h>
+#include <adc_calib.h>
+
+/// fixed point values looked up beyond each end of the axis
+#define TEST_LOOKUP_BEYOND 50
+
+/*! ************************************************************************
+ * \struct  tLookupCase
+ * \brief   A table for the PCHIP lookup
+ */
+typedef struct tLookupCase
+{
+  /// name shown with a failed check
+  const char *name;
+  /// axis, strict monotone rising
+  const uint32_t *axis;
+  /// values of the table
+  const uint32_t *table;
+  /// number of points
+  uint8_t length;
+} tLookupCase;
+
+static const uint32_t axisRising[] = {100, 200, 400, 450, 700, 1000};
+static const uint32_t tableRising[] = {0, 50, 60, 300, 310, 2000};
+static const uint32_t tableFalling[] = {2000, 1500, 1490, 600, 20, 10};
+static const uint32_t tableFlat[] = {100, 400, 400, 400, 900, 900};
+static const uint32_t tablePeak[] = {10, 800, 1200, 200, 200, 900};
+static const uint32_t axisTwo[] = {1000, 3000};
+static const uint32_t tableTwo[] = {500, 100};
+static const uint32_t axisThree[] = {0, 10, 5000};
+static const uint32_t tableThree[] = {0, 4000, 4100};
+
+static const tLookupCase lookupCases[] = {
+    // name          axis             table           length
+    {"rising", axisRising, tableRising, 6},
+    {"falling", axisRising, tableFalling, 6},
+    {"flat", axisRising, tableFlat, 6},
+    {"peak", axisRising, tablePeak, 6},
+    {"two points", axisTwo, tableTwo, 2},
+    {"steep start", axisThree, tableThree, 3},
+    {"coolant temp", AXIS_TCO_MES, MAP_TCO_MES, TCO_AXIS_LEN},
+    {"oil pressure", AXIS_POIL_MES, MAP_POIL_MES, POIL_AXIS_LEN},
+};
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+//****************************************
+// The curve hits every point of the table
+void test_pchip_hits_table_points(void)
+{
+  for (const tLookupCase &c : lookupCases)
+  {
+    LookUpTable1D lut(c.axis, c.table, c.length, 2, lutInterp_pchip);
+
+    for (uint8_t i = 0; i < c.length; i++)
+    {
+      uint32_t result = 0;
+      lut.LookUpValue(c.axis[i], &result);
+      TEST_ASSERT_EQUAL_UINT32_MESSAGE(c.table[i], result, c.name);
+    }
+  }
+}
+
+//****************************************
+// In between two points the curve is monotone and does not overshoot
+void test_pchip_monotone_within_segments(void)
+{
+  for (const tLookupCase &c : lookupCases)
+  {
+    LookUpTable1D lut(c.axis, c.table, c.length, 2, lutInterp_pchip);
+
+    for (uint8_t k = 0; k + 1 < c.length; k++)
+    {
+      uint32_t y1 = c.table[k];
+      uint32_t y2 = c.table[k + 1];
+      uint32_t low = (y1 < y2) ? y1 : y2;
+      uint32_t high = (y1 < y2) ? y2 : y1;
+      uint32_t previous = y1;
+
+      for (uint32_t x = c.axis[k]; x <= c.axis[k + 1]; x++)
+      {
+        uint32_t result = 0;
+        TEST_ASSERT_TRUE_MESSAGE(lut.LookUpValue(x, &result) || x == c.axis[0], c.name);
+        TEST_ASSERT_GREATER_OR_EQUAL_UINT32_MESSAGE(low, result, c.name);
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32_MESSAGE(high, result, c.name);
+        if (y2 >= y1)
+        {
+          TEST_ASSERT_GREATER_OR_EQUAL_UINT32_MESSAGE(previous, result, c.name);
+        }
+        else
+        {
+          TEST_ASSERT_LESS_OR_EQUAL_UINT32_MESSAGE(previous, result, c.name);
+        }
+        previous = result;
+      }
+    }
+  }
+}
+
+//****************************************
+// Outside of the axis the end values are held and reported
+void test_pchip_holds_end_points(void)
+{
+  for (const tLookupCase &c : lookupCases)
+  {
+    LookUpTable1D lut(c.axis, c.table, c.length, 2, lutInterp_pchip);
+    uint32_t first = c.axis[0];
+    uint32_t last = c.axis[c.length - 1];
+    uint32_t result = 0;
+
+    for (uint32_t x = (first > TEST_LOOKUP_BEYOND) ? first - TEST_LOOKUP_BEYOND : 0; x < first; x++)
+    {
+      TEST_ASSERT_FALSE_MESSAGE(lut.LookUpValue(x, &result), c.name);
+      TEST_ASSERT_EQUAL_UINT32_MESSAGE(c.table[0], result, c.name);
+    }
+    for (uint32_t x = last + 1; x <= last + TEST_LOOKUP_BEYOND; x++)
+    {
+      TEST_ASSERT_FALSE_MESSAGE(lut.LookUpValue(x, &result), c.name);
+      TEST_ASSERT_EQUAL_UINT32_MESSAGE(c.table[c.length - 1], result, c.name);
+    }
+  }
+}
+
+//****************************************
+// Two points give the straight line of the linear interpolation
+void test_pchip_two_points_is_linear(void)
+{
+  LookUpTable1D pchip(axisTwo, tableTwo, 2, 2, lutInterp_pchip);
+  LookUpTable1D linear(axisTwo, tableTwo, 2, 2, lutInterp_linear);
+
+  for (uint32_t x = axisTwo[0]; x <= axisTwo[1]; x++)
+  {
+    uint32_t resultPchip = 0;
+    uint32_t resultLinear = 0;
+    pchip.LookUpValue(x, &resultPchip);
+    linear.LookUpValue(x, &resultLinear);
+    // the linear interpolation truncates, the cubic one rounds
+    TEST_ASSERT_UINT32_WITHIN(1, resultLinear, resultPchip);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_pchip_hits_table_points);
+  RUN_TEST(test_pchip_monotone_within_segments);
+  RUN_TEST(test_pchip_holds_end_points);
+  RUN_TEST(test_pchip_two_points_is_linear);
+  return UNITY_END();
+}
@@ -0,0 +1,214 @@
+// Doxygen Documentation
+/*! \file 	test_n2k_encode.cpp
+ *  \brief  Native tests of the N2K encoders with data in N2K resolution
+ *
+ * The scale functions and the scaled encoders of process_n2k.cpp are
+ * compared byte by byte with the double based encoders of the NMEA2000
+ * library, including values which are not available or out of range.
+ *
+ * Run with "pio test -e native".
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         host (native)
+ * - Hardware:          none
+ */
+
+#include <unity.h>
+#include <process_n2k.h>
+
+/*! ************************************************************************
+ * \enum   tScaleField
+ * \brief  Type of the N2K field of a scale test
+ */
+typedef enum
+{
+  scaleField_UInt16,
+  scaleField_Int16,
+  scaleField_UInt32,
+  scaleField_UInt24
+} tScaleField;
+
+/*! ************************************************************************
+ * \struct  tScaleCase
+ * \brief   A physical value scaled to a field of a resolution
+ */
+typedef struct tScaleCase
+{
+  /// type of the field
+  tScaleField field;
+  /// physical value
+  double value;
+  /// resolution of the field
+  double resolution;
+} tScaleCase;
+
+static const tScaleCase scaleCases[] = {
+    // field             value          resolution
+    {scaleField_UInt16, 0.0, N2K_RES_SPEED},
+    {scaleField_UInt16, 850.3, N2K_RES_SPEED},
+    {scaleField_UInt16, 16383.25, N2K_RES_SPEED}, // 0xFFFD, last valid
+    {scaleField_UInt16, 16383.5, N2K_RES_SPEED},  // 0xFFFE
+    {scaleField_UInt16, 20000.0, N2K_RES_SPEED},
+    {scaleField_UInt16, -0.1, N2K_RES_SPEED}, // rounded to 0
+    {scaleField_UInt16, -0.2, N2K_RES_SPEED},
+    {scaleField_UInt16, -100.0, N2K_RES_PRESSURE},
+    {scaleField_UInt16, 358.52, N2K_RES_COOLANT_TEMP},
+    {scaleField_UInt16, 700.0, N2K_RES_COOLANT_TEMP},
+    {scaleField_UInt16, N2kDoubleNA, N2K_RES_OIL_TEMP},
+    {scaleField_Int16, 12.61, N2K_RES_VOLTAGE},
+    {scaleField_Int16, -327.68, N2K_RES_VOLTAGE}, // -0x8000, first valid
+    {scaleField_Int16, -327.69, N2K_RES_VOLTAGE},
+    {scaleField_Int16, 327.65, N2K_RES_VOLTAGE}, // 0x7FFD, last valid
+    {scaleField_Int16, 327.66, N2K_RES_VOLTAGE},
+    {scaleField_Int16, N2kDoubleNA, N2K_RES_VOLTAGE},
+    {scaleField_UInt32, 4444444.0, N2K_RES_SECONDS},
+    {scaleField_UInt32, 4294967293.0, N2K_RES_SECONDS}, // 0xFFFFFFFD, last valid
+    {scaleField_UInt32, 4294967294.0, N2K_RES_SECONDS},
+    {scaleField_UInt32, -1.0, N2K_RES_SECONDS},
+    {scaleField_UInt32, N2kDoubleNA, N2K_RES_SECONDS},
+    {scaleField_UInt24, 654.3215, N2K_RES_TEMP_EXT},
+    {scaleField_UInt24, 0.0, N2K_RES_TEMP_EXT},
+    {scaleField_UInt24, -0.001, N2K_RES_TEMP_EXT},
+    {scaleField_UInt24, 16777.213, N2K_RES_TEMP_EXT}, // 0xFFFFFD, last valid
+    {scaleField_UInt24, 16777.214, N2K_RES_TEMP_EXT},
+    {scaleField_UInt24, N2kDoubleNA, N2K_RES_TEMP_EXT},
+};
+
+//****************************************
+// Encode a case with the scale function
+static void encodeScaled(tN2kMsg &msg, const tScaleCase &c, double value)
+{
+  switch (c.field)
+  {
+  case scaleField_UInt16:
+    msg.Add2ByteUInt(N2kScaleUInt16(value, c.resolution));
+    break;
+  case scaleField_Int16:
+    msg.Add2ByteInt(N2kScaleInt16(value, c.resolution));
+    break;
+  case scaleField_UInt32:
+    msg.Add4ByteUInt(N2kScaleUInt32(value, c.resolution));
+    break;
+  case scaleField_UInt24:
+    msg.Add3ByteInt((int32_t)N2kScaleUInt24(value, c.resolution));
+    break;
+  }
+}
+
+//****************************************
+// Encode a case with the library
+static void encodeLibrary(tN2kMsg &msg, const tScaleCase &c)
+{
+  switch (c.field)
+  {
+  case scaleField_UInt16:
+    msg.Add2ByteUDouble(c.value, c.resolution);
+    break;
+  case scaleField_Int16:
+    msg.Add2ByteDouble(c.value, c.resolution);
+    break;
+  case scaleField_UInt32:
+    msg.Add4ByteUDouble(c.value, c.resolution);
+    break;
+  case scaleField_UInt24:
+    msg.Add3ByteUDouble(c.value, c.resolution);
+    break;
+  }
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+//****************************************
+// The scale functions give the bytes of the library
+void test_scale_matches_library(void)
+{
+  char message[48];
+
+  for (uint8_t i = 0; i < sizeof(scaleCases) / sizeof(scaleCases[0]); i++)
+  {
+    const tScaleCase &c = scaleCases[i];
+    tN2kMsg scaled;
+    tN2kMsg library;
+
+    encodeScaled(scaled, c, c.value);
+    encodeLibrary(library, c);
+
+    snprintf(message, sizeof(message), "case %u value %g", i, c.value);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(library.DataLen, scaled.DataLen, message);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY_MESSAGE(library.Data, scaled.Data, library.DataLen, message);
+  }
+}
+
+//****************************************
+// NaN is not available like N2kDoubleNA
+void test_scale_nan_is_not_available(void)
+{
+  TEST_ASSERT_EQUAL_HEX16(N2kUInt16NA, N2kScaleUInt16(NAN, N2K_RES_SPEED));
+  TEST_ASSERT_EQUAL_HEX16(N2kInt16NA, N2kScaleInt16(NAN, N2K_RES_VOLTAGE));
+  TEST_ASSERT_EQUAL_HEX32(N2kUInt32NA, N2kScaleUInt32(NAN, N2K_RES_SECONDS));
+  TEST_ASSERT_EQUAL_HEX32(N2K_UINT24_NA, N2kScaleUInt24(NAN, N2K_RES_TEMP_EXT));
+
+  // a NaN of a calculation stays not available
+  TEST_ASSERT_EQUAL_HEX16(N2kUInt16NA, N2kScaleUInt16(NAN + 273.15, N2K_RES_COOLANT_TEMP));
+  TEST_ASSERT_EQUAL_HEX16(N2kUInt16NA, N2kScaleUInt16(INFINITY - INFINITY, N2K_RES_COOLANT_TEMP));
+}
+
+//****************************************
+// Infinity is out of range
+void test_scale_infinity_is_out_of_range(void)
+{
+  TEST_ASSERT_EQUAL_HEX16(N2K_UINT16_OR, N2kScaleUInt16(INFINITY, N2K_RES_SPEED));
+  TEST_ASSERT_EQUAL_HEX16(N2K_UINT16_OR, N2kScaleUInt16(-INFINITY, N2K_RES_SPEED));
+  TEST_ASSERT_EQUAL_HEX16(N2K_INT16_OR, N2kScaleInt16(-INFINITY, N2K_RES_VOLTAGE));
+  TEST_ASSERT_EQUAL_HEX32(N2K_UINT32_OR, N2kScaleUInt32(INFINITY, N2K_RES_SECONDS));
+  TEST_ASSERT_EQUAL_HEX32(N2K_UINT24_OR, N2kScaleUInt24(INFINITY, N2K_RES_TEMP_EXT));
+}
+
+//****************************************
+// The scaled encoders of all PGNs give the messages of the library
+void test_scaled_encoders_match_library(void)
+{
+  TEST_ASSERT_TRUE(CheckN2kScaledEncoders());
+}
+
+//****************************************
+// The temperature extended range gives the bytes of SetN2kTemperatureExt for
+// not available, out of range and a normal value
+void test_temperature_ext_matches_library(void)
+{
+  static const double temperatures[] = {N2kDoubleNA, 20000.0, -5.0, 573.15};
+  char message[32];
+
+  for (double temperature : temperatures)
+  {
+    tN2kMsg scaled;
+    tN2kMsg library;
+
+    SetN2kTemperatureExtScaled(scaled, 0, 0, N2kts_ExhaustGasTemperature,
+                               N2kScaleUInt24(temperature, N2K_RES_TEMP_EXT));
+    SetN2kTemperatureExt(library, 0, 0, N2kts_ExhaustGasTemperature, temperature);
+
+    snprintf(message, sizeof(message), "temperature %g", temperature);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(library.DataLen, scaled.DataLen, message);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY_MESSAGE(library.Data, scaled.Data, library.DataLen, message);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_scale_matches_library);
+  RUN_TEST(test_scale_nan_is_not_available);
+  RUN_TEST(test_scale_infinity_is_out_of_range);
+  RUN_TEST(test_scaled_encoders_match_library);
+  RUN_TEST(test_temperature_ext_matches_library);
+  return UNITY_END();
+}
@@ -0,0 +1,174 @@
+// Doxygen Documentation
+/*! \file 	test_n2k_filter.cpp
+ *  \brief  Native tests of the acceptance filter of the CAN driver
+ *
+ * The filter is calculated for the PGNs of the N2K receiver. Frames of
+ * these PGNs and of the PF ranges the filter admits completely have to
+ * reach the library, all other frames are rejected. Every frame is
+ * counted for the bus load.
+ *
+ * Run with "pio test -e native".
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         host (native)
+ * - Hardware:          none
+ */
+
+#include <unity.h>
+#include <n2k_can_driver.h>
+
+/// PGNs of the N2K receiver (network management and dispatch table)
+static const unsigned long receivedPgns[] = {59392L, 59904L, 60160L, 60416L, 60928L, 126208L,
+                                             126992L, 127488L, 127489L, 126984L};
+
+/// PGNs of the PF ranges admitted completely (see 1_Mainpage.md)
+static const unsigned long admittedPgns[] = {61184L, 124928L, 126976L, 127007L, 127519L};
+
+/// PGNs of other devices which are rejected
+static const unsigned long rejectedPgns[] = {127250L, 127750L, 128259L, 129025L, 129029L,
+                                             130306L, 130312L, 65280L, 127245L, 127520L};
+
+/*! ************************************************************************
+ * \class TestCanDriver
+ * \brief CAN driver with the receive method of the library in reach
+ */
+class TestCanDriver : public N2kCanDriver
+{
+public:
+  TestCanDriver(N2kGateway &gateway) : N2kCanDriver((gpio_num_t)16, (gpio_num_t)4, gateway) {}
+  using N2kCanDriver::CANGetFrame;
+};
+
+/// stream of the frames, not started
+static N2kGateway gateway;
+/// driver under test, created for each test
+static TestCanDriver *driver = NULL;
+
+//****************************************
+// Build the CAN id of a PGN (priority 6, source 0x23, destination 0x42)
+static unsigned long canId(unsigned long pgn)
+{
+  unsigned long id = (6UL << 26) | (pgn << 8) | 0x23;
+
+  // PDU1 (addressed), the PS field is the destination
+  if (((pgn >> 8) & 0xFF) < 240)
+  {
+    id = (id & ~0xFF00UL) | (0x42UL << 8);
+  }
+  return id;
+}
+
+//****************************************
+// Receive the frame of a PGN and check if it reaches the library
+static bool receive(unsigned long pgn)
+{
+  static const unsigned char data[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+  unsigned long id = 0;
+  unsigned char len = 0;
+  unsigned char buf[8];
+
+  driver->nativeReceiveFrame(canId(pgn), 8, data);
+  return driver->CANGetFrame(id, len, buf) && id == canId(pgn);
+}
+
+void setUp(void)
+{
+  driver = new TestCanDriver(gateway);
+  driver->setAcceptanceFilter(receivedPgns, sizeof(receivedPgns) / sizeof(receivedPgns[0]));
+}
+
+void tearDown(void)
+{
+  delete driver;
+  driver = NULL;
+}
+
+//****************************************
+// The received PGNs reach the library
+void test_filter_admits_received_pgns(void)
+{
+  char message[24];
+
+  for (unsigned long pgn : receivedPgns)
+  {
+    snprintf(message, sizeof(message), "PGN %lu", pgn);
+    TEST_ASSERT_TRUE_MESSAGE(receive(pgn), message);
+  }
+  for (unsigned long pgn : admittedPgns)
+  {
+    snprintf(message, sizeof(message), "PGN %lu", pgn);
+    TEST_ASSERT_TRUE_MESSAGE(receive(pgn), message);
+  }
+  TEST_ASSERT_EQUAL_UINT32(0, driver->getRxStatistic().rejectedFrames);
+}
+
+//****************************************
+// Other PGNs are rejected, but counted for the bus load
+void test_filter_rejects_and_counts_other_pgns(void)
+{
+  char message[24];
+  const uint8_t count = sizeof(rejectedPgns) / sizeof(rejectedPgns[0]);
+
+  for (unsigned long pgn : rejectedPgns)
+  {
+    snprintf(message, sizeof(message), "PGN %lu", pgn);
+    TEST_ASSERT_FALSE_MESSAGE(receive(pgn), message);
+  }
+  TEST_ASSERT_EQUAL_UINT32(count, driver->getRxStatistic().rejectedFrames);
+  TEST_ASSERT_EQUAL_UINT32(count, driver->getFrameCounter().rxFrames);
+  TEST_ASSERT_EQUAL_UINT32(count * (N2K_CAN_FRAME_OVERHEAD_BITS + 64), driver->getFrameCounter().rxBits);
+}
+
+//****************************************
+// Rejected frames in front of an admitted one are skipped in one call
+void test_filter_skips_to_next_admitted_frame(void)
+{
+  static const unsigned char data[8] = {0};
+  unsigned long id = 0;
+  unsigned char len = 0;
+  unsigned char buf[8];
+
+  driver->nativeReceiveFrame(canId(130306L), 8, data);
+  driver->nativeReceiveFrame(canId(129025L), 8, data);
+  driver->nativeReceiveFrame(canId(127488L), 8, data);
+
+  TEST_ASSERT_TRUE(driver->CANGetFrame(id, len, buf));
+  TEST_ASSERT_EQUAL_HEX32(canId(127488L), id);
+  TEST_ASSERT_EQUAL_UINT32(3, driver->getFrameCounter().rxFrames);
+  TEST_ASSERT_FALSE(driver->CANGetFrame(id, len, buf));
+}
+
+//****************************************
+// The commanded address (65240) of another device reaches the library in
+// the broadcast frames of the transport protocol
+void test_filter_admits_commanded_address(void)
+{
+  // TP.CM BAM: 9 bytes in 2 packets of PGN 65240 (D8 FE 00)
+  static const unsigned char announce[8] = {0x20, 0x09, 0x00, 0x02, 0xFF, 0xD8, 0xFE, 0x00};
+  static const unsigned char packet[8] = {0x01, 1, 2, 3, 4, 5, 6, 7};
+  unsigned long id = 0;
+  unsigned char len = 0;
+  unsigned char buf[8];
+
+  // priority 7, to all devices (PS 0xFF)
+  driver->nativeReceiveFrame((7UL << 26) | (60416UL << 8) | 0xFF00UL | 0x23, 8, announce);
+  driver->nativeReceiveFrame((7UL << 26) | (60160UL << 8) | 0xFF00UL | 0x23, 8, packet);
+
+  TEST_ASSERT_TRUE(driver->CANGetFrame(id, len, buf));
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(announce, buf, 8);
+  TEST_ASSERT_TRUE(driver->CANGetFrame(id, len, buf));
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(packet, buf, 8);
+  TEST_ASSERT_EQUAL_UINT32(0, driver->getRxStatistic().rejectedFrames);
+}
+
+int main(int argc, char **argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_filter_admits_received_pgns);
+  RUN_TEST(test_filter_rejects_and_counts_other_pgns);
+  RUN_TEST(test_filter_skips_to_next_admitted_frame);
+  RUN_TEST(test_filter_admits_commanded_address);
+  return UNITY_END();
+}
@@ -0,0 +1,96 @@
+// Doxygen Documentation
+/*! \file 	test_n2k_gateway.cpp
+ *  \brief  Native tests of the RAW stream of the N2K gateway
+ *
+ * The frames of the ring buffer are written to a captured terminal and
+ * compared with the lines of the Yacht Devices RAW format. All frames of
+ * a full ring buffer have to be written with one call of processStream.
+ *
+ * Run with "pio test -e native".
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         host (native)
+ * - Hardware:          none
+ */
+
+#include <unity.h>
+#include <n2k_gateway.h>
+
+/// output of the terminal
+static std::string output;
+/// gateway under test, created for each test
+static N2kGateway *gateway = NULL;
+
+void setUp(void)
+{
+  output.clear();
+  Serial.nativeCapture(&output);
+  gateway = new N2kGateway();
+}
+
+void tearDown(void)
+{
+  delete gateway;
+  gateway = NULL;
+  Serial.nativeCapture(NULL);
+}
+
+//****************************************
+// A received and a sent frame in the RAW format
+void test_gateway_formats_frames(void)
+{
+  static const uint8_t data[8] = {0x01, 0x2F, 0x30, 0x70, 0x00, 0x2F, 0x30, 0x70};
+
+  gateway->setEnabled(true);
+  nativeSetMillis(63201107UL);
+  gateway->pushFrame(0x19F51323UL, 8, data, false);
+  nativeSetMillis(63201108UL);
+  gateway->pushFrame(0x0DF01000UL, 0, data, true);
+  gateway->processStream();
+
+  TEST_ASSERT_EQUAL_STRING("17:33:21.107 R 19F51323 01 2F 30 70 00 2F 30 70\r\n"
+                           "17:33:21.108 T 0DF01000\r\n",
+                           output.c_str());
+}
+
+//****************************************
+// A full ring buffer is drained with one call
+void test_gateway_drains_full_ring(void)
+{
+  static const uint8_t data[8] = {0};
+
+  gateway->setEnabled(true);
+  for (uint16_t i = 0; i < N2K_GATEWAY_RING_SIZE + 10; i++)
+  {
+    gateway->pushFrame(0x09F20123UL, 8, data, false);
+  }
+  gateway->processStream();
+  TEST_ASSERT_EQUAL_UINT32(N2K_GATEWAY_RING_SIZE * N2K_GATEWAY_LINE_MAX, output.size());
+
+  // the ring buffer is empty
+  gateway->processStream();
+  TEST_ASSERT_EQUAL_UINT32(N2K_GATEWAY_RING_SIZE * N2K_GATEWAY_LINE_MAX, output.size());
+}
+
+//****************************************
+// No frames while the stream is stopped
+void test_gateway_ignores_frames_when_off(void)
+{
+  static const uint8_t data[8] = {0};
+
+  gateway->pushFrame(0x09F20123UL, 8, data, false);
+  gateway->setEnabled(true);
+  gateway->processStream();
+  TEST_ASSERT_EQUAL_UINT32(0, output.size());
+}
+
+int main(int argc, char **argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_gateway_formats_frames);
+  RUN_TEST(test_gateway_drains_full_ring);
+  RUN_TEST(test_gateway_ignores_frames_when_off);
+  return UNITY_END();
+}
@@ -0,0 +1,187 @@
+// Doxygen Documentation
+/*! \file 	test_oled.cpp
+ *  \brief  Native tests of the dirty tiles of the OLED
+ *
+ * Bitmaps, rectangles and characters are drawn into the frame buffer of
+ * the OLED. Only the tiles of 8x8 pixels which have changed may be sent,
+ * a run of characters has to stay within the budget of its length. The
+ * big digits of DisplayData are drawn with segments over blank cells.
+ *
+ * Run with "pio test -e native".
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         host (native)
+ * - Hardware:          none
+ */
+
+#include <unity.h>
+#include <oled_ssd1306.h>
+#include <display_data.h>
+#include <native_globals.h>
+
+/// I2C bytes of a run of tiles of one page (position and one data transaction)
+#define TEST_TILE_RUN_BYTES(tiles) (OLED_POSITION_BYTES + 2 + (tiles) * OLED_TILE_WIDTH)
+
+/// I2C bus of the OLED
+static TwoWire wire(0);
+/// OLED under test, created for each test
+static OledSsd1306 *oled = NULL;
+
+//****************************************
+// Send the changes and return the I2C bytes sent
+static uint32_t sendUpdate(void)
+{
+  uint32_t bytes = oled->getI2cByteCount();
+
+  oled->endUpdate();
+  return oled->getI2cByteCount() - bytes;
+}
+
+void setUp(void)
+{
+  oled = new OledSsd1306(OLED_I2C_ADDRESS, OLED_SH1106);
+  oled->begin(OLED_COLS, OLED_ROWS, wire);
+}
+
+void tearDown(void)
+{
+  delete oled;
+  oled = NULL;
+}
+
+//****************************************
+// A rectangle sends only the tiles it covers
+void test_fill_rect_sends_covered_tiles(void)
+{
+  TEST_ASSERT_EQUAL_UINT8(OLED_WIDTH, oled->getPixelWidth());
+  TEST_ASSERT_EQUAL_UINT8(64, oled->getPixelHeight());
+
+  // one tile
+  oled->fillRect(8, 16, 8, 8, true);
+  TEST_ASSERT_EQUAL_UINT32(TEST_TILE_RUN_BYTES(1), sendUpdate());
+
+  // 3 rows in the middle of page 5, columns 12..27 (tiles 1..3)
+  oled->fillRect(12, 42, 16, 3, true);
+  TEST_ASSERT_EQUAL_UINT32(TEST_TILE_RUN_BYTES(3), sendUpdate());
+
+  // nothing changes, nothing is sent
+  oled->fillRect(12, 42, 16, 3, true);
+  TEST_ASSERT_EQUAL_UINT32(0, sendUpdate());
+
+  // clipped at the right and the bottom edge
+  oled->fillRect(120, 60, 100, 100, true);
+  TEST_ASSERT_EQUAL_UINT32(TEST_TILE_RUN_BYTES(1), sendUpdate());
+}
+
+//****************************************
+// A bitmap which does not start at a page covers two pages
+void test_bitmap_between_pages(void)
+{
+  static const uint8_t block[8] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+
+  oled->drawBitmap(32, 4, 8, 8, block);
+  TEST_ASSERT_EQUAL_UINT32(2 * TEST_TILE_RUN_BYTES(1), sendUpdate());
+
+  // the same pixels again
+  oled->drawBitmap(32, 4, 8, 8, block);
+  TEST_ASSERT_EQUAL_UINT32(0, sendUpdate());
+
+  // the rectangle of the bitmap is cleared
+  oled->fillRect(32, 4, 8, 8, false);
+  TEST_ASSERT_EQUAL_UINT32(2 * TEST_TILE_RUN_BYTES(1), sendUpdate());
+}
+
+//****************************************
+// The character grid is drawn through the bitmaps with dirty tiles
+void test_characters_send_changed_tiles(void)
+{
+  char row[OLED_COLS + 1];
+
+  // one digit in the first cell, 2 tiles on 2 pages
+  oled->writeAt(0, 3, (const uint8_t *)"8", 1);
+  uint32_t bytes = sendUpdate();
+  TEST_ASSERT_EQUAL_UINT32(2 * TEST_TILE_RUN_BYTES(2), bytes);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(OLED_RUN_BYTES(1), bytes);
+
+  // a whole row covers all tiles of its pages
+  for (uint8_t i = 0; i < OLED_COLS; i++)
+  {
+    row[i] = 'A' + i;
+  }
+  row[OLED_COLS] = '\0';
+  oled->writeAt(0, 1, (const uint8_t *)row, OLED_COLS);
+  bytes = sendUpdate();
+  TEST_ASSERT_EQUAL_UINT32(OLED_RUN_BYTES(OLED_COLS), bytes);
+
+  // the same characters again
+  oled->writeAt(0, 1, (const uint8_t *)row, OLED_COLS);
+  TEST_ASSERT_EQUAL_UINT32(0, sendUpdate());
+}
+
+//****************************************
+// The tile budget of a run covers the worst start column, is at most one
+// tile more and never exceeds a page
+void test_run_tiles_budget_fits(void)
+{
+  char message[24];
+
+  for (uint8_t len = 1; len <= OLED_COLS; len++)
+  {
+    uint8_t maxTiles = 0;
+    for (uint8_t col = 0; col + len <= OLED_COLS; col++)
+    {
+      uint8_t first = (OLED_GRID_X + col * OLED_CHAR_WIDTH) / OLED_TILE_WIDTH;
+      uint8_t last = (OLED_GRID_X + (col + len) * OLED_CHAR_WIDTH - 1) / OLED_TILE_WIDTH;
+      if (last - first + 1 > maxTiles)
+      {
+        maxTiles = last - first + 1;
+      }
+    }
+    snprintf(message, sizeof(message), "length %u", len);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32_MESSAGE(maxTiles, OLED_RUN_TILES(len), message);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32_MESSAGE(maxTiles + 1, OLED_RUN_TILES(len), message);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32_MESSAGE(OLED_TILES, OLED_RUN_TILES(len), message);
+  }
+}
+
+//****************************************
+// The big digits are drawn with segments, only a changed digit is sent
+void test_big_digits_drawn_with_pixels(void)
+{
+  DisplayData display(data, n2kBusMonitor, *oled);
+  display.setupLCDPanel();
+  sendUpdate();
+
+  data.nMot.updateValue(1850.0, millis());
+  data.tEngine.updateValue(82.4, millis());
+  display.setLcdCurrentPage(PAGE_BIG_DIGITS);
+  uint32_t bytes = oled->getI2cByteCount();
+  display.render();
+  TEST_ASSERT_GREATER_THAN_UINT32(2 * OLED_RUN_BYTES(4), oled->getI2cByteCount() - bytes);
+
+  // the same number again
+  bytes = oled->getI2cByteCount();
+  display.render();
+  TEST_ASSERT_EQUAL_UINT32(0, oled->getI2cByteCount() - bytes);
+
+  // the last digit of the engine speed covers 3 tiles of 4 pages
+  data.nMot.updateValue(1851.0, millis());
+  bytes = oled->getI2cByteCount();
+  display.render();
+  bytes = oled->getI2cByteCount() - bytes;
+  TEST_ASSERT_GREATER_THAN_UINT32(0, bytes);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(4 * TEST_TILE_RUN_BYTES(3), bytes);
+}
+
+int main(int argc, char **argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_fill_rect_sends_covered_tiles);
+  RUN_TEST(test_bitmap_between_pages);
+  RUN_TEST(test_characters_send_changed_tiles);
+  RUN_TEST(test_run_tiles_budget_fits);
+  RUN_TEST(test_big_digits_drawn_with_pixels);
+  return UNITY_END();
+}
@@ -0,0 +1,119 @@
+// Doxygen Documentation
+/*! \file 	test_signalk.cpp
+ *  \brief  Native tests of the Signal K deltas
+ *
+ * The values of tVolvoPentaData are read with the reader shared with the
+ * N2K channels. Valid values are sent in the SI unit of their path, values
+ * which are not available or out of range are sent as null. The deltas
+ * are built from the snapshot of the last publication for N2K.
+ *
+ * Run with "pio test -e native".
+ *
+ * \author 		Matthias Werner
+ * \date		10/2026
+ *
+ * - Prozessor:         host (native)
+ * - Hardware:          none
+ */
+
+#include <unity.h>
+#include <signalk_delta.h>
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+//****************************************
+// The codes of not available and out of range are invalid
+void test_read_field_validity(void)
+{
+  tVolvoPentaData data;
+  int32_t value = 0;
+
+  data.engine_speed = 0xFFFD;
+  TEST_ASSERT_TRUE(ReadN2kField(data, offsetof(tVolvoPentaData, engine_speed), n2kField_UInt16, value));
+  TEST_ASSERT_EQUAL_INT32(0xFFFD, value);
+  data.engine_speed = N2K_UINT16_OR;
+  TEST_ASSERT_FALSE(ReadN2kField(data, offsetof(tVolvoPentaData, engine_speed), n2kField_UInt16, value));
+  data.engine_speed = N2kUInt16NA;
+  TEST_ASSERT_FALSE(ReadN2kField(data, offsetof(tVolvoPentaData, engine_speed), n2kField_UInt16, value));
+  // the code is kept for the N2K channels
+  TEST_ASSERT_EQUAL_INT32(N2kUInt16NA, value);
+
+  data.battery_voltage = -1261;
+  TEST_ASSERT_TRUE(ReadN2kField(data, offsetof(tVolvoPentaData, battery_voltage), n2kField_Int16, value));
+  TEST_ASSERT_EQUAL_INT32(-1261, value);
+  data.battery_voltage = N2K_INT16_OR;
+  TEST_ASSERT_FALSE(ReadN2kField(data, offsetof(tVolvoPentaData, battery_voltage), n2kField_Int16, value));
+
+  data.engine_seconds = 0xFFFFFFFDUL;
+  TEST_ASSERT_TRUE(ReadN2kField(data, offsetof(tVolvoPentaData, engine_seconds), n2kField_UInt32, value));
+  data.engine_seconds = N2kUInt32NA;
+  TEST_ASSERT_FALSE(ReadN2kField(data, offsetof(tVolvoPentaData, engine_seconds), n2kField_UInt32, value));
+
+  data.exhaust_temperature = 0xFFFFFDUL;
+  TEST_ASSERT_TRUE(ReadN2kField(data, offsetof(tVolvoPentaData, exhaust_temperature), n2kField_UInt24, value));
+  data.exhaust_temperature = N2K_UINT24_OR;
+  TEST_ASSERT_FALSE(ReadN2kField(data, offsetof(tVolvoPentaData, exhaust_temperature), n2kField_UInt24, value));
+  data.exhaust_temperature = N2K_UINT24_NA;
+  TEST_ASSERT_FALSE(ReadN2kField(data, offsetof(tVolvoPentaData, exhaust_temperature), n2kField_UInt24, value));
+}
+
+//****************************************
+// A value which is not available is sent as null
+void test_writer_sends_null(void)
+{
+  char buffer[SIGNALK_BUFFER_SIZE];
+  SignalKWriter writer(buffer, sizeof(buffer));
+
+  writer.begin();
+  writer.addValue("propulsion.port.revolutions", 1375, 2);
+  writer.addNull("propulsion.port.oilPressure");
+  TEST_ASSERT_NOT_EQUAL(0, writer.end());
+  TEST_ASSERT_EQUAL_STRING("{\"updates\":[{\"source\":{\"label\":\"" SIGNALK_SOURCE_LABEL "\"},\"values\":["
+                           "{\"path\":\"propulsion.port.revolutions\",\"value\":13.75},"
+                           "{\"path\":\"propulsion.port.oilPressure\",\"value\":null}]}]}\n",
+                           buffer);
+}
+
+//****************************************
+// The snapshot is the last publication, the back buffer is not visible
+void test_snapshot_is_last_publication(void)
+{
+  N2kDataExchange exchange;
+  tVolvoPentaData snapshot;
+
+  exchange.begin();
+  TEST_ASSERT_FALSE(exchange.getSnapshot(snapshot));
+
+  tVolvoPentaData *back = exchange.beginWrite();
+  TEST_ASSERT_NOT_NULL(back);
+  back->engine_speed = 7400;
+  exchange.publish();
+  TEST_ASSERT_TRUE(exchange.getSnapshot(snapshot));
+  TEST_ASSERT_EQUAL_UINT16(7400, snapshot.engine_speed);
+
+  // a producer fills the next buffer
+  back = exchange.beginWrite();
+  TEST_ASSERT_NOT_NULL(back);
+  back->engine_speed = 7600;
+  TEST_ASSERT_TRUE(exchange.getSnapshot(snapshot));
+  TEST_ASSERT_EQUAL_UINT16(7400, snapshot.engine_speed);
+
+  exchange.publish();
+  TEST_ASSERT_TRUE(exchange.getSnapshot(snapshot));
+  TEST_ASSERT_EQUAL_UINT16(7600, snapshot.engine_speed);
+}
+
+int main(int argc, char **argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_read_field_validity);
+  RUN_TEST(test_writer_sends_null);
+  RUN_TEST(test_snapshot_is_last_publication);
+  return UNITY_END();
+}
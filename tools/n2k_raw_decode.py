@@ -0,0 +1,148 @@
+#!/usr/bin/env python3
+"""Decoder for the N2K gateway stream of VolvoPentaConnect.
+
+The device streams all received (R) and sent (T) CAN frames in the
+Yacht Devices RAW format after the terminal command "gw on":
+
+    17:33:21.107 R 19F51323 01 2F 30 70 00 2F 30 70
+
+Other lines of the terminal are ignored. The stream can be read from a
+log file, stdin or directly from the serial port (needs pyserial). The
+terminal runs at 115200 baud, the gateway build of the firmware
+(env az-delivery-devkit-v4-gateway) at 921600 baud.
+
+Examples:
+    n2k_raw_decode.py --port /dev/ttyUSB0 --log bus.raw   # record
+    n2k_raw_decode.py bus.raw                            # decode
+    n2k_raw_decode.py bus.raw --stats                    # frames per PGN
+    n2k_raw_decode.py bus.raw --candump > bus.log        # for canplayer
+    n2k_raw_decode.py bus.raw --replay                   # original timing
+"""
+
+import argparse
+import re
+import sys
+import time
+from collections import defaultdict
+
+RAW_LINE = re.compile(
+    r"^(\d{2}):(\d{2}):(\d{2})\.(\d{3}) ([RT]) ([0-9A-Fa-f]{8})((?: [0-9A-Fa-f]{2}){0,8})\s*$")
+
+
+def parse_line(line):
+    """Return (time in s, direction, CAN id, data) or None."""
+    match = RAW_LINE.match(line)
+    if match is None:
+        return None
+    hours, minutes, seconds, millis = (int(v) for v in match.group(1, 2, 3, 4))
+    timestamp = hours * 3600 + minutes * 60 + seconds + millis / 1000.0
+    data = bytes(int(b, 16) for b in match.group(7).split())
+    return timestamp, match.group(5), int(match.group(6), 16), data
+
+
+def decode_id(can_id):
+    """Split a CAN id into priority, PGN, source and destination."""
+    priority = (can_id >> 26) & 0x07
+    dp = (can_id >> 24) & 0x03
+    pf = (can_id >> 16) & 0xFF
+    ps = (can_id >> 8) & 0xFF
+    source = can_id & 0xFF
+    if pf < 240:
+        # PDU1, PS is the destination
+        return priority, (dp << 16) | (pf << 8), source, ps
+    return priority, (dp << 16) | (pf << 8) | ps, source, 0xFF
+
+
+def read_lines(args):
+    """Yield the lines of the stream."""
+    if args.port:
+        import serial  # pyserial
+        port = serial.Serial(args.port, args.baud, timeout=1)
+        if args.start:
+            port.write(b"gw on\n")
+        while True:
+            raw = port.readline()
+            if raw:
+                # an empty read is the timeout of the port
+                yield raw.decode("ascii", "replace")
+    else:
+        source = open(args.file, "r", errors="replace") if args.file and args.file != "-" else sys.stdin
+        yield from source
+
+
+def read_frames(args):
+    """Yield the frames of the stream and write their lines to the log file."""
+    log = open(args.log, "w") if args.log else None
+    for line in read_lines(args):
+        line = line.strip()
+        frame = parse_line(line)
+        if frame is None:
+            continue
+        if log:
+            # the log holds only RAW lines, so other tools can read it
+            log.write(line + "\n")
+            log.flush()
+        yield frame
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("file", nargs="?", help="RAW log file (default stdin)")
+    parser.add_argument("--port", help="serial port of the device")
+    parser.add_argument("--baud", type=int, default=115200, help="baud rate (default 115200)")
+    parser.add_argument("--start", action="store_true", help="send 'gw on' to the device")
+    parser.add_argument("--log", help="write all frames to this file in the RAW format")
+    parser.add_argument("--candump", action="store_true", help="print in the candump log format")
+    parser.add_argument("--interface", default="can0", help="interface name for --candump")
+    parser.add_argument("--stats", action="store_true", help="print frames per PGN at the end")
+    parser.add_argument("--replay", action="store_true", help="print with the original timing")
+    parser.add_argument("--quiet", action="store_true", help="print nothing per frame")
+    args = parser.parse_args()
+
+    stats = defaultdict(lambda: [0, 0, None, None])
+    first_time = None
+    start_wall = time.monotonic()
+
+    try:
+        for frame in read_frames(args):
+            timestamp, direction, can_id, data = frame
+            priority, pgn, source, destination = decode_id(can_id)
+
+            if first_time is None:
+                first_time = timestamp
+            # the time of the device wraps at midnight
+            offset = (timestamp - first_time) % 86400.0
+
+            if args.replay:
+                delay = offset - (time.monotonic() - start_wall)
+                if delay > 0:
+                    time.sleep(delay)
+
+            entry = stats[(pgn, source, direction)]
+            entry[0] += 1
+            entry[1] += len(data)
+            entry[2] = offset if entry[2] is None else entry[2]
+            entry[3] = offset
+
+            if args.quiet:
+                continue
+            if args.candump:
+                print("(%.6f) %s %08X#%s" % (offset, args.interface, can_id, data.hex().upper()))
+            else:
+                print("%10.3f %s prio %u PGN %6u src %3u dst %3u  %s" %
+                      (offset, direction, priority, pgn, source, destination,
+                       " ".join("%02X" % b for b in data)))
+    except KeyboardInterrupt:
+        pass
+
+    if args.stats:
+        out = sys.stderr if args.candump else sys.stdout
+        print("   PGN  src dir   frames  rate[1/s]", file=out)
+        for (pgn, source, direction), (count, _, first, last) in sorted(stats.items()):
+            rate = (count - 1) / (last - first) if count > 1 and last > first else 0.0
+            print("%6u %4u %3s %8u %10.1f" % (pgn, source, direction, count, rate), file=out)
+
+
+if __name__ == "__main__":
+    main()